@@ -55,6 +55,32 @@ CYBLE_CYALIGNED_BEGIN uint8 cyBle_stackMemoryRam[CYBLE_STACK_RAM_SIZE] CYBLE_CYA
 
 #endif  /* CYBLE_SHARING_MODE_EXPORT */
 
+#if(CYBLE_MODE_PROFILE)
+
+/* Sizes that make up CYBLE_STACK_RAM_SIZE for this configuration. Read it 
+   together with CyBle_GetStackRamUnused() to right-size the MTU, the L2CAP 
+   channels and the buffer counts in the customizer. test/ble_sizing prints
+   the same terms on the host for other MTU and buffer settings.
+*/
+const CYBLE_STACK_RAM_REPORT_T cyBle_stackRamReport =
+{
+    (uint16) CYBLE_STACK_RAM_SIZE,
+    (uint16) CYBLE_DEFAULT_RAM_SIZE_SOC,
+    (uint16) (CYBLE_GATT_MTU_PLUS_L2CAP_MEM_EXT * CYBLE_GATT_MTU_BUF_COUNT),
+    (uint16) CYBLE_GATT_MTU_BUF_COUNT,
+    (uint16) CYBLE_GATT_MAX_ATTR_LEN_PLUS_L2CAP_MEM_EXT,
+    (uint16) (CYBLE_L2CAP_PSM_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_PSM_COUNT),
+    (uint16) ((CYBLE_L2CAP_CBFC_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT) +
+              (CYBLE_L2CAP_MTU_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT) +
+              (CYBLE_L2CAP_MPS_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT *
+              (CYBLE_L2CAP_MTU / CYBLE_L2CAP_MPS))),
+    (uint16) CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT,
+    (uint16) (CYBLE_STACK_BUFFER_MGR_UTIL_RAM_SZ * CYBLE_STACK_BUF_COUNT),
+    (uint16) CYBLE_STACK_BUF_COUNT
+};
+
+#endif /* CYBLE_MODE_PROFILE */
+
 #if(CYBLE_GAP_ROLE_PERIPHERAL || CYBLE_GAP_ROLE_BROADCASTER)
 
 CYBLE_GAPP_DISC_PARAM_T cyBle_discoveryParam =
@@ -421,6 +447,13 @@ CYBLE_API_RESULT_T CyBle_Start(CYBLE_CALLBACK_T callbackFunc)
         {
             CyBle_ApplCallback = callbackFunc;
             
+            /* Mark the stack RAM to find the bytes the stack never uses. A
+               running stack is left alone, CyBle_StackInit() rejects the call. */
+            if(CyBle_GetState() == CYBLE_STATE_STOPPED)
+            {
+                (void)memset(cyBle_stackMemoryRam, (int)CYBLE_STACK_RAM_FILL, CYBLE_STACK_RAM_SIZE);
+            }
+            
         #if(CYBLE_MODE_PROFILE)
             apiResult = CyBle_StackInit(&CyBle_EventHandler, cyBle_stackMemoryRam, CYBLE_STACK_RAM_SIZE, 
                 cyBle_stackDataBuff, CYBLE_STACK_BUF_COUNT, cyBle_flashStorage.stackFlashptr, CYBLE_STACK_FLASH_SIZE);
@@ -477,6 +510,52 @@ void CyBle_Stop(void)
 }
 
 
+/******************************************************************************
+* Function Name: CyBle_GetStackRamUnused
+***************************************************************************//**
+* 
+*  Counts the bytes of the stack RAM that still hold CYBLE_STACK_RAM_FILL, the
+*  pattern written by CyBle_Start(). These bytes were not used by the stack
+*  since it was started. Call it after the heaviest expected traffic to find
+*  how much of CYBLE_STACK_RAM_SIZE the configuration needs. A used byte that
+*  happens to hold the pattern is counted as unused.
+*
+*  The result is an estimate with two limits:
+*  - Every byte holding the pattern is counted, wherever it is. This is not
+*    a high-water mark: the stack carves the RAM into fixed pools, so unused
+*    bytes spread over several pools cannot all be saved by shrinking one
+*    setting. Use the result as an upper bound and check the pool sizes in
+*    cyBle_stackRamReport.
+*  - It assumes that CyBle_StackInit() does not clear the RAM it is given.
+*    This has not been measured. If it does, the count stays near 0 and
+*    tells nothing about the use of the RAM.
+* 
+* \return
+*  uint32: Number of unused bytes.
+* 
+******************************************************************************/
+uint32 CyBle_GetStackRamUnused(void)
+{
+    uint32 unused = 0u;
+    uint32 i;
+
+    #if(CYBLE_SHARING_MODE_EXPORT)
+    if(cyBle_stackMemoryRam != NULL)
+    #endif /* CYBLE_SHARING_MODE_EXPORT */
+    {
+        for(i = 0u; i < CYBLE_STACK_RAM_SIZE; i++)
+        {
+            if(cyBle_stackMemoryRam[i] == CYBLE_STACK_RAM_FILL)
+            {
+                unused++;
+            }
+        }
+    }
+
+    return (unused);
+}
+
+
 #if((CYBLE_GAP_ROLE_PERIPHERAL || CYBLE_GAP_ROLE_CENTRAL) && (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES))
 
     
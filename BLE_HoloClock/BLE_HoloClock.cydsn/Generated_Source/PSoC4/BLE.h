@@ -73,6 +73,10 @@
 #define CYBLE_SHARING_MODE_EXPORT                   (CYBLE_SHARING_MODE == CYBLE_SHARING_EXPORT)  
 #define CYBLE_SHARING_MODE_IMPORT                   (CYBLE_SHARING_MODE == CYBLE_SHARING_IMPORT)  
 
+/* Pattern written to the stack RAM before the stack is initialized. Bytes
+   that still hold it are counted as unused by CyBle_GetStackRamUnused(). */
+#define CYBLE_STACK_RAM_FILL                        (0xA5u)
+
 #if(CYBLE_MODE_PROFILE)
     
 #define CYBLE_GAP_ROLE                              (0x01u)
@@ -145,16 +149,28 @@
 /* Align buffer size value to 4 */
 #define CYBLE_ALIGN_TO_4(x)                 ((((x) & 3u) == 0u) ? (x) : (((x) - ((x) & 3u)) + 4u))
 
+/* Notifications that can be queued in the stack on top of the minimum
+   number of ATT MTU buffers, so that bulk data notifications are sent
+   back-to-back within a connection event */
+#if !defined(CYBLE_GATT_NTF_BUF_COUNT)
+    #define CYBLE_GATT_NTF_BUF_COUNT        (2u)
+#endif /* !defined(CYBLE_GATT_NTF_BUF_COUNT) */
+
 /* Stack buffers count */
-#define CYBLE_GATT_MTU_BUF_COUNT            (CYBLE_GATT_MIN_NO_OF_ATT_MTU_BUFF)
+#define CYBLE_GATT_MTU_BUF_COUNT            (CYBLE_GATT_MIN_NO_OF_ATT_MTU_BUFF + CYBLE_GATT_NTF_BUF_COUNT)
 #define CYBLE_STACK_BUF_COUNT               (6u)
 
-/* GATT MTU Size */
-#define CYBLE_GATT_MTU                      (0x0017u)
+/* GATT MTU Size, up to CYBLE_GATT_MAX_MTU. The default of 158 bytes plus
+   the L2CAP header fills exactly six 27-byte link layer packets */
+#if !defined(CYBLE_GATT_MTU_CONFIG)
+    #define CYBLE_GATT_MTU                  (0x009Eu)
+#else
+    #define CYBLE_GATT_MTU                  (CYBLE_GATT_MTU_CONFIG)
+#endif /* !defined(CYBLE_GATT_MTU_CONFIG) */
 #define CYBLE_GATT_MTU_PLUS_L2CAP_MEM_EXT   CYBLE_ALIGN_TO_4(CYBLE_GATT_MTU + CYBLE_MEM_EXT_SZ + CYBLE_L2CAP_HDR_SZ)
 
-/* GATT Maximum attribute length */
-#define CYBLE_GATT_MAX_ATTR_LEN             ((0x000Eu == 0u) ? (1u) : (0x000Eu))
+/* GATT Maximum attribute length, the bulk data characteristic */
+#define CYBLE_GATT_MAX_ATTR_LEN             (CYBLE_GATT_MTU - 3u)
 #define CYBLE_GATT_MAX_ATTR_LEN_PLUS_L2CAP_MEM_EXT \
                                     CYBLE_ALIGN_TO_4(CYBLE_GATT_MAX_ATTR_LEN + CYBLE_MEM_EXT_SZ + CYBLE_L2CAP_HDR_SZ)
 
@@ -394,6 +410,25 @@ typedef void (* CYBLE_CALLBACK_T) (uint32 eventCode, void *eventParam);
 
 #define CYBLE_GAPC_CONNECTING_TIMEOUT               (30u)     /* Seconds */
 
+#if(CYBLE_MODE_PROFILE)
+
+/** Breakdown of CYBLE_STACK_RAM_SIZE in bytes, see cyBle_stackRamReport */
+typedef struct
+{
+    uint16 total;                   /**< CYBLE_STACK_RAM_SIZE */
+    uint16 stackData;               /**< Fixed stack data, CYBLE_DEFAULT_RAM_SIZE_SOC */
+    uint16 gattMtuBuffers;          /**< ATT MTU buffers */
+    uint16 gattMtuBufCount;         /**< Number of ATT MTU buffers */
+    uint16 gattMaxAttrBuffer;       /**< Buffer of the longest attribute value */
+    uint16 l2capPsm;                /**< L2CAP PSM data */
+    uint16 l2capChannels;           /**< CBFC, SDU and PDU buffers of the L2CAP channels */
+    uint16 l2capChannelCount;       /**< Number of L2CAP logical channels */
+    uint16 bufferManager;           /**< Buffer manager data of the buffer pools */
+    uint16 bufCount;                /**< Number of buffer pools, CYBLE_STACK_BUF_COUNT */
+} CYBLE_STACK_RAM_REPORT_T;
+
+#endif /* CYBLE_MODE_PROFILE */
+
 
 /***************************************
 * Private Function Prototypes
@@ -418,6 +453,7 @@ void CyBle_Set16ByPtr(uint8 ptr[], uint16 value);
 
 CYBLE_API_RESULT_T CyBle_Start(CYBLE_CALLBACK_T  callbackFunc);
 void CyBle_Stop(void);
+uint32 CyBle_GetStackRamUnused(void);
 
 #if((CYBLE_GAP_ROLE_PERIPHERAL || CYBLE_GAP_ROLE_CENTRAL) && (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES))
     CYBLE_API_RESULT_T CyBle_StoreBondingData(uint8 isForceWrite);
@@ -466,6 +502,9 @@ extern uint8                                        *cyBle_stackMemoryRam;
 #else
 extern uint8                                        cyBle_stackMemoryRam[CYBLE_STACK_RAM_SIZE];
 #endif  /* CYBLE_SHARING_MODE_EXPORT */
+#if(CYBLE_MODE_PROFILE)
+extern const CYBLE_STACK_RAM_REPORT_T               cyBle_stackRamReport;
+#endif /* CYBLE_MODE_PROFILE */
 extern volatile uint8                               cyBle_eventHandlerFlag;
 extern CYBLE_GAP_BD_ADDR_T                          cyBle_deviceAddress;
 extern CYBLE_GAP_BD_ADDR_T                          *cyBle_sflashDeviceAddress;
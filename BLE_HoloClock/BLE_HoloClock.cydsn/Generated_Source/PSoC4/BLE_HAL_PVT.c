@@ -16,6 +16,12 @@
 #include "BLE_HAL_PVT.h"
 
 
+/* The number of flash rows programmed by the last CyBLE_Nvram_Write() or
+*  CyBLE_Nvram_Erase() call.
+*/
+static uint32 cyBle_nvramRowsWritten = 0u;
+
+
 #if(CYBLE_MODE == CYBLE_HCI)
 
 
@@ -88,8 +94,9 @@ void CyBLE_Uart_Transmit (const uint8 *dataBuf, uint8 length)
 *  This API writes the data to the NVRAM store. It will check the appropriate
 *  alignment of a start address and also perform an address range check based
 *  on the length before performing the write operation.
-*  This function performs memory compare and writes only row where there are new
-*  data to write.
+*  This function compares the data with the current flash contents and programs
+*  only the rows where the data differs. CyBLE_Nvram_GetRowsWritten() returns
+*  the number of rows programmed.
 *
 *  \param buffer:   Pointer to the buffer containing the data to be stored.
 *  \param varFlash: Pointer to the array or variable in the flash.
@@ -120,6 +127,7 @@ cystatus CyBLE_Nvram_Write (const uint8 buffer[], const uint8 varFlash[], uint16
     uint32 byteOffset;
     uint32 rowsNotEqual;
 
+    cyBle_nvramRowsWritten = 0u;
     eeOffset = (uint32)varFlash;
 
     /* Make sure, that varFlash[] points to Flash */
@@ -134,6 +142,8 @@ cystatus CyBLE_Nvram_Write (const uint8 buffer[], const uint8 varFlash[], uint16
             /* Copy data to the write buffer either from the source buffer or from the flash */
             for (dstIndex = 0u; dstIndex < CY_FLASH_SIZEOF_ROW; dstIndex++)
             {
+                writeBuffer[dstIndex] = CY_GET_XTND_REG8(CYDEV_FLASH_BASE + byteOffset);
+
                 if ((byteOffset >= eeOffset) && (srcIndex < length))
                 {
                     /* Detect that row programming is required */
@@ -144,10 +154,6 @@ cystatus CyBLE_Nvram_Write (const uint8 buffer[], const uint8 varFlash[], uint16
                     }
                     srcIndex++;
                 }
-                else
-                {
-                    writeBuffer[dstIndex] = CY_GET_XTND_REG8(CYDEV_FLASH_BASE + byteOffset);
-                }
                 byteOffset++;
             }
 
@@ -155,6 +161,10 @@ cystatus CyBLE_Nvram_Write (const uint8 buffer[], const uint8 varFlash[], uint16
             {
                 /* Write flash row */
                 rc = CySysFlashWriteRow(rowId, writeBuffer);
+                if(CYRET_SUCCESS == rc)
+                {
+                    cyBle_nvramRowsWritten++;
+                }
             }
 
             /* Go to the next row */
@@ -197,6 +207,7 @@ cystatus CyBLE_Nvram_Erase (const uint8 *varFlash, uint16 length)
     uint8 flashBuffer[CY_FLASH_SIZEOF_ROW] = {0u};
     uint16 lengthFlash;
     uint16 lengthRemaining;
+    uint32 rowsWritten = 0u;
     cystatus rc = CYRET_UNKNOWN;
 
     tempFlash = varFlash;
@@ -204,27 +215,47 @@ cystatus CyBLE_Nvram_Erase (const uint8 *varFlash, uint16 length)
 
     while(lengthRemaining > 0u)
     {
-        if(lengthRemaining < CY_FLASH_SIZEOF_ROW)
+        /* Stop each chunk at a row boundary so that every row is programmed
+        *  at most once.
+        */
+        lengthFlash = (uint16)(CY_FLASH_SIZEOF_ROW - ((uint32)tempFlash % CY_FLASH_SIZEOF_ROW));
+        if(lengthRemaining < lengthFlash)
         {
             lengthFlash = lengthRemaining;
         }
-        else
-        {
-            lengthFlash = CY_FLASH_SIZEOF_ROW;
-        }
         rc = CyBLE_Nvram_Write(flashBuffer, tempFlash, lengthFlash);
+        rowsWritten += cyBle_nvramRowsWritten;
         if(rc != CYRET_SUCCESS)
         {
             break;
         }
-        tempFlash += CY_FLASH_SIZEOF_ROW;
+        tempFlash += lengthFlash;
         lengthRemaining -= lengthFlash;
     }
+    cyBle_nvramRowsWritten = rowsWritten;
 
     return rc;
 }
 
 
+/*******************************************************************************
+* Function Name: CyBLE_Nvram_GetRowsWritten
+****************************************************************************//**
+*
+*  Returns the number of flash rows programmed by the last CyBLE_Nvram_Write()
+*  or CyBLE_Nvram_Erase() call. The rows that already hold the data are not
+*  programmed and are not counted.
+*
+* \return
+*  The number of programmed flash rows.
+*
+*******************************************************************************/
+uint32 CyBLE_Nvram_GetRowsWritten (void)
+{
+    return (cyBle_nvramRowsWritten);
+}
+
+
 /*******************************************************************************
 * Function Name: CyBLE_Bless_LlRegRead
 ****************************************************************************//**
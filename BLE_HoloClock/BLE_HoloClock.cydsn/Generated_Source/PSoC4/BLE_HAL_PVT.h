@@ -102,6 +102,7 @@ void CYBLE_BlessStart(void);
 
 cystatus CyBLE_Nvram_Write (const uint8 buffer[], const uint8 varFlash[], uint16 length);
 cystatus CyBLE_Nvram_Erase (const uint8 *varFlash, uint16 length);
+uint32 CyBLE_Nvram_GetRowsWritten (void);
 
 
 #endif /* CY_BLE_CYBLE_HAL_PVT_H  */
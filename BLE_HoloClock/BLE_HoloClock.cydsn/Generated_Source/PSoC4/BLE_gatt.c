@@ -60,21 +60,21 @@ CYBLE_STATE_T cyBle_state;
         0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u }, 
         {{
-            0x00u, 0x00u, 
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 
         },
         {
-            0x00u, 0x00u, 
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 
         },
         {
-            0x00u, 0x00u, 
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 
         },
         {
-            0x00u, 0x00u, 
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 
         },
         {
-            0x00u, 0x00u, 
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 
         }}, 
-        0x02u, /* CYBLE_GATT_DB_CCCD_COUNT */ 
+        0x06u, /* CYBLE_GATT_DB_CCCD_COUNT */ 
         0x05u, /* CYBLE_GAP_MAX_BONDED_DEVICE */ 
     };
 #endif /* (CYBLE_MODE_PROFILE) */
@@ -107,8 +107,22 @@ CYBLE_STATE_T cyBle_state;
     0x00u, 
 
 };
+static uint8 cyBle_attValuesBulk[CYBLE_BULK_DATA_LEN];
+static uint8 cyBle_attValuesTelemetry[CYBLE_TELEMETRY_DATA_LEN];
 uint8 cyBle_attValuesCCCD[CYBLE_GATT_DB_CCCD_COUNT];
 
+/* 128-bit UUIDs, least significant byte first */
+static const uint8 cyBle_attUuid128[][16u] = {
+    /* Bulk Data Service 3A1B0001-7F5E-4C2D-9B8A-6E5D4C3B2A19 */
+    { 0x19u, 0x2Au, 0x3Bu, 0x4Cu, 0x5Du, 0x6Eu, 0x8Au, 0x9Bu, 0x2Du, 0x4Cu, 0x5Eu, 0x7Fu, 0x01u, 0x00u, 0x1Bu, 0x3Au },
+    /* Bulk Data 3A1B0002-7F5E-4C2D-9B8A-6E5D4C3B2A19 */
+    { 0x19u, 0x2Au, 0x3Bu, 0x4Cu, 0x5Du, 0x6Eu, 0x8Au, 0x9Bu, 0x2Du, 0x4Cu, 0x5Eu, 0x7Fu, 0x02u, 0x00u, 0x1Bu, 0x3Au },
+    /* Telemetry Service 3A1B0003-7F5E-4C2D-9B8A-6E5D4C3B2A19 */
+    { 0x19u, 0x2Au, 0x3Bu, 0x4Cu, 0x5Du, 0x6Eu, 0x8Au, 0x9Bu, 0x2Du, 0x4Cu, 0x5Eu, 0x7Fu, 0x03u, 0x00u, 0x1Bu, 0x3Au },
+    /* Telemetry 3A1B0004-7F5E-4C2D-9B8A-6E5D4C3B2A19 */
+    { 0x19u, 0x2Au, 0x3Bu, 0x4Cu, 0x5Du, 0x6Eu, 0x8Au, 0x9Bu, 0x2Du, 0x4Cu, 0x5Eu, 0x7Fu, 0x04u, 0x00u, 0x1Bu, 0x3Au },
+};
+
 CYBLE_GATTS_ATT_GEN_VAL_LEN_T cyBle_attValuesLen[CYBLE_GATT_DB_ATT_VAL_COUNT] = {
     { 0x000Eu, (void *)&cyBle_attValues[0] }, /* Device Name */
     { 0x0002u, (void *)&cyBle_attValues[14] }, /* Appearance */
@@ -116,9 +130,17 @@ CYBLE_GATTS_ATT_GEN_VAL_LEN_T cyBle_attValuesLen[CYBLE_GATT_DB_ATT_VAL_COUNT] =
     { 0x0004u, (void *)&cyBle_attValues[24] }, /* Service Changed */
     { 0x0002u, (void *)&cyBle_attValuesCCCD[0] }, /* Client Characteristic Configuration */
     { 0x0001u, (void *)&cyBle_attValues[28] }, /* Alert Level */
+    { 0x0010u, (void *)&cyBle_attUuid128[0][0] }, /* Bulk Data Service UUID */
+    { 0x0010u, (void *)&cyBle_attUuid128[1][0] }, /* Bulk Data UUID */
+    { 0x0000u, (void *)&cyBle_attValuesBulk[0] }, /* Bulk Data */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[2] }, /* Client Characteristic Configuration */
+    { 0x0010u, (void *)&cyBle_attUuid128[2][0] }, /* Telemetry Service UUID */
+    { 0x0010u, (void *)&cyBle_attUuid128[3][0] }, /* Telemetry UUID */
+    { 0x0000u, (void *)&cyBle_attValuesTelemetry[0] }, /* Telemetry */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[4] }, /* Client Characteristic Configuration */
 };
 
-const CYBLE_GATTS_DB_T cyBle_gattDB[0x0Eu] = {
+const CYBLE_GATTS_DB_T cyBle_gattDB[0x16u] = {
     { 0x0001u, 0x2800u /* Primary service                     */, 0x00000001u /*       */, 0x0007u, {{0x1800u, NULL}}                           },
     { 0x0002u, 0x2803u /* Characteristic                      */, 0x00000201u /* rd    */, 0x0003u, {{0x2A00u, NULL}}                           },
     { 0x0003u, 0x2A00u /* Device Name                         */, 0x00000201u /* rd    */, 0x0003u, {{0x000Eu, (void *)&cyBle_attValuesLen[0]}} },
@@ -133,6 +155,14 @@ const CYBLE_GATTS_DB_T cyBle_gattDB[0x0Eu] = {
     { 0x000Cu, 0x2800u /* Primary service                     */, 0x00000001u /*       */, 0x000Eu, {{0x1802u, NULL}}                           },
     { 0x000Du, 0x2803u /* Characteristic                      */, 0x00000401u /* wwr   */, 0x000Eu, {{0x2A06u, NULL}}                           },
     { 0x000Eu, 0x2A06u /* Alert Level                         */, 0x00000402u /* wwr   */, 0x000Eu, {{0x0001u, (void *)&cyBle_attValuesLen[5]}} },
+    { 0x000Fu, 0x2800u /* Primary service                     */, 0x00080001u /*       */, 0x0012u, {{0x0010u, (void *)&cyBle_attValuesLen[6]}} },
+    { 0x0010u, 0x2803u /* Characteristic                      */, 0x00081001u /* ntf   */, 0x0012u, {{0x0010u, (void *)&cyBle_attValuesLen[7]}} },
+    { 0x0011u, 0x0002u /* Bulk Data                           */, 0x00081000u /* ntf   */, 0x0012u, {{CYBLE_BULK_DATA_LEN, (void *)&cyBle_attValuesLen[8]}} },
+    { 0x0012u, 0x2902u /* Client Characteristic Configuration */, 0x00000A04u /* rd,wr */, 0x0012u, {{0x0002u, (void *)&cyBle_attValuesLen[9]}} },
+    { 0x0013u, 0x2800u /* Primary service                     */, 0x00080001u /*       */, 0x0016u, {{0x0010u, (void *)&cyBle_attValuesLen[10]}} },
+    { 0x0014u, 0x2803u /* Characteristic                      */, 0x00081001u /* ntf   */, 0x0016u, {{0x0010u, (void *)&cyBle_attValuesLen[11]}} },
+    { 0x0015u, 0x0004u /* Telemetry                           */, 0x00081000u /* ntf   */, 0x0016u, {{CYBLE_TELEMETRY_DATA_LEN, (void *)&cyBle_attValuesLen[12]}} },
+    { 0x0016u, 0x2902u /* Client Characteristic Configuration */, 0x00000A04u /* rd,wr */, 0x0016u, {{0x0002u, (void *)&cyBle_attValuesLen[13]}} },
 };
 
 
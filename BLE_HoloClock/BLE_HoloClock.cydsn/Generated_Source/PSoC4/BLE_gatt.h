@@ -40,13 +40,13 @@
 
 #if(CYBLE_GATT_ROLE_SERVER)
 
-#define CYBLE_GATT_DB_INDEX_COUNT                    (0x000Eu)
-#define CYBLE_GATT_DB_ATT_VAL_COUNT                  (0x06u)
-#define CYBLE_GATT_DB_MAX_VALUE_LEN                  (0x000Eu)
+#define CYBLE_GATT_DB_INDEX_COUNT                    (0x0016u)
+#define CYBLE_GATT_DB_ATT_VAL_COUNT                  (0x0Eu)
+#define CYBLE_GATT_DB_MAX_VALUE_LEN                  (CYBLE_BULK_DATA_LEN)
 
 #endif /* CYBLE_GATT_ROLE_SERVER */
 
-#define CYBLE_GATT_DB_CCCD_COUNT                     (0x02u)
+#define CYBLE_GATT_DB_CCCD_COUNT                     (0x06u)
 
 #if (CYBLE_GATT_DB_CCCD_COUNT == 0u)
     #define CYBLE_GATT_DB_FLASH_CCCD_COUNT          (1u)
@@ -57,6 +57,24 @@
 #define CYBLE_IAS
 #define CYBLE_IAS_SERVER
 
+/* Bulk data vendor service. The data characteristic notifies a full ATT
+   payload of up to CYBLE_BULK_DATA_LEN bytes per notification. */
+#define CYBLE_BULK_SERVER
+#define CYBLE_BULK_SERVICE_HANDLE                    (0x000Fu)
+#define CYBLE_BULK_DATA_DECL_HANDLE                  (0x0010u)
+#define CYBLE_BULK_DATA_CHAR_HANDLE                  (0x0011u)
+#define CYBLE_BULK_DATA_CCCD_HANDLE                  (0x0012u)
+#define CYBLE_BULK_DATA_LEN                          (CYBLE_GATT_MTU - 3u)
+
+/* Telemetry vendor service. The characteristic notifies batches of packed
+   records of up to CYBLE_TELEMETRY_DATA_LEN bytes. */
+#define CYBLE_TELEMETRY_SERVER
+#define CYBLE_TELEMETRY_SERVICE_HANDLE               (0x0013u)
+#define CYBLE_TELEMETRY_DECL_HANDLE                  (0x0014u)
+#define CYBLE_TELEMETRY_CHAR_HANDLE                  (0x0015u)
+#define CYBLE_TELEMETRY_CCCD_HANDLE                  (0x0016u)
+#define CYBLE_TELEMETRY_DATA_LEN                     ((CYBLE_BULK_DATA_LEN < 64u) ? CYBLE_BULK_DATA_LEN : 64u)
+
 
 /***************************************
 * Common constants for LLS and IAS services
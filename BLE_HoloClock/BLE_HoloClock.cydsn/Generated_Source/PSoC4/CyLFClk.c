@@ -40,6 +40,12 @@
 
     static uint32 CySysWdtLocked(void);
     static uint32 CySysClkIloEnabled(void);
+
+    /* CySysTimebaseStart() / CySysTimebaseGetTicks() */
+    static uint32 cySysTimebaseHigh = 0u;
+    static uint32 cySysTimebaseLastCount2 = 0u;
+    static uint64 cySysTimebaseLast = 0u;
+    static uint32 cySysTimebaseFreqHz = CY_SYS_TIMEBASE_ILO_HZ;
 #endif /* (CY_IP_SRSSV2) */
 
 #if(CY_IP_SRSSV2)
@@ -1538,6 +1544,305 @@ void CySysClkIloStop(void)
     }
 
 
+    /*******************************************************************************
+    * Function Name: CySysTimebaseStart
+    ********************************************************************************
+    *
+    * Summary:
+    *  Starts the low-power timebase. WDT counter 1 and counter 2 are cascaded
+    *  into a 48-bit LFCLK tick counter that keeps running in Deep Sleep, and the
+    *  software extends it to 64 bits. Counter 1 runs free with its match value
+    *  at 0, so counter 2 increments each time counter 1 wraps.
+    *
+    *  The LFCLK frequency used for conversions is initialized to the nominal
+    *  value of the LFCLK source. Call CySysTimebaseCalibrate() to measure it.
+    *
+    * Parameters:
+    *  None.
+    *
+    * Return:
+    *  None.
+    *
+    * Side Effects:
+    *  The WDT configuration can be written only while all counters are disabled,
+    *  so counter 0 is stopped for a few LFCLK cycles if it is running. Its
+    *  configuration and count are preserved. Counters 1 and 2 must not be used
+    *  by the application once the timebase is started. The LFCLK source must be
+    *  enabled.
+    *
+    *******************************************************************************/
+    void CySysTimebaseStart(void)
+    {
+        uint32 enabledMask = 0u;
+        uint32 wdtLocked;
+
+        wdtLocked = CySysWdtLocked();
+        if (0u != wdtLocked)
+        {
+            CySysWdtUnlock();
+        }
+
+        if (0u != CySysWdtGetEnabledStatus(CY_SYS_WDT_COUNTER0))
+        {
+            enabledMask = CY_SYS_WDT_COUNTER0_MASK;
+        }
+        CySysWdtDisable(CY_SYS_WDT_COUNTER0_MASK | CY_SYS_WDT_COUNTER1_MASK | CY_SYS_WDT_COUNTER2_MASK);
+
+        CySysWdtSetMode(CY_SYS_WDT_COUNTER1, CY_SYS_WDT_MODE_NONE);
+        CySysWdtSetMode(CY_SYS_WDT_COUNTER2, CY_SYS_WDT_MODE_NONE);
+        CySysWdtSetClearOnMatch(CY_SYS_WDT_COUNTER1, 0u);
+        CySysWdtSetMatch(CY_SYS_WDT_COUNTER1, 0u);
+        CySysWdtSetCascade(CySysWdtGetCascade() | CY_SYS_WDT_CASCADE_12);
+
+        CySysWdtEnable(enabledMask | CY_SYS_WDT_COUNTER1_MASK | CY_SYS_WDT_COUNTER2_MASK);
+        CySysWdtResetCounters(CY_SYS_WDT_COUNTER1_RESET | CY_SYS_WDT_COUNTER2_RESET);
+
+        cySysTimebaseHigh = 0u;
+        cySysTimebaseLastCount2 = 0u;
+        cySysTimebaseLast = 0u;
+
+        #if (CY_IP_WCO)
+            cySysTimebaseFreqHz = (CY_SYS_CLK_LFCLK_SRC_WCO == CySysClkGetLfclkSource()) ?
+                                  CY_SYS_TIMEBASE_WCO_HZ : CY_SYS_TIMEBASE_ILO_HZ;
+        #else
+            cySysTimebaseFreqHz = CY_SYS_TIMEBASE_ILO_HZ;
+        #endif /* (CY_IP_WCO) */
+
+        if (0u != wdtLocked)
+        {
+            CySysWdtLock();
+        }
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysTimebaseGetTicks
+    ********************************************************************************
+    *
+    * Summary:
+    *  Returns the number of LFCLK ticks since CySysTimebaseStart(). The value
+    *  is monotonic and keeps counting through Sleep and Deep Sleep.
+    *
+    *  Counter 2 is read before and after counter 1. If it changed, counter 1
+    *  wrapped in between and is read again, so the halves are never torn. The
+    *  increment of counter 2 may lag the wrap of counter 1 by an LFCLK cycle;
+    *  the result is never allowed to go below the previous one to hide this.
+    *
+    *  May be called from both the main code and interrupts.
+    *
+    * Parameters:
+    *  None.
+    *
+    * Return:
+    *  The 64-bit tick count.
+    *
+    *******************************************************************************/
+    uint64 CySysTimebaseGetTicks(void)
+    {
+        uint32 count1;
+        uint32 count2;
+        uint32 count2Check;
+        uint64 ticks;
+        uint8 interruptState;
+
+        interruptState = CyEnterCriticalSection();
+
+        count2 = CySysWdtGetCount(CY_SYS_WDT_COUNTER2);
+        count1 = CySysWdtGetCount(CY_SYS_WDT_COUNTER1);
+        count2Check = CySysWdtGetCount(CY_SYS_WDT_COUNTER2);
+        if (count2Check != count2)
+        {
+            count2 = count2Check;
+            count1 = CySysWdtGetCount(CY_SYS_WDT_COUNTER1);
+        }
+
+        /* Counter 2 wraps after 2^48 LFCLK ticks */
+        if (count2 < cySysTimebaseLastCount2)
+        {
+            cySysTimebaseHigh++;
+        }
+        cySysTimebaseLastCount2 = count2;
+
+        ticks = ((uint64)cySysTimebaseHigh << 48u) | ((uint64)count2 << 16u) | (uint64)count1;
+        if (ticks < cySysTimebaseLast)
+        {
+            ticks = cySysTimebaseLast;
+        }
+        cySysTimebaseLast = ticks;
+
+        CyExitCriticalSection(interruptState);
+
+        return (ticks);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysTimebaseCalibrate
+    ********************************************************************************
+    *
+    * Summary:
+    *  Measures the LFCLK frequency against SYSCLK and uses the result for the
+    *  tick conversions. The ILO is accurate only to -50%/+100%, so this should
+    *  be called after start-up and whenever the temperature or supply changed.
+    *
+    *  SysTick counts SYSCLK cycles over CY_SYS_TIMEBASE_CAL_TICKS LFCLK ticks.
+    *
+    * Parameters:
+    *  None.
+    *
+    * Return:
+    *  The measured LFCLK frequency in Hz.
+    *
+    * Side Effects:
+    *  Blocks for CY_SYS_TIMEBASE_CAL_TICKS LFCLK cycles (about 8 ms with the
+    *  ILO). The SysTick configuration is saved and restored, but its counter
+    *  value is lost. Must be called after CySysTimebaseStart().
+    *
+    *******************************************************************************/
+    uint32 CySysTimebaseCalibrate(void)
+    {
+        uint32 systCsr;
+        uint32 systRvr;
+        uint32 startCount;
+        uint32 startCycles;
+        uint32 elapsedCycles;
+        uint8 interruptState;
+
+        interruptState = CyEnterCriticalSection();
+
+        systCsr = CY_SYS_SYST_CSR_REG;
+        systRvr = CY_SYS_SYST_RVR_REG;
+
+        CY_SYS_SYST_CSR_REG = 0u;
+        CY_SYS_SYST_RVR_REG = CY_SYS_SYST_RVR_CNT_MASK;
+        CY_SYS_SYST_CVR_REG = 0u;
+        CY_SYS_SYST_CSR_REG = CY_SYS_SYST_CSR_ENABLE |
+                              (CY_SYS_SYST_CSR_CLK_SRC_SYSCLK << CY_SYS_SYST_CSR_CLK_SOURCE_SHIFT);
+
+        /* Start on an LFCLK edge */
+        startCount = CySysWdtGetCount(CY_SYS_WDT_COUNTER1);
+        while (CySysWdtGetCount(CY_SYS_WDT_COUNTER1) == startCount)
+        {
+            /* Wait for counter to increment */
+        }
+        startCycles = CY_SYS_SYST_CVR_REG & CY_SYS_SYST_CVR_CNT_MASK;
+        startCount = (startCount + 1u) & CY_SYS_WDT_LOWER_16BITS_MASK;
+
+        while (((CySysWdtGetCount(CY_SYS_WDT_COUNTER1) - startCount) & CY_SYS_WDT_LOWER_16BITS_MASK) <
+               CY_SYS_TIMEBASE_CAL_TICKS)
+        {
+            /* Wait for the measurement period */
+        }
+        elapsedCycles = (startCycles - CY_SYS_SYST_CVR_REG) & CY_SYS_SYST_CVR_CNT_MASK;
+
+        CY_SYS_SYST_CSR_REG = 0u;
+        CY_SYS_SYST_RVR_REG = systRvr;
+        CY_SYS_SYST_CVR_REG = 0u;
+        CY_SYS_SYST_CSR_REG = systCsr;
+
+        if (0u != elapsedCycles)
+        {
+            cySysTimebaseFreqHz = (uint32)(((uint64)cydelayFreqHz * CY_SYS_TIMEBASE_CAL_TICKS) / elapsedCycles);
+        }
+
+        CyExitCriticalSection(interruptState);
+
+        return (cySysTimebaseFreqHz);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysTimebaseSetFrequency
+    ********************************************************************************
+    *
+    * Summary:
+    *  Sets the LFCLK frequency used for the tick conversions, for example from
+    *  an ILO measurement made by the ILO Trim Component.
+    *
+    * Parameters:
+    *  freqHz: The LFCLK frequency in Hz. Zero is ignored.
+    *
+    * Return:
+    *  None.
+    *
+    *******************************************************************************/
+    void CySysTimebaseSetFrequency(uint32 freqHz)
+    {
+        if (0u != freqHz)
+        {
+            cySysTimebaseFreqHz = freqHz;
+        }
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysTimebaseGetFrequency
+    ********************************************************************************
+    *
+    * Summary:
+    *  Returns the LFCLK frequency used for the tick conversions.
+    *
+    * Parameters:
+    *  None.
+    *
+    * Return:
+    *  The LFCLK frequency in Hz.
+    *
+    *******************************************************************************/
+    uint32 CySysTimebaseGetFrequency(void)
+    {
+        return (cySysTimebaseFreqHz);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysTimebaseTicksToUs
+    ********************************************************************************
+    *
+    * Summary:
+    *  Converts LFCLK ticks to microseconds using the calibrated frequency.
+    *
+    * Parameters:
+    *  ticks: The number of LFCLK ticks.
+    *
+    * Return:
+    *  The number of microseconds.
+    *
+    *******************************************************************************/
+    uint64 CySysTimebaseTicksToUs(uint64 ticks)
+    {
+        uint64 seconds = ticks / cySysTimebaseFreqHz;
+        uint64 remainder = ticks % cySysTimebaseFreqHz;
+
+        return ((seconds * CY_SYS_TIMEBASE_US_PER_S) + ((remainder * CY_SYS_TIMEBASE_US_PER_S) / cySysTimebaseFreqHz));
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysTimebaseUsToTicks
+    ********************************************************************************
+    *
+    * Summary:
+    *  Converts microseconds to LFCLK ticks using the calibrated frequency. The
+    *  result is rounded up so that a delay is never shorter than requested.
+    *
+    * Parameters:
+    *  us: The number of microseconds.
+    *
+    * Return:
+    *  The number of LFCLK ticks.
+    *
+    *******************************************************************************/
+    uint64 CySysTimebaseUsToTicks(uint64 us)
+    {
+        uint64 seconds = us / CY_SYS_TIMEBASE_US_PER_S;
+        uint64 remainder = us % CY_SYS_TIMEBASE_US_PER_S;
+
+        return ((seconds * cySysTimebaseFreqHz) +
+                (((remainder * cySysTimebaseFreqHz) + (CY_SYS_TIMEBASE_US_PER_S - 1u)) / CY_SYS_TIMEBASE_US_PER_S));
+    }
+
+
     /*******************************************************************************
     * Function Name: CySysClkLfclkPosedgeCatch
     ********************************************************************************
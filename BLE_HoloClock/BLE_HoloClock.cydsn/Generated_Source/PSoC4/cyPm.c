@@ -18,6 +18,15 @@
 
 #include "cyPm.h"
 #include "CyLib.h"
+#include "CyLFClk.h"
+
+#if(CY_IP_SRSSV2)
+    static CY_NOINIT CY_PM_STATS_STRUCT cySysPmStats;
+    static uint8 cySysPmStatsEnabled = 0u;
+
+    static void CySysPmStatsEnter(void);
+    static void CySysPmStatsExit(uint32 mode);
+#endif /* (CY_IP_SRSSV2) */
 
 
 /*******************************************************************************
@@ -46,9 +55,17 @@ void CySysPmSleep(void)
     /* CM0 enters Sleep mode upon execution of WFI */
     CY_PM_CM0_SCR_REG &= (uint32) (~CY_PM_CM0_SCR_SLEEPDEEP);
 
+    #if(CY_IP_SRSSV2)
+        CySysPmStatsEnter();
+    #endif /* (CY_IP_SRSSV2) */
+
     /* Sleep and wait for interrupt */
     CY_PM_WFI;
 
+    #if(CY_IP_SRSSV2)
+        CySysPmStatsExit(CY_PM_STATS_SLEEP);
+    #endif /* (CY_IP_SRSSV2) */
+
     CyExitCriticalSection(interruptState);
 }
 
@@ -105,6 +122,8 @@ void CySysPmDeepSleep(void)
         */
         clkSelectReg = CY_SYS_CLK_SELECT_REG;
         CySysClkWriteSysclkDiv(CY_SYS_CLK_SYSCLK_DIV4);
+
+        CySysPmStatsEnter();
     #endif /* (CY_IP_SRSSV2) */
 
     /* Sleep and wait for interrupt */
@@ -113,6 +132,8 @@ void CySysPmDeepSleep(void)
     #if(CY_IP_SRSSV2)
         /* Restore system clock configuration */
         CY_SYS_CLK_SELECT_REG = clkSelectReg;
+
+        CySysPmStatsExit(CY_PM_STATS_DEEPSLEEP);
     #endif /* (CY_IP_SRSSV2) */
 
     #if (CY_IP_CPUSS && CY_IP_SRSSV2)
@@ -288,6 +309,237 @@ void CySysPmDeepSleep(void)
     }
 
 
+    /*******************************************************************************
+    * Function Name: CySysPmStatsBin
+    ********************************************************************************
+    *
+    * Summary:
+    *  Returns the histogram bin of a period.
+    *
+    * Parameters:
+    *  ticks: The length of the period in LFCLK ticks.
+    *
+    * Return:
+    *  The bin index, 0 to CY_PM_STATS_BINS - 1.
+    *
+    *******************************************************************************/
+    static uint32 CySysPmStatsBin(uint64 ticks)
+    {
+        uint32 bin = 0u;
+
+        while ((0u != ticks) && (bin < (CY_PM_STATS_BINS - 1u)))
+        {
+            ticks >>= 1u;
+            bin++;
+        }
+
+        return (bin);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsRecord
+    ********************************************************************************
+    *
+    * Summary:
+    *  Closes the period spent in a power mode and starts the next one.
+    *
+    * Parameters:
+    *  mode: The mode of the period that ends, CY_PM_STATS_ACTIVE,
+    *        CY_PM_STATS_SLEEP or CY_PM_STATS_DEEPSLEEP.
+    *  now:  The current timebase value.
+    *
+    * Return:
+    *  None
+    *
+    *******************************************************************************/
+    static void CySysPmStatsRecord(uint32 mode, uint64 now)
+    {
+        uint64 elapsed = now - cySysPmStats.lastTransition;
+
+        cySysPmStats.residency[mode] += elapsed;
+        cySysPmStats.count[mode]++;
+        cySysPmStats.histogram[mode][CySysPmStatsBin(elapsed)]++;
+        cySysPmStats.lastTransition = now;
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsEnter
+    ********************************************************************************
+    *
+    * Summary:
+    *  Ends the Active period before Sleep or Deep Sleep is entered.
+    *
+    * Parameters:
+    *  None
+    *
+    * Return:
+    *  None
+    *
+    *******************************************************************************/
+    static void CySysPmStatsEnter(void)
+    {
+        if (0u != cySysPmStatsEnabled)
+        {
+            CySysPmStatsRecord(CY_PM_STATS_ACTIVE, CySysTimebaseGetTicks());
+        }
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsExit
+    ********************************************************************************
+    *
+    * Summary:
+    *  Ends the Sleep or Deep Sleep period on the wakeup and starts timing the
+    *  wakeup latency.
+    *
+    * Parameters:
+    *  mode: CY_PM_STATS_SLEEP or CY_PM_STATS_DEEPSLEEP.
+    *
+    * Return:
+    *  None
+    *
+    *******************************************************************************/
+    static void CySysPmStatsExit(uint32 mode)
+    {
+        if (0u != cySysPmStatsEnabled)
+        {
+            CySysPmStatsRecord(mode, CySysTimebaseGetTicks());
+            cySysPmStats.lastWake = cySysPmStats.lastTransition;
+            cySysPmStats.workPending = 1u;
+        }
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsStart
+    ********************************************************************************
+    *
+    * Summary:
+    *  Starts collecting the time spent in Active, Sleep and Deep Sleep and the
+    *  wakeup latency. The statistics kept from before a software or watchdog
+    *  reset are continued; they are cleared if they are not valid, e.g. after
+    *  power-up. The timebase must have been started with CySysTimebaseStart().
+    *
+    * Parameters:
+    *  None
+    *
+    * Return:
+    *  None
+    *
+    *******************************************************************************/
+    void CySysPmStatsStart(void)
+    {
+        uint8 interruptState;
+
+        interruptState = CyEnterCriticalSection();
+
+        if ((CY_PM_STATS_MAGIC != cySysPmStats.magic) || (sizeof(cySysPmStats) != cySysPmStats.size))
+        {
+            CySysPmStatsClear();
+        }
+
+        /* The timebase restarts from zero on reset */
+        cySysPmStats.lastTransition = CySysTimebaseGetTicks();
+        cySysPmStats.workPending = 0u;
+        cySysPmStatsEnabled = 1u;
+
+        CyExitCriticalSection(interruptState);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsClear
+    ********************************************************************************
+    *
+    * Summary:
+    *  Clears the statistics.
+    *
+    * Parameters:
+    *  None
+    *
+    * Return:
+    *  None
+    *
+    *******************************************************************************/
+    void CySysPmStatsClear(void)
+    {
+        uint8 interruptState;
+
+        interruptState = CyEnterCriticalSection();
+
+        (void) memset((void *) &cySysPmStats, 0, sizeof(cySysPmStats));
+        cySysPmStats.magic = CY_PM_STATS_MAGIC;
+        cySysPmStats.size = sizeof(cySysPmStats);
+        cySysPmStats.lastTransition = CySysTimebaseGetTicks();
+
+        CyExitCriticalSection(interruptState);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsWork
+    ********************************************************************************
+    *
+    * Summary:
+    *  Marks the start of the useful work after a wakeup. The time since the last
+    *  wakeup is added to the wakeup latency histogram. Only the first call after
+    *  each wakeup is counted.
+    *
+    * Parameters:
+    *  None
+    *
+    * Return:
+    *  None
+    *
+    *******************************************************************************/
+    void CySysPmStatsWork(void)
+    {
+        uint64 latency;
+        uint8 interruptState;
+
+        interruptState = CyEnterCriticalSection();
+
+        if ((0u != cySysPmStatsEnabled) && (0u != cySysPmStats.workPending))
+        {
+            latency = CySysTimebaseGetTicks() - cySysPmStats.lastWake;
+
+            cySysPmStats.wakeLatency[CySysPmStatsBin(latency)]++;
+            if (latency > cySysPmStats.wakeLatencyMax)
+            {
+                cySysPmStats.wakeLatencyMax = (uint32) latency;
+            }
+            cySysPmStats.workPending = 0u;
+        }
+
+        CyExitCriticalSection(interruptState);
+    }
+
+
+    /*******************************************************************************
+    * Function Name: CySysPmStatsGet
+    ********************************************************************************
+    *
+    * Summary:
+    *  Returns the statistics block, e.g. to send it over I2C or BLE. The Active
+    *  time of the current period is not included until the next Sleep or Deep
+    *  Sleep.
+    *
+    * Parameters:
+    *  None
+    *
+    * Return:
+    *  A pointer to the statistics block.
+    *
+    *******************************************************************************/
+    const CY_PM_STATS_STRUCT * CySysPmStatsGet(void)
+    {
+        return (&cySysPmStats);
+    }
+
+
     /*******************************************************************************
     * Function Name: CySysPmGetResetReason
     ********************************************************************************
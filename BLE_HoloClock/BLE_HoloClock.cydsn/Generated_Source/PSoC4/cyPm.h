@@ -23,6 +23,47 @@
 #include "cypins.h"
 
 
+#if(CY_IP_SRSSV2)
+
+    /***************************************
+    *       Data Struct Definitions
+    ***************************************/
+
+    /* CySysPmStatsGet() */
+    #define CY_PM_STATS_ACTIVE                  (0u)
+    #define CY_PM_STATS_SLEEP                   (1u)
+    #define CY_PM_STATS_DEEPSLEEP               (2u)
+    #define CY_PM_STATS_MODES                   (3u)
+
+    /* Histogram bin 0 counts the periods of 0 LFCLK ticks, bin n the periods of
+    * 2^(n-1) to 2^n - 1 ticks. The last bin also counts all longer periods.
+    */
+    #define CY_PM_STATS_BINS                    (16u)
+
+    /* Marks the statistics block as valid; the block is not cleared on reset */
+    #define CY_PM_STATS_MAGIC                   (0x50535431u)
+
+    /* The statistics block. It is kept in the .noinit section, so it survives
+    * software and watchdog resets, and can be sent out as a byte block. All
+    * times are in LFCLK ticks of the WDT timebase.
+    */
+    typedef struct
+    {
+        uint32 magic;                                           /* CY_PM_STATS_MAGIC */
+        uint32 size;                                            /* Size of this structure */
+        uint64 residency[CY_PM_STATS_MODES];                    /* Total time in each mode */
+        uint32 count[CY_PM_STATS_MODES];                        /* Periods spent in each mode */
+        uint32 histogram[CY_PM_STATS_MODES][CY_PM_STATS_BINS];  /* Length of each period */
+        uint32 wakeLatency[CY_PM_STATS_BINS];                   /* Wake-up to CySysPmStatsWork() */
+        uint32 wakeLatencyMax;
+        uint64 lastTransition;
+        uint64 lastWake;
+        uint32 workPending;
+    } CY_PM_STATS_STRUCT;
+
+#endif /* (CY_IP_SRSSV2) */
+
+
 /***************************************
 *        Function Prototypes
 ***************************************/
@@ -36,6 +77,12 @@ void CySysPmDeepSleep(void);
     uint32 CySysPmGetResetReason(void);
     void CySysPmStop(void);
     void CySysPmSetWakeupPolarity(uint32 polarity);
+
+    /* Residency and wake latency statistics */
+    void CySysPmStatsStart(void);
+    void CySysPmStatsClear(void);
+    void CySysPmStatsWork(void);
+    const CY_PM_STATS_STRUCT * CySysPmStatsGet(void);
 #else
     void CySysPmSetWakeupHoldoff(uint32 hfclkFrequencyMhz);
 #endif /* (CY_IP_SRSSV2) */
@@ -0,0 +1,157 @@
+/*******************************************************************************
+* File Name: bledispatch.c
+*
+* Description:
+*  This file dispatches the events that the BLE Component passes to the
+*  application callback of CyBle_Start() to the handlers that the
+*  application services register for them. It covers application dispatch
+*  only: the generated CyBle_EventHandler() keeps its own switch over the
+*  profile events. A stack event is looked up in a table indexed by its
+*  code, so an event costs one lookup and a call per handler, and the
+*  events nobody registered for cost only the lookup. The handlers of an
+*  event are called in the registration order.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "bledispatch.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Handler list of each indexed event with handlers. BleDispatchSlot maps
+ * the event code to its list, 0 for an event without handlers and n for
+ * BleDispatchList[n - 1]. */
+static uint8 BleDispatchSlot[BLEDISPATCH_INDEXED_EVENTS];
+static BLEDISPATCH_NODE *BleDispatchList[BLEDISPATCH_MAX_EVENTS];
+static uint8 BleDispatchLists = 0u;
+
+/* Handlers of all other events */
+static BLEDISPATCH_NODE *BleDispatchOther = NULL;
+
+
+/*******************************************************************************
+* Function Name: BleDispatch_Append
+********************************************************************************
+*
+* Summary:
+*  Adds a handler at the end of a list.
+*
+* Parameters:
+*  BLEDISPATCH_NODE **list: The list.
+*  BLEDISPATCH_NODE *node: The handler.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void BleDispatch_Append(BLEDISPATCH_NODE **list, BLEDISPATCH_NODE *node)
+{
+    while(*list != NULL)
+    {
+        list = &(*list)->next;
+    }
+    node->next = NULL;
+    *list = node;
+}
+
+/*******************************************************************************
+* Function Name: BleDispatch_Register
+********************************************************************************
+*
+* Summary:
+*  Registers a handler for an event. Handlers are registered before
+*  CyBle_Start() and are never removed.
+*
+* Parameters:
+*  BLEDISPATCH_NODE *node: Caller-owned handler structure.
+*  uint32 event: Event code.
+*  BLEDISPATCH_HANDLER handler: Function called for the event.
+*
+* Return:
+*  uint8: BLEDISPATCH_OK, or BLEDISPATCH_FULL if BLEDISPATCH_MAX_EVENTS
+*         indexed events already have handlers.
+*
+*******************************************************************************/
+uint8 BleDispatch_Register(BLEDISPATCH_NODE *node, uint32 event, BLEDISPATCH_HANDLER handler)
+{
+    uint8 result = BLEDISPATCH_OK;
+
+    node->handler = handler;
+    node->event = event;
+
+    if(event >= BLEDISPATCH_INDEXED_EVENTS)
+    {
+        BleDispatch_Append(&BleDispatchOther, node);
+    }
+    else if(BleDispatchSlot[event] != 0u)
+    {
+        BleDispatch_Append(&BleDispatchList[BleDispatchSlot[event] - 1u], node);
+    }
+    else if(BleDispatchLists < BLEDISPATCH_MAX_EVENTS)
+    {
+        BleDispatchList[BleDispatchLists] = NULL;
+        BleDispatch_Append(&BleDispatchList[BleDispatchLists], node);
+        BleDispatchLists++;
+        BleDispatchSlot[event] = BleDispatchLists;
+    }
+    else
+    {
+        result = BLEDISPATCH_FULL;
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: BleDispatch_Event
+********************************************************************************
+*
+* Summary:
+*  The event callback passed to CyBle_Start(). Calls the handlers of the
+*  event.
+*
+* Parameters:
+*  uint32 event:      Event from the CYBLE component.
+*  void* eventParams: A structure instance for corresponding event type.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void BleDispatch_Event(uint32 event, void *eventParam)
+{
+    BLEDISPATCH_NODE *node = NULL;
+    uint8 slot;
+
+    if(event < BLEDISPATCH_INDEXED_EVENTS)
+    {
+        slot = BleDispatchSlot[event];
+        if(slot != 0u)
+        {
+            node = BleDispatchList[slot - 1u];
+        }
+
+        while(node != NULL)
+        {
+            node->handler(event, eventParam);
+            node = node->next;
+        }
+    }
+    else
+    {
+        for(node = BleDispatchOther; node != NULL; node = node->next)
+        {
+            if(node->event == event)
+            {
+                node->handler(event, eventParam);
+            }
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,60 @@
+/*******************************************************************************
+* File Name: bledispatch.h
+*
+* Description:
+*  Contains the application BLE event dispatch API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(BLEDISPATCH_H)
+#define BLEDISPATCH_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* The stack events below this code (generic, GAP, GATT and L2CAP events)
+ * are looked up by their code. The later stack events and the events of
+ * the BLE Component share one list. */
+#define BLEDISPATCH_INDEXED_EVENTS  0x80u
+
+/* Number of indexed events that can have handlers. The services assert
+ * that their handlers fit, so a design that outgrows it halts at start-up
+ * in a debug build. */
+#define BLEDISPATCH_MAX_EVENTS      16u
+
+/* Return codes */
+#define BLEDISPATCH_OK              0x00u
+#define BLEDISPATCH_FULL            0x01u
+
+/***************************************
+*        Data Structure Definition
+***************************************/
+struct BLEDISPATCH_NODE_s;
+
+/* Called from CyBle_ProcessEvents() for the registered event. */
+typedef void (*BLEDISPATCH_HANDLER)(uint32 event, void *eventParam);
+
+/* A registered handler. The structure is owned by the caller and linked
+ * into the list of its event, so it must stay allocated. */
+typedef struct BLEDISPATCH_NODE_s
+{
+    struct BLEDISPATCH_NODE_s *next;
+    BLEDISPATCH_HANDLER handler;
+    uint32 event;
+} BLEDISPATCH_NODE;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+uint8 BleDispatch_Register(BLEDISPATCH_NODE *node, uint32 event, BLEDISPATCH_HANDLER handler);
+void BleDispatch_Event(uint32 event, void *eventParam);
+
+#endif /* BLEDISPATCH_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,299 @@
+/*******************************************************************************
+* File Name: bulk.c
+*
+* Description:
+*  This file sends blocks of data such as logs, telemetry and configuration
+*  blobs through the Bulk Data characteristic. The block is cut in chunks
+*  that fill the negotiated ATT MTU, and as many notifications are queued
+*  in the stack as it has buffers for, so that they go out back-to-back in
+*  the next connection event. A short connection interval is requested for
+*  the time of the transfer.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "bulk.h"
+#include "connparam.h"
+#include "swtimer.h"
+#include "bledispatch.h"
+#include "cccd.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Block being sent. It is owned by the caller until the transfer ends. */
+static const uint8 *BulkData;
+static uint32 BulkLength = 0u;
+static uint32 BulkOffset = 0u;
+
+static BULK_STATS BulkStats;
+
+static BLEDISPATCH_NODE bulkWriteReqNode;
+static BLEDISPATCH_NODE bulkDisconnectedNode;
+
+
+/*******************************************************************************
+* Function Name: Bulk_End
+********************************************************************************
+*
+* Summary:
+*  Ends the transfer and releases the short connection interval.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Bulk_End(void)
+{
+    BulkLength = 0u;
+    BulkOffset = 0u;
+    ConnParam_Demand(CONNPARAM_DEMAND_TRANSFER, 0u);
+}
+
+/*******************************************************************************
+* Function Name: Bulk_WriteReq
+********************************************************************************
+*
+* Summary:
+*  Handles the writes to the Client Characteristic Configuration descriptor
+*  of the Bulk Data characteristic.
+*
+* Parameters:
+*  uint32 event:      CYBLE_EVT_GATTS_WRITE_REQ.
+*  void* eventParams: A structure instance of CYBLE_GATTS_WRITE_REQ_PARAM_T
+*                     type.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Bulk_WriteReq(uint32 event, void *eventParam)
+{
+    (void)event;
+
+    Cccd_WriteReq((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam, CYBLE_BULK_DATA_CCCD_HANDLE);
+}
+
+/*******************************************************************************
+* Function Name: Bulk_Disconnected
+********************************************************************************
+*
+* Summary:
+*  Clears the client configuration and ends the transfer.
+*
+* Parameters:
+*  uint32 event:      CYBLE_EVT_GAP_DEVICE_DISCONNECTED.
+*  void* eventParams: Not used.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Bulk_Disconnected(uint32 event, void *eventParam)
+{
+    (void)event;
+    (void)eventParam;
+
+    Cccd_Clear(CYBLE_BULK_DATA_CCCD_HANDLE);
+    Bulk_End();
+}
+
+/*******************************************************************************
+* Function Name: Bulk_Init
+********************************************************************************
+*
+* Summary:
+*  Registers the BLE event handlers of the Bulk Data service. Called
+*  before CyBle_Start().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Bulk_Init(void)
+{
+    uint8 result;
+
+    result = BleDispatch_Register(&bulkWriteReqNode, CYBLE_EVT_GATTS_WRITE_REQ, Bulk_WriteReq);
+    result |= BleDispatch_Register(&bulkDisconnectedNode, CYBLE_EVT_GAP_DEVICE_DISCONNECTED, Bulk_Disconnected);
+    if(result != BLEDISPATCH_OK)
+    {
+        /* BLEDISPATCH_MAX_EVENTS is too small for the handlers of the design */
+        CYASSERT(0u != 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bulk_Send
+********************************************************************************
+*
+* Summary:
+*  Starts the transfer of a block. The block is sent from Bulk_Process()
+*  and must not change until Bulk_IsActive() returns 0.
+*
+* Parameters:
+*  const uint8 data[]: Block to send.
+*  uint32 length: Block length.
+*
+* Return:
+*  uint8: BULK_OK, BULK_BUSY while a transfer is running, or
+*         BULK_NOT_ENABLED if the client has not enabled the notifications.
+*
+*******************************************************************************/
+uint8 Bulk_Send(const uint8 data[], uint32 length)
+{
+    uint8 result = BULK_OK;
+
+    if(BulkLength != 0u)
+    {
+        result = BULK_BUSY;
+    }
+    else if((CyBle_GetState() != CYBLE_STATE_CONNECTED) ||
+            (!CYBLE_IS_NOTIFICATION_ENABLED(CYBLE_BULK_DATA_CCCD_HANDLE)))
+    {
+        result = BULK_NOT_ENABLED;
+    }
+    else if(length != 0u)
+    {
+        BulkData = data;
+        BulkLength = length;
+        BulkOffset = 0u;
+
+        BulkStats.bytes = 0u;
+        BulkStats.notifications = 0u;
+        BulkStats.stalls = 0u;
+        BulkStats.startTicks = SwTimer_GetTime();
+        BulkStats.durationTicks = 0u;
+
+        ConnParam_Demand(CONNPARAM_DEMAND_TRANSFER, 1u);
+    }
+    else
+    {
+        /* Nothing to send */
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: Bulk_IsActive
+********************************************************************************
+*
+* Summary:
+*  Tells whether a transfer is running.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 while a block is being sent, otherwise 0.
+*
+*******************************************************************************/
+uint8 Bulk_IsActive(void)
+{
+    return((BulkLength != 0u) ? 1u : 0u);
+}
+
+/*******************************************************************************
+* Function Name: Bulk_Process
+********************************************************************************
+*
+* Summary:
+*  Queues full-MTU notifications in the stack until the block is sent or
+*  the stack has no free buffer. Called from the main loop after
+*  CyBle_ProcessEvents().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Bulk_Process(void)
+{
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T ntf;
+    uint16 mtu = CYBLE_GATT_DEFAULT_MTU;
+    uint32 chunk;
+    uint8 queued = 1u;
+
+    if(BulkLength != 0u)
+    {
+        if(!CYBLE_IS_NOTIFICATION_ENABLED(CYBLE_BULK_DATA_CCCD_HANDLE))
+        {
+            /* The client has stopped the notifications */
+            Bulk_End();
+        }
+        else
+        {
+            (void)CyBle_GattGetMtuSize(&mtu);
+            BulkStats.chunkSize = mtu - BULK_NTF_HEADER_SIZE;
+
+            while((BulkOffset < BulkLength) && (queued != 0u))
+            {
+                chunk = BulkLength - BulkOffset;
+                if(chunk > BulkStats.chunkSize)
+                {
+                    chunk = BulkStats.chunkSize;
+                }
+
+                ntf.attrHandle = CYBLE_BULK_DATA_CHAR_HANDLE;
+                ntf.value.val = (uint8 *)&BulkData[BulkOffset];
+                ntf.value.len = (uint16)chunk;
+
+                if((CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE) &&
+                   (CyBle_GattsNotification(cyBle_connHandle, &ntf) == CYBLE_ERROR_OK))
+                {
+                    BulkOffset += chunk;
+                    BulkStats.bytes += chunk;
+                    BulkStats.notifications++;
+                }
+                else
+                {
+                    /* Resumed when the stack reports free buffers */
+                    BulkStats.stalls++;
+                    queued = 0u;
+                }
+            }
+
+            if(BulkOffset >= BulkLength)
+            {
+                BulkStats.durationTicks = SwTimer_GetTime() - BulkStats.startTicks;
+                Bulk_End();
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bulk_GetStats
+********************************************************************************
+*
+* Summary:
+*  Returns the counters of the current or the last transfer. The
+*  throughput is about bytes / durationTicks kB/s, as a wheel tick lasts
+*  about 1 ms.
+*
+* Parameters:
+*  BULK_STATS *stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Bulk_GetStats(BULK_STATS *stats)
+{
+    *stats = BulkStats;
+}
+
+/* [] END OF FILE */
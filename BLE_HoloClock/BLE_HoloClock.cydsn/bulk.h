@@ -0,0 +1,54 @@
+/*******************************************************************************
+* File Name: bulk.h
+*
+* Description:
+*  Contains the bulk data transfer API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(BULK_H)
+#define BULK_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Size of the ATT Handle Value Notification header. */
+#define BULK_NTF_HEADER_SIZE        3u
+
+/* Return codes */
+#define BULK_OK                     0x00u
+#define BULK_BUSY                   0x01u
+#define BULK_NOT_ENABLED            0x02u
+
+/***************************************
+*        Data Structure Definition
+***************************************/
+/* Counters of the last transfer. */
+typedef struct
+{
+    uint32 bytes;           /* Bytes notified                            */
+    uint32 notifications;   /* Notifications queued in the stack         */
+    uint32 stalls;          /* Stack found busy with a chunk left to send */
+    uint32 startTicks;      /* Wheel time of the first chunk, ~1 ms ticks */
+    uint32 durationTicks;   /* Wheel ticks until the last chunk was queued */
+    uint16 chunkSize;       /* Payload of a full notification            */
+} BULK_STATS;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void Bulk_Init(void);
+uint8 Bulk_Send(const uint8 data[], uint32 length);
+uint8 Bulk_IsActive(void);
+void Bulk_Process(void);
+void Bulk_GetStats(BULK_STATS *stats);
+
+#endif /* BULK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,90 @@
+/*******************************************************************************
+* File Name: cccd.c
+*
+* Description:
+*  This file handles the Client Characteristic Configuration descriptors of
+*  the application services, which the component leaves to the
+*  application: the client writes are stored in the GATT database and
+*  answered, and the configuration is cleared on disconnection.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "cccd.h"
+
+
+/*******************************************************************************
+* Function Name: Cccd_WriteReq
+********************************************************************************
+*
+* Summary:
+*  Stores a client write of a descriptor and sends the response. Writes to
+*  other attributes are ignored, so every service handling
+*  CYBLE_EVT_GATTS_WRITE_REQ can pass the event on.
+*
+* Parameters:
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T *writeParam: Parameter of
+*                                             CYBLE_EVT_GATTS_WRITE_REQ.
+*  CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle: Handle of the descriptor.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cccd_WriteReq(CYBLE_GATTS_WRITE_REQ_PARAM_T *writeParam, CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle)
+{
+    CYBLE_GATTS_ERR_PARAM_T errParam;
+    CYBLE_GATT_ERR_CODE_T gattErr;
+
+    if(writeParam->handleValPair.attrHandle == cccdHandle)
+    {
+        gattErr = CyBle_GattsWriteAttributeValue(&writeParam->handleValPair, 0u,
+                    &writeParam->connHandle, CYBLE_GATT_DB_PEER_INITIATED);
+
+        if(gattErr == CYBLE_GATT_ERR_NONE)
+        {
+            (void)CyBle_GattsWriteRsp(writeParam->connHandle);
+        }
+        else
+        {
+            errParam.opcode = (uint8)CYBLE_GATT_WRITE_REQ;
+            errParam.attrHandle = writeParam->handleValPair.attrHandle;
+            errParam.errorCode = gattErr;
+            (void)CyBle_GattsErrorRsp(writeParam->connHandle, &errParam);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cccd_Clear
+********************************************************************************
+*
+* Summary:
+*  Clears the client configuration of a descriptor, which does not outlive
+*  the connection.
+*
+* Parameters:
+*  CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle: Handle of the descriptor.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cccd_Clear(CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T cccd;
+    uint8 cccdValue[CYBLE_CCCD_LEN];
+
+    cccdValue[0u] = 0u;
+    cccdValue[1u] = 0u;
+    cccd.attrHandle = cccdHandle;
+    cccd.value.val = cccdValue;
+    cccd.value.len = CYBLE_CCCD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&cccd, 0u, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,27 @@
+/*******************************************************************************
+* File Name: cccd.h
+*
+* Description:
+*  Contains the Client Characteristic Configuration descriptor API of the
+*  application services.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CCCD_H)
+#define CCCD_H
+
+#include <project.h>
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void Cccd_WriteReq(CYBLE_GATTS_WRITE_REQ_PARAM_T *writeParam, CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle);
+void Cccd_Clear(CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle);
+
+#endif /* CCCD_H */
+
+/* [] END OF FILE */
@@ -20,10 +20,5 @@
 #define LED_OFF            (1u)
 
 
-/***************************************
-*        Function Prototypes
-***************************************/
-void StackEventHandler(uint32 event, void* eventParam);
-
 
 /* [] END OF FILE */
@@ -0,0 +1,373 @@
+/*******************************************************************************
+* File Name: connparam.c
+*
+* Description:
+*  This file negotiates the connection parameters with the central. While
+*  no alert or data transfer is pending, a long interval with slave latency
+*  is requested to lower the link power. When one is pending, a short
+*  interval is requested for responsiveness. Requests are sent from the
+*  main loop through the L2CAP connection parameter update procedure, one
+*  at a time, and a profile rejected by the central is not requested again
+*  until the demand changes. A request that is not completed within
+*  CONNPARAM_UPDATE_TIMEOUT_MS is treated as rejected.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "connparam.h"
+#include "swtimer.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+static CONNPARAM_STATS ConnParamStats;
+
+/* Reasons for the active profile, a request is outstanding, the profile
+ * of that request and the profile last rejected by the central. */
+static uint8 ConnParamDemand = 0u;
+static uint8 ConnParamConnected = 0u;
+static uint8 ConnParamPending = 0u;
+static uint8 ConnParamRequested = CONNPARAM_PROFILE_NONE;
+static uint8 ConnParamRejected = CONNPARAM_PROFILE_NONE;
+
+/* Delays the idle profile after the connection. The callback only flags
+ * the expiry. */
+static SWTIMER ConnParamSettleTimer;
+static volatile uint8 ConnParamSettled = 0u;
+
+/* Ends an outstanding request. The callback only flags the expiry. */
+static SWTIMER ConnParamUpdateTimer;
+static volatile uint8 ConnParamTimedOut = 0u;
+
+
+/*******************************************************************************
+* Function Name: ConnParam_SettleCallback
+********************************************************************************
+*
+* Summary:
+*  Called from the WDT interrupt when the settle time after the connection
+*  has elapsed.
+*
+* Parameters:
+*  SWTIMER *timer: The settle timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnParam_SettleCallback(SWTIMER *timer)
+{
+    (void)timer;
+
+    ConnParamSettled = 1u;
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_UpdateTimeoutCallback
+********************************************************************************
+*
+* Summary:
+*  Called from the WDT interrupt when the outstanding request was neither
+*  rejected nor completed in time.
+*
+* Parameters:
+*  SWTIMER *timer: The update timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnParam_UpdateTimeoutCallback(SWTIMER *timer)
+{
+    (void)timer;
+
+    ConnParamTimedOut = 1u;
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Classify
+********************************************************************************
+*
+* Summary:
+*  Records the parameters in use and finds the matching profile.
+*
+* Parameters:
+*  uint16 connIntv: Connection interval in 1.25 ms units.
+*  uint16 connLatency: Slave latency.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnParam_Classify(uint16 connIntv, uint16 connLatency)
+{
+    ConnParamStats.connIntv = connIntv;
+    ConnParamStats.connLatency = connLatency;
+
+    if((connIntv >= CONNPARAM_IDLE_INTV_MIN) && (connIntv <= CONNPARAM_IDLE_INTV_MAX) &&
+       (connLatency == CONNPARAM_IDLE_LATENCY))
+    {
+        ConnParamStats.profile = CONNPARAM_PROFILE_IDLE;
+    }
+    else if((connIntv >= CONNPARAM_ACTIVE_INTV_MIN) && (connIntv <= CONNPARAM_ACTIVE_INTV_MAX) &&
+            (connLatency == CONNPARAM_ACTIVE_LATENCY))
+    {
+        ConnParamStats.profile = CONNPARAM_PROFILE_ACTIVE;
+    }
+    else
+    {
+        ConnParamStats.profile = CONNPARAM_PROFILE_NONE;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Connected
+********************************************************************************
+*
+* Summary:
+*  Starts the negotiation for a new link. Called on
+*  CYBLE_EVT_GAP_DEVICE_CONNECTED.
+*
+* Parameters:
+*  uint16 connIntv: Connection interval in 1.25 ms units.
+*  uint16 connLatency: Slave latency.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Connected(uint16 connIntv, uint16 connLatency)
+{
+    ConnParam_Classify(connIntv, connLatency);
+
+    ConnParamConnected = 1u;
+    ConnParamPending = 0u;
+    ConnParamRequested = CONNPARAM_PROFILE_NONE;
+    ConnParamRejected = CONNPARAM_PROFILE_NONE;
+
+    ConnParamTimedOut = 0u;
+    ConnParamSettled = 0u;
+    SwTimer_Start(&ConnParamSettleTimer, CONNPARAM_SETTLE_MS, 0u, ConnParam_SettleCallback);
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Disconnected
+********************************************************************************
+*
+* Summary:
+*  Stops the negotiation. Called on CYBLE_EVT_GAP_DEVICE_DISCONNECTED.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Disconnected(void)
+{
+    SwTimer_Stop(&ConnParamSettleTimer);
+    SwTimer_Stop(&ConnParamUpdateTimer);
+
+    ConnParamConnected = 0u;
+    ConnParamPending = 0u;
+    ConnParamStats.profile = CONNPARAM_PROFILE_NONE;
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Updated
+********************************************************************************
+*
+* Summary:
+*  Records the parameters applied by the controller. Called on
+*  CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE.
+*
+* Parameters:
+*  uint16 connIntv: Connection interval in 1.25 ms units.
+*  uint16 connLatency: Slave latency.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Updated(uint16 connIntv, uint16 connLatency)
+{
+    ConnParam_Classify(connIntv, connLatency);
+
+    if(ConnParamPending != 0u)
+    {
+        if(ConnParamStats.profile == ConnParamRequested)
+        {
+            ConnParamStats.updates++;
+        }
+        else
+        {
+            /* The central applied other parameters, keep them */
+            ConnParamRejected = ConnParamRequested;
+        }
+        SwTimer_Stop(&ConnParamUpdateTimer);
+        ConnParamPending = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_UpdateRsp
+********************************************************************************
+*
+* Summary:
+*  Records the response of the central to the last request. Called on
+*  CYBLE_EVT_L2CAP_CONN_PARAM_UPDATE_RSP. An accepted request stays
+*  outstanding until CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE or until its
+*  timeout.
+*
+* Parameters:
+*  uint16 response: 0 if the request was accepted, 1 if it was rejected.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_UpdateRsp(uint16 response)
+{
+    if(response == 0u)
+    {
+        ConnParamStats.accepted++;
+    }
+    else
+    {
+        ConnParamStats.rejected++;
+        SwTimer_Stop(&ConnParamUpdateTimer);
+        ConnParamRejected = ConnParamRequested;
+        ConnParamPending = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Demand
+********************************************************************************
+*
+* Summary:
+*  Sets or clears reasons for the active profile. The active profile is
+*  requested while any reason is set.
+*
+* Parameters:
+*  uint8 reasons: CONNPARAM_DEMAND_ALERT and/or CONNPARAM_DEMAND_TRANSFER.
+*  uint8 enable: 1 to set the reasons, 0 to clear them.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Demand(uint8 reasons, uint8 enable)
+{
+    uint8 demand = ConnParamDemand;
+
+    if(enable != 0u)
+    {
+        demand |= reasons;
+    }
+    else
+    {
+        demand &= (uint8)~reasons;
+    }
+
+    if((demand == 0u) != (ConnParamDemand == 0u))
+    {
+        /* The wanted profile changes, a rejected profile may be retried */
+        ConnParamRejected = CONNPARAM_PROFILE_NONE;
+    }
+
+    ConnParamDemand = demand;
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Process
+********************************************************************************
+*
+* Summary:
+*  Ends a request that timed out, then sends a connection parameter update
+*  request if the parameters in use do not match the wanted profile. Called
+*  from the main loop.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Process(void)
+{
+    CYBLE_GAP_CONN_UPDATE_PARAM_T param;
+    uint8 profile;
+
+    if(ConnParamTimedOut != 0u)
+    {
+        ConnParamTimedOut = 0u;
+
+        if(ConnParamPending != 0u)
+        {
+            /* The central did not apply the request, keep the parameters */
+            ConnParamRejected = ConnParamRequested;
+            ConnParamPending = 0u;
+        }
+    }
+
+    if((ConnParamConnected != 0u) && (ConnParamPending == 0u))
+    {
+        profile = (ConnParamDemand != 0u) ? CONNPARAM_PROFILE_ACTIVE : CONNPARAM_PROFILE_IDLE;
+
+        if((profile != ConnParamStats.profile) && (profile != ConnParamRejected) &&
+           ((profile == CONNPARAM_PROFILE_ACTIVE) || (ConnParamSettled != 0u)))
+        {
+            if(profile == CONNPARAM_PROFILE_ACTIVE)
+            {
+                param.connIntvMin = CONNPARAM_ACTIVE_INTV_MIN;
+                param.connIntvMax = CONNPARAM_ACTIVE_INTV_MAX;
+                param.connLatency = CONNPARAM_ACTIVE_LATENCY;
+                param.supervisionTO = CONNPARAM_ACTIVE_TIMEOUT;
+            }
+            else
+            {
+                param.connIntvMin = CONNPARAM_IDLE_INTV_MIN;
+                param.connIntvMax = CONNPARAM_IDLE_INTV_MAX;
+                param.connLatency = CONNPARAM_IDLE_LATENCY;
+                param.supervisionTO = CONNPARAM_IDLE_TIMEOUT;
+            }
+
+            if(CyBle_L2capLeConnectionParamUpdateRequest(cyBle_connHandle.bdHandle, &param) == CYBLE_ERROR_OK)
+            {
+                ConnParamStats.requests++;
+                ConnParamRequested = profile;
+                ConnParamPending = 1u;
+                SwTimer_Start(&ConnParamUpdateTimer, CONNPARAM_UPDATE_TIMEOUT_MS, 0u,
+                              ConnParam_UpdateTimeoutCallback);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_GetStats
+********************************************************************************
+*
+* Summary:
+*  Returns the negotiation counters and the parameters in use.
+*
+* Parameters:
+*  CONNPARAM_STATS *stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_GetStats(CONNPARAM_STATS *stats)
+{
+    *stats = ConnParamStats;
+}
+
+/* [] END OF FILE */
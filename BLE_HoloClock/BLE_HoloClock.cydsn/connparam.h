@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name: connparam.h
+*
+* Description:
+*  Contains the connection parameter manager API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CONNPARAM_H)
+#define CONNPARAM_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Connection parameter profiles. The intervals are in 1.25 ms units and
+ * the supervision timeouts in 10 ms units. The idle profile trades
+ * responsiveness for power: the slave may skip up to CONNPARAM_IDLE_LATENCY
+ * events while it has nothing to send. The active profile keeps the
+ * interval long enough for a flash row write between the events. */
+#define CONNPARAM_IDLE_INTV_MIN     160u    /* 200 ms */
+#define CONNPARAM_IDLE_INTV_MAX     200u    /* 250 ms */
+#define CONNPARAM_IDLE_LATENCY      4u
+#define CONNPARAM_IDLE_TIMEOUT      600u    /* 6 s    */
+
+#define CONNPARAM_ACTIVE_INTV_MIN   24u     /* 30 ms  */
+#define CONNPARAM_ACTIVE_INTV_MAX   40u     /* 50 ms  */
+#define CONNPARAM_ACTIVE_LATENCY    0u
+#define CONNPARAM_ACTIVE_TIMEOUT    400u    /* 4 s    */
+
+#define CONNPARAM_PROFILE_NONE      0u
+#define CONNPARAM_PROFILE_IDLE      1u
+#define CONNPARAM_PROFILE_ACTIVE    2u
+
+/* Time left to the central after the connection, for the service
+ * discovery, before the idle profile is requested. */
+#define CONNPARAM_SETTLE_MS         5000u
+
+/* Time allowed for the response of the central and the update instant,
+ * the longest L2CAP signaling response timeout. */
+#define CONNPARAM_UPDATE_TIMEOUT_MS 30000u
+
+/* Reasons for the active profile, passed to ConnParam_Demand(). */
+#define CONNPARAM_DEMAND_ALERT      0x01u
+#define CONNPARAM_DEMAND_TRANSFER   0x02u
+
+/***************************************
+*        Data Structure Definition
+***************************************/
+/* Negotiation counters since the start. */
+typedef struct
+{
+    uint32 requests;        /* Update requests sent to the central        */
+    uint32 accepted;        /* Requests accepted by the central           */
+    uint32 rejected;        /* Requests rejected by the central           */
+    uint32 updates;         /* Updates that applied a requested profile   */
+    uint16 connIntv;        /* Connection interval in use, 1.25 ms units  */
+    uint16 connLatency;     /* Slave latency in use                       */
+    uint8 profile;          /* Profile in use, CONNPARAM_PROFILE_NONE if
+                             * the parameters match no profile            */
+} CONNPARAM_STATS;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void ConnParam_Connected(uint16 connIntv, uint16 connLatency);
+void ConnParam_Disconnected(void);
+void ConnParam_Updated(uint16 connIntv, uint16 connLatency);
+void ConnParam_UpdateRsp(uint16 response);
+void ConnParam_Demand(uint8 reasons, uint8 enable);
+void ConnParam_Process(void);
+void ConnParam_GetStats(CONNPARAM_STATS *stats);
+
+#endif /* CONNPARAM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,240 @@
+/*******************************************************************************
+* File Name: flashsched.c
+*
+* Description:
+*  This file schedules the flash writes around the BLE radio activity.
+*  Programming a flash row stalls the CPU, so while connected a row is only
+*  programmed when the time since the last connection event closed, plus
+*  the row write and a guard time, is still less than the connection
+*  interval. The close time is latched by LowPower_Enter(). One row is
+*  programmed per call, in order of priority:
+*   - the bonding data and CCCD values queued by the BLE stack in
+*     cyBle_pendingFlashWrite, when bonding is enabled;
+*   - the background compaction of the key-value store.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "flashsched.h"
+#include "kvstore.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Connection interval of the current link in 1.25 ms units. */
+static uint16 FlashSchedConnIntv = 0u;
+
+/* Timebase ticks when the last connection event of the link closed, valid
+ * when FlashSchedClosed is set. */
+static uint64 FlashSchedCloseTicks = 0u;
+static uint8 FlashSchedClosed = 0u;
+
+/* Rows programmed by the scheduler and calls that found stack data pending
+ * but no idle window, or whose write the stack did not permit. */
+static uint32 FlashSchedRows = 0u;
+static uint32 FlashSchedDeferred = 0u;
+
+
+/*******************************************************************************
+* Function Name: FlashSched_WindowOpen
+********************************************************************************
+*
+* Summary:
+*  Checks whether a flash row can be programmed without delaying the radio.
+*  While connected, the time since the last event close plus a row write
+*  and the guard time must be less than the connection interval. While
+*  advertising, only the event must have closed, as a late advertising
+*  event is harmless.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 if a row can be programmed now, otherwise 0.
+*
+*******************************************************************************/
+static uint8 FlashSched_WindowOpen(void)
+{
+    uint8 open = 0u;
+    uint64 elapsedUs;
+
+    switch(CyBle_GetState())
+    {
+        case CYBLE_STATE_CONNECTED:
+        if(FlashSchedClosed != 0u)
+        {
+            elapsedUs = CySysTimebaseTicksToUs(CySysTimebaseGetTicks() - FlashSchedCloseTicks);
+            if((elapsedUs + FLASHSCHED_ROW_WRITE_US + FLASHSCHED_GUARD_US) <
+               ((uint64)FlashSchedConnIntv * FLASHSCHED_CONN_INTV_UNIT_US))
+            {
+                open = 1u;
+            }
+        }
+        break;
+
+        case CYBLE_STATE_ADVERTISING:
+        if(CyBle_GetBleSsState() == CYBLE_BLESS_STATE_EVENT_CLOSE)
+        {
+            open = 1u;
+        }
+        break;
+
+        case CYBLE_STATE_DISCONNECTED:
+        open = 1u;
+        break;
+
+        default:
+        break;
+    }
+
+    return(open);
+}
+
+/*******************************************************************************
+* Function Name: FlashSched_SetConnInterval
+********************************************************************************
+*
+* Summary:
+*  Sets the connection interval of the link. Called when the link is
+*  established and when its parameters are updated. The close time of an
+*  earlier event does not apply to the new interval, so it is dropped.
+*
+* Parameters:
+*  uint16 connIntv: Connection interval in 1.25 ms units.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void FlashSched_SetConnInterval(uint16 connIntv)
+{
+    FlashSchedConnIntv = connIntv;
+    FlashSchedClosed = 0u;
+}
+
+/*******************************************************************************
+* Function Name: FlashSched_EventClosed
+********************************************************************************
+*
+* Summary:
+*  Latches the time a connection event closed. Called by LowPower_Enter()
+*  when it finds BLESS closing the event.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void FlashSched_EventClosed(void)
+{
+    FlashSchedCloseTicks = CySysTimebaseGetTicks();
+    FlashSchedClosed = 1u;
+}
+
+/*******************************************************************************
+* Function Name: FlashSched_Run
+********************************************************************************
+*
+* Summary:
+*  Programs at most one pending flash row if the radio leaves time for it.
+*  Called from the main loop right after CyBle_ProcessEvents(). A call
+*  counts as a row write only when the stack or the store reports success.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 if a row write was done, otherwise 0.
+*
+*******************************************************************************/
+uint8 FlashSched_Run(void)
+{
+    uint8 programmed = 0u;
+
+    if(FlashSched_WindowOpen() != 0u)
+    {
+    #if((CYBLE_GAP_ROLE_PERIPHERAL || CYBLE_GAP_ROLE_CENTRAL) && (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES))
+        if(cyBle_pendingFlashWrite != 0u)
+        {
+            /* Stores one row per call and clears the pending bits once
+             * all the data is stored. CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED
+             * leaves the data pending for a later window. */
+            if(CyBle_StoreBondingData(0u) == CYBLE_ERROR_OK)
+            {
+                programmed = 1u;
+            }
+            else
+            {
+                FlashSchedDeferred++;
+            }
+        }
+        else
+    #endif  /* (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES) */
+        {
+            programmed = KvStore_Compact();
+        }
+
+        if(programmed != 0u)
+        {
+            FlashSchedRows++;
+        }
+    }
+    else
+    {
+    #if((CYBLE_GAP_ROLE_PERIPHERAL || CYBLE_GAP_ROLE_CENTRAL) && (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES))
+        if(cyBle_pendingFlashWrite != 0u)
+        {
+            FlashSchedDeferred++;
+        }
+    #endif  /* (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES) */
+    }
+
+    return(programmed);
+}
+
+/*******************************************************************************
+* Function Name: FlashSched_GetRowsWritten
+********************************************************************************
+*
+* Summary:
+*  Returns the number of row writes done by the scheduler.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Number of row writes.
+*
+*******************************************************************************/
+uint32 FlashSched_GetRowsWritten(void)
+{
+    return(FlashSchedRows);
+}
+
+/*******************************************************************************
+* Function Name: FlashSched_GetDeferred
+********************************************************************************
+*
+* Summary:
+*  Returns the number of calls that deferred pending stack data because
+*  the radio left no time for a row write or the stack did not permit it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Number of deferred calls.
+*
+*******************************************************************************/
+uint32 FlashSched_GetDeferred(void)
+{
+    return(FlashSchedDeferred);
+}
+
+/* [] END OF FILE */
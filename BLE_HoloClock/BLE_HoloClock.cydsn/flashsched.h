@@ -0,0 +1,44 @@
+/*******************************************************************************
+* File Name: flashsched.h
+*
+* Description:
+*  Contains the flash write scheduler API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(FLASHSCHED_H)
+#define FLASHSCHED_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Longest erase and program time of a flash row in microseconds. The CPU
+ * is stalled for that time. */
+#define FLASHSCHED_ROW_WRITE_US         20000u
+
+/* Time kept free before the next connection event in microseconds. It
+ * covers the wakeup of the BLESS for the next event and the error of the
+ * latched close time. */
+#define FLASHSCHED_GUARD_US             5000u
+
+/* Unit of the connection interval in microseconds. */
+#define FLASHSCHED_CONN_INTV_UNIT_US    1250u
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void FlashSched_SetConnInterval(uint16 connIntv);
+void FlashSched_EventClosed(void);
+uint8 FlashSched_Run(void);
+uint32 FlashSched_GetRowsWritten(void);
+uint32 FlashSched_GetDeferred(void);
+
+#endif /* FLASHSCHED_H */
+
+/* [] END OF FILE */
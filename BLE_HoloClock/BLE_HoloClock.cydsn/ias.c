@@ -13,6 +13,7 @@
 
 #include <project.h>
 #include "ias.h"
+#include "telemetry.h"
 
 /* IAS alert level value */
 uint8 alertLevel = 0;
@@ -36,12 +37,19 @@ uint8 alertLevel = 0;
 *******************************************************************************/
 void IasEventHandler(uint32 event, void *eventParam)
 {
+    uint8 previousLevel = alertLevel;
+    
     /* Alert Level Characteristic write event */
     if(event == CYBLE_EVT_IASS_WRITE_CHAR_CMD)
     {
         /* Read the updated Alert Level value from the GATT database */
         CyBle_IassGetCharacteristicValue(CYBLE_IAS_ALERT_LEVEL, 
             sizeof(alertLevel), &alertLevel);
+        
+        if(alertLevel != previousLevel)
+        {
+            Telemetry_Alert(alertLevel);
+        }
     }
 }
 
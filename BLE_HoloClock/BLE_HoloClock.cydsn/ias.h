@@ -20,7 +20,7 @@
 #define MILD_ALERT         (1u)
 #define HIGH_ALERT         (2u)
 
-#define LED_TOGGLE_TIMEOUT      (100u)
+#define LED_BLINK_PERIOD_MS     (1000u)
 
 extern uint8 alertLevel;
 
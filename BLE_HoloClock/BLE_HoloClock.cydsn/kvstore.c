@@ -0,0 +1,658 @@
+/*******************************************************************************
+* File Name: kvstore.c
+*
+* Description:
+*  This file provides a log-structured key-value store in a reserved flash
+*  region. Records are appended to the head row, so an update programs only
+*  that row and the rows are used in turn. A RAM index built at boot points
+*  to the latest record of each key. When the head row is full, the oldest
+*  row of the circular log is reused as the new head. Its new image carries
+*  the live records of the second oldest row, so that the oldest row never
+*  holds the only copy of a live record when it is erased: a reset while it
+*  is programmed loses nothing. KvStore_Compact() opens the new head ahead
+*  of time from the main loop.
+*
+*  The functions are not reentrant and must not be called from interrupts.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "kvstore.h"
+
+/***************************************
+*        Local Data Types
+***************************************/
+/* Location of the latest record of a key. */
+typedef struct
+{
+    uint8 key;                  /* KVSTORE_KEY_NONE for a free entry      */
+    uint8 row;
+    uint8 offset;
+} KVSTORE_ENTRY;
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Flash rows of the store, aligned and excluded from the checksum like
+ * cyBle_flashStorage. The object is volatile as it is programmed at run
+ * time. */
+#if defined(__ARMCC_VERSION)
+    CY_ALIGN(CY_FLASH_SIZEOF_ROW) static const volatile uint8 KvStoreFlash[KVSTORE_ROWS * CY_FLASH_SIZEOF_ROW]
+        CY_SECTION(".cy_checksum_exclude") = {0u};
+#elif defined (__GNUC__)
+    static const volatile uint8 KvStoreFlash[KVSTORE_ROWS * CY_FLASH_SIZEOF_ROW] CY_SECTION(".cy_checksum_exclude")
+        CY_ALIGN(CY_FLASH_SIZEOF_ROW) = {0u};
+#elif defined (__ICCARM__)
+    #pragma data_alignment=CY_FLASH_SIZEOF_ROW
+    #pragma location=".cy_checksum_exclude"
+    static const volatile uint8 KvStoreFlash[KVSTORE_ROWS * CY_FLASH_SIZEOF_ROW] = {0u};
+#endif  /* (__ARMCC_VERSION) */
+
+static KVSTORE_ENTRY KvStoreIndex[KVSTORE_MAX_KEYS];
+
+/* Row that takes the appended records, its sequence number, 0 while the
+ * store is empty, and the offset of its first free byte. */
+static uint8 KvStoreHead = KVSTORE_ROWS - 1u;
+static uint32 KvStoreSeq = 0u;
+static uint32 KvStoreFill = CY_FLASH_SIZEOF_ROW;
+
+
+/*******************************************************************************
+* Function Name: KvStore_CopyRow
+********************************************************************************
+*
+* Summary:
+*  Copies a row of the store from flash.
+*
+* Parameters:
+*  uint8 buf[]: Buffer of CY_FLASH_SIZEOF_ROW bytes.
+*  uint8 row: Row of the store.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void KvStore_CopyRow(uint8 buf[], uint8 row)
+{
+    uint32 base = (uint32)row * CY_FLASH_SIZEOF_ROW;
+    uint32 index;
+
+    for(index = 0u; index < CY_FLASH_SIZEOF_ROW; index++)
+    {
+        buf[index] = KvStoreFlash[base + index];
+    }
+}
+
+/*******************************************************************************
+* Function Name: KvStore_GetSeq
+********************************************************************************
+*
+* Summary:
+*  Returns the sequence number of a row image.
+*
+* Parameters:
+*  const uint8 buf[]: Row image.
+*
+* Return:
+*  uint32: Sequence number, 0 for a row that was never used.
+*
+*******************************************************************************/
+static uint32 KvStore_GetSeq(const uint8 buf[])
+{
+    return((uint32)buf[0u] | ((uint32)buf[1u] << 8u) | ((uint32)buf[2u] << 16u) | ((uint32)buf[3u] << 24u));
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Checksum
+********************************************************************************
+*
+* Summary:
+*  Computes the checksum of a record. The sum is inverted so that a record
+*  of zeros is never valid.
+*
+* Parameters:
+*  const uint8 record[]: Record starting with the key.
+*  uint32 length: Number of bytes covered, the key, length and value.
+*
+* Return:
+*  uint8: Checksum.
+*
+*******************************************************************************/
+static uint8 KvStore_Checksum(const uint8 record[], uint32 length)
+{
+    uint8 sum = 0u;
+    uint32 index;
+
+    for(index = 0u; index < length; index++)
+    {
+        sum += record[index];
+    }
+
+    return((uint8)~sum);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_ParseRecord
+********************************************************************************
+*
+* Summary:
+*  Checks the record at the given offset of a row image.
+*
+* Parameters:
+*  const uint8 buf[]: Row image.
+*  uint32 offset: Offset of the record.
+*
+* Return:
+*  uint32: Size of the record, 0 at the end of the records or for a record
+*          that was not completely written.
+*
+*******************************************************************************/
+static uint32 KvStore_ParseRecord(const uint8 buf[], uint32 offset)
+{
+    uint32 size = 0u;
+    uint32 length;
+
+    if(((offset + KVSTORE_RECORD_OVERHEAD) <= CY_FLASH_SIZEOF_ROW) && (buf[offset] != KVSTORE_KEY_NONE))
+    {
+        length = buf[offset + 1u];
+
+        if((length <= KVSTORE_MAX_VALUE) &&
+           ((offset + length + KVSTORE_RECORD_OVERHEAD) <= CY_FLASH_SIZEOF_ROW) &&
+           (KvStore_Checksum(&buf[offset], length + 2u) == buf[offset + length + 2u]))
+        {
+            size = length + KVSTORE_RECORD_OVERHEAD;
+        }
+    }
+
+    return(size);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Find
+********************************************************************************
+*
+* Summary:
+*  Looks up a key in the RAM index.
+*
+* Parameters:
+*  uint8 key: Key to look up, or KVSTORE_KEY_NONE for a free entry.
+*
+* Return:
+*  KVSTORE_ENTRY *: The index entry, or NULL if there is none.
+*
+*******************************************************************************/
+static KVSTORE_ENTRY *KvStore_Find(uint8 key)
+{
+    KVSTORE_ENTRY *entry = (void *)0;
+    uint32 index;
+
+    for(index = 0u; (index < KVSTORE_MAX_KEYS) && (entry == (void *)0); index++)
+    {
+        if(KvStoreIndex[index].key == key)
+        {
+            entry = &KvStoreIndex[index];
+        }
+    }
+
+    return(entry);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_ApplyRow
+********************************************************************************
+*
+* Summary:
+*  Updates the RAM index with the records of a row image, in order. Later
+*  records of a key replace the earlier ones and a record with length 0
+*  removes the key.
+*
+* Parameters:
+*  const uint8 buf[]: Row image.
+*  uint8 row: Row of the store that holds the image.
+*
+* Return:
+*  uint32: Offset of the first free byte of the row.
+*
+*******************************************************************************/
+static uint32 KvStore_ApplyRow(const uint8 buf[], uint8 row)
+{
+    KVSTORE_ENTRY *entry;
+    uint32 offset = KVSTORE_ROW_HEADER_SIZE;
+    uint32 size = KvStore_ParseRecord(buf, offset);
+
+    while(size != 0u)
+    {
+        entry = KvStore_Find(buf[offset]);
+
+        if(buf[offset + 1u] == 0u)
+        {
+            if(entry != (void *)0)
+            {
+                entry->key = KVSTORE_KEY_NONE;
+            }
+        }
+        else
+        {
+            if(entry == (void *)0)
+            {
+                entry = KvStore_Find(KVSTORE_KEY_NONE);
+            }
+            if(entry != (void *)0)
+            {
+                entry->key = buf[offset];
+                entry->row = row;
+                entry->offset = (uint8)offset;
+            }
+        }
+
+        offset += size;
+        size = KvStore_ParseRecord(buf, offset);
+    }
+
+    return(offset);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_CarryRow
+********************************************************************************
+*
+* Summary:
+*  Copies the live records of a row into a row image, as many as fit. The
+*  index entries of the records are left unchanged; they are moved when the
+*  image is committed.
+*
+* Parameters:
+*  uint8 buf[]: Row image.
+*  uint32 fill: Offset of the first free byte of the image.
+*  uint8 row: Row of the store whose live records are copied.
+*
+* Return:
+*  uint32: Offset of the first free byte of the image.
+*
+*******************************************************************************/
+static uint32 KvStore_CarryRow(uint8 buf[], uint32 fill, uint8 row)
+{
+    uint32 base = (uint32)row * CY_FLASH_SIZEOF_ROW;
+    uint32 size;
+    uint32 index;
+    uint32 byte;
+
+    for(index = 0u; index < KVSTORE_MAX_KEYS; index++)
+    {
+        if((KvStoreIndex[index].key != KVSTORE_KEY_NONE) && (KvStoreIndex[index].row == row))
+        {
+            size = (uint32)KvStoreFlash[base + KvStoreIndex[index].offset + 1u] + KVSTORE_RECORD_OVERHEAD;
+
+            if((fill + size) <= CY_FLASH_SIZEOF_ROW)
+            {
+                for(byte = 0u; byte < size; byte++)
+                {
+                    buf[fill + byte] = KvStoreFlash[base + KvStoreIndex[index].offset + byte];
+                }
+                fill += size;
+            }
+        }
+    }
+
+    return(fill);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Carry
+********************************************************************************
+*
+* Summary:
+*  Builds the new image of the oldest row, which is about to be reused as
+*  the head: the next sequence number, the live records the oldest row
+*  still holds because they did not fit when it was carried, then as many
+*  live records of the second oldest row as fit.
+*
+* Parameters:
+*  uint8 buf[]: Buffer of CY_FLASH_SIZEOF_ROW bytes for the image.
+*  uint8 row: Oldest row of the store, the one to reuse.
+*
+* Return:
+*  uint32: Offset of the first free byte of the image.
+*
+*******************************************************************************/
+static uint32 KvStore_Carry(uint8 buf[], uint8 row)
+{
+    uint32 seq = KvStoreSeq + 1u;
+    uint32 fill;
+    uint32 index;
+
+    for(index = 0u; index < CY_FLASH_SIZEOF_ROW; index++)
+    {
+        buf[index] = 0u;
+    }
+
+    buf[0u] = (uint8)seq;
+    buf[1u] = (uint8)(seq >> 8u);
+    buf[2u] = (uint8)(seq >> 16u);
+    buf[3u] = (uint8)(seq >> 24u);
+
+    fill = KvStore_CarryRow(buf, KVSTORE_ROW_HEADER_SIZE, row);
+    fill = KvStore_CarryRow(buf, fill, (uint8)((row + 1u) % KVSTORE_ROWS));
+
+    return(fill);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Commit
+********************************************************************************
+*
+* Summary:
+*  Programs a row image and makes the row the head of the log.
+*
+* Parameters:
+*  const uint8 buf[]: Row image.
+*  uint8 row: Row of the store.
+*
+* Return:
+*  uint8: KVSTORE_OK or KVSTORE_FLASH_ERROR.
+*
+*******************************************************************************/
+static uint8 KvStore_Commit(const uint8 buf[], uint8 row)
+{
+    uint32 rowNum = (((uint32)KvStoreFlash - CY_FLASH_BASE) / CY_FLASH_SIZEOF_ROW) + row;
+    uint8 result = KVSTORE_FLASH_ERROR;
+
+    if(CySysFlashWriteRow(rowNum, buf) == CY_SYS_FLASH_SUCCESS)
+    {
+        KvStoreHead = row;
+        KvStoreSeq = KvStore_GetSeq(buf);
+        KvStoreFill = KvStore_ApplyRow(buf, row);
+        result = KVSTORE_OK;
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Append
+********************************************************************************
+*
+* Summary:
+*  Appends a record to the head row. When the head row is full, the oldest
+*  row is reused as the new head until one has room for the record. Each
+*  turn programs one row and moves the live records of a row forward, and
+*  KVSTORE_MAX_KEYS records of KVSTORE_MAX_VALUE bytes cannot fill all the
+*  rows, so the record fits within KVSTORE_ROWS turns.
+*
+* Parameters:
+*  uint8 key: Key of the record.
+*  const uint8 data[]: Value, not used when length is 0.
+*  uint8 length: Value length, 0 to delete the key.
+*
+* Return:
+*  uint8: KVSTORE_OK, KVSTORE_FULL or KVSTORE_FLASH_ERROR.
+*
+*******************************************************************************/
+static uint8 KvStore_Append(uint8 key, const uint8 data[], uint8 length)
+{
+    uint8 buf[CY_FLASH_SIZEOF_ROW];
+    uint32 size = (uint32)length + KVSTORE_RECORD_OVERHEAD;
+    uint32 fill;
+    uint32 index;
+    uint32 turn = 0u;
+    uint8 row;
+    uint8 appended = 0u;
+    uint8 result = KVSTORE_OK;
+
+    while((appended == 0u) && (result == KVSTORE_OK))
+    {
+        if((KvStoreFill + size) <= CY_FLASH_SIZEOF_ROW)
+        {
+            row = KvStoreHead;
+            KvStore_CopyRow(buf, row);
+            fill = KvStoreFill;
+        }
+        else if(turn < KVSTORE_ROWS)
+        {
+            row = (uint8)((KvStoreHead + 1u) % KVSTORE_ROWS);
+            fill = KvStore_Carry(buf, row);
+            turn++;
+        }
+        else
+        {
+            result = KVSTORE_FULL;
+        }
+
+        if(result == KVSTORE_OK)
+        {
+            if((fill + size) <= CY_FLASH_SIZEOF_ROW)
+            {
+                buf[fill] = key;
+                buf[fill + 1u] = length;
+                for(index = 0u; index < length; index++)
+                {
+                    buf[fill + 2u + index] = data[index];
+                }
+                buf[fill + 2u + length] = KvStore_Checksum(&buf[fill], (uint32)length + 2u);
+                appended = 1u;
+            }
+
+            result = KvStore_Commit(buf, row);
+        }
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Init
+********************************************************************************
+*
+* Summary:
+*  Builds the RAM index by replaying the rows from the oldest to the newest
+*  and finds the head row.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void KvStore_Init(void)
+{
+    uint8 buf[CY_FLASH_SIZEOF_ROW];
+    uint32 nextSeq;
+    uint32 seq;
+    uint8 next;
+    uint8 row;
+
+    for(row = 0u; row < KVSTORE_MAX_KEYS; row++)
+    {
+        KvStoreIndex[row].key = KVSTORE_KEY_NONE;
+    }
+
+    KvStoreHead = KVSTORE_ROWS - 1u;
+    KvStoreSeq = 0u;
+    KvStoreFill = CY_FLASH_SIZEOF_ROW;
+
+    do
+    {
+        /* Find the row that follows the last replayed one */
+        next = KVSTORE_ROWS;
+        nextSeq = 0xFFFFFFFFu;
+        for(row = 0u; row < KVSTORE_ROWS; row++)
+        {
+            KvStore_CopyRow(buf, row);
+            seq = KvStore_GetSeq(buf);
+            if((seq > KvStoreSeq) && (seq < nextSeq))
+            {
+                next = row;
+                nextSeq = seq;
+            }
+        }
+
+        if(next < KVSTORE_ROWS)
+        {
+            KvStore_CopyRow(buf, next);
+            KvStoreHead = next;
+            KvStoreSeq = nextSeq;
+            KvStoreFill = KvStore_ApplyRow(buf, next);
+        }
+    }
+    while(next < KVSTORE_ROWS);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Write
+********************************************************************************
+*
+* Summary:
+*  Stores a value. Programs one flash row.
+*
+* Parameters:
+*  uint8 key: Key, any value but KVSTORE_KEY_NONE.
+*  const uint8 data[]: Value.
+*  uint8 length: Value length, 1 to KVSTORE_MAX_VALUE.
+*
+* Return:
+*  uint8: KVSTORE_OK, KVSTORE_BAD_PARAM, KVSTORE_FULL when the index or the
+*         flash region is full, or KVSTORE_FLASH_ERROR.
+*
+*******************************************************************************/
+uint8 KvStore_Write(uint8 key, const uint8 data[], uint8 length)
+{
+    uint8 result;
+
+    if((key == KVSTORE_KEY_NONE) || (data == (void *)0) || (length == 0u) || (length > KVSTORE_MAX_VALUE))
+    {
+        result = KVSTORE_BAD_PARAM;
+    }
+    else if((KvStore_Find(key) == (void *)0) && (KvStore_Find(KVSTORE_KEY_NONE) == (void *)0))
+    {
+        result = KVSTORE_FULL;
+    }
+    else
+    {
+        result = KvStore_Append(key, data, length);
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Read
+********************************************************************************
+*
+* Summary:
+*  Reads the latest value of a key from flash.
+*
+* Parameters:
+*  uint8 key: Key to read.
+*  uint8 data[]: Buffer for the value.
+*  uint8 size: Size of the buffer. Longer values are truncated.
+*
+* Return:
+*  uint8: Length of the stored value, 0 if the key is not stored.
+*
+*******************************************************************************/
+uint8 KvStore_Read(uint8 key, uint8 data[], uint8 size)
+{
+    KVSTORE_ENTRY *entry = (void *)0;
+    uint32 base;
+    uint8 length = 0u;
+    uint8 index;
+
+    if(key != KVSTORE_KEY_NONE)
+    {
+        entry = KvStore_Find(key);
+    }
+
+    if(entry != (void *)0)
+    {
+        base = ((uint32)entry->row * CY_FLASH_SIZEOF_ROW) + entry->offset;
+        length = KvStoreFlash[base + 1u];
+
+        for(index = 0u; (index < length) && (index < size); index++)
+        {
+            data[index] = KvStoreFlash[base + 2u + index];
+        }
+    }
+
+    return(length);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Delete
+********************************************************************************
+*
+* Summary:
+*  Removes a key. Appends a record with length 0 if the key is stored.
+*
+* Parameters:
+*  uint8 key: Key to remove.
+*
+* Return:
+*  uint8: KVSTORE_OK, KVSTORE_BAD_PARAM, KVSTORE_FULL or KVSTORE_FLASH_ERROR.
+*
+*******************************************************************************/
+uint8 KvStore_Delete(uint8 key)
+{
+    uint8 result = KVSTORE_OK;
+
+    if(key == KVSTORE_KEY_NONE)
+    {
+        result = KVSTORE_BAD_PARAM;
+    }
+    else if(KvStore_Find(key) != (void *)0)
+    {
+        result = KvStore_Append(key, (void *)0, 0u);
+    }
+    else
+    {
+        /* Not stored, nothing to do */
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: KvStore_Compact
+********************************************************************************
+*
+* Summary:
+*  Background compaction step, called from the main loop when there is
+*  time to program a row. Once the head row is filled beyond
+*  KVSTORE_COMPACT_FILL, the oldest row of the log is reused as the new
+*  head ahead of time, so that the following writes only append. Nothing
+*  is done if the live records it carries would fill it beyond
+*  KVSTORE_COMPACT_FILL as well.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 if a row was programmed, otherwise 0.
+*
+*******************************************************************************/
+uint8 KvStore_Compact(void)
+{
+    uint8 buf[CY_FLASH_SIZEOF_ROW];
+    uint32 fill;
+    uint8 row;
+    uint8 programmed = 0u;
+
+    if((KvStoreSeq != 0u) && (KvStoreFill > KVSTORE_COMPACT_FILL))
+    {
+        row = (uint8)((KvStoreHead + 1u) % KVSTORE_ROWS);
+        fill = KvStore_Carry(buf, row);
+
+        if((fill <= KVSTORE_COMPACT_FILL) && (KvStore_Commit(buf, row) == KVSTORE_OK))
+        {
+            programmed = 1u;
+        }
+    }
+
+    return(programmed);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,59 @@
+/*******************************************************************************
+* File Name: kvstore.h
+*
+* Description:
+*  Contains the key-value store API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(KVSTORE_H)
+#define KVSTORE_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Number of flash rows reserved for the store. The rows are used as a
+ * circular log, so each row is erased once per turn of the log. */
+#define KVSTORE_ROWS                8u
+
+/* Number of keys the RAM index can hold and the longest value. */
+#define KVSTORE_MAX_KEYS            16u
+#define KVSTORE_MAX_VALUE           32u
+
+/* Key 0 marks the end of the records in a row and cannot be used. */
+#define KVSTORE_KEY_NONE            0x00u
+
+/* Row layout: a 32-bit sequence number, 0 for a row that was never used,
+ * followed by the records. A record is the key, the value length, the
+ * value and a checksum. A record with length 0 deletes the key. */
+#define KVSTORE_ROW_HEADER_SIZE     4u
+#define KVSTORE_RECORD_OVERHEAD     3u
+
+/* Background compaction opens the next row once the head row is filled
+ * beyond this offset, so that the writes that follow only append. */
+#define KVSTORE_COMPACT_FILL        96u
+
+/* Return codes */
+#define KVSTORE_OK                  0x00u
+#define KVSTORE_BAD_PARAM           0x01u
+#define KVSTORE_FULL                0x02u
+#define KVSTORE_FLASH_ERROR         0x03u
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void KvStore_Init(void);
+uint8 KvStore_Write(uint8 key, const uint8 data[], uint8 length);
+uint8 KvStore_Read(uint8 key, uint8 data[], uint8 size);
+uint8 KvStore_Delete(uint8 key);
+uint8 KvStore_Compact(void);
+
+#endif /* KVSTORE_H */
+
+/* [] END OF FILE */
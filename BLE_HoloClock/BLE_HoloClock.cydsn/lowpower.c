@@ -0,0 +1,148 @@
+/*******************************************************************************
+* File Name: lowpower.c
+*
+* Description:
+*  This file puts the device in the deepest low power mode that the BLE
+*  subsystem (BLESS) allows. Deep-Sleep is entered while BLESS sleeps or its
+*  crystal oscillator starts, and Sleep while the radio is active. While
+*  BLESS closes a connection event it can neither sleep nor be left
+*  running unattended, so the CPU sleeps until the link layer interrupt
+*  (CyBLE_Bless_Interrupt) that ends the close instead of spinning through
+*  the main loop. SysTick bounds that wait. It is set up once, so the wait
+*  only restarts its count and does not reprogram the WDT, which would
+*  busy-wait for LFCLK cycles with the interrupts masked. The branches
+*  taken are counted, to show how often the device is held awake at event
+*  close.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "lowpower.h"
+#include "flashsched.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+static LOWPOWER_STATS LowPowerStats;
+
+
+/*******************************************************************************
+* Function Name: LowPower_Init
+********************************************************************************
+*
+* Summary:
+*  Sets up SysTick as the guard of the event close wait: its vector and
+*  interrupt are enabled, and the counter is left stopped until a wait.
+*  No SysTick callback is registered, so its interrupt only ends the Sleep.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LowPower_Init(void)
+{
+    CySysTickStart();
+    CySysTickStop();
+}
+
+/*******************************************************************************
+* Function Name: LowPower_Enter
+********************************************************************************
+*
+* Summary:
+*  Configures BLESS for Deep-Sleep and enters the deepest system low power
+*  mode its state allows. Returns after the wake-up interrupt has been
+*  serviced. Called once per main loop pass, after the BLE stack events
+*  have been processed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LowPower_Enter(void)
+{
+    CYBLE_BLESS_STATE_T blessState;
+    uint8 intrStatus;
+
+    /* Configure BLESS in Deep-Sleep mode */
+    CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
+
+    /* Prevent interrupts while entering system low power modes */
+    intrStatus = CyEnterCriticalSection();
+
+    /* Get the current state of BLESS block */
+    blessState = CyBle_GetBleSsState();
+
+    /* If BLESS is in Deep-Sleep mode or the XTAL oscillator is turning on,
+     * then PSoC 4 BLE can enter Deep-Sleep mode (1.3uA current consumption) */
+    if(blessState == CYBLE_BLESS_STATE_ECO_ON ||
+        blessState == CYBLE_BLESS_STATE_DEEPSLEEP)
+    {
+        LowPowerStats.deepSleep++;
+        CySysPmDeepSleep();
+    }
+    else if(blessState != CYBLE_BLESS_STATE_EVENT_CLOSE)
+    {
+        /* If BLESS is active, then configure PSoC 4 BLE system in
+         * Sleep mode (~1.6mA current consumption) */
+        LowPowerStats.sleep++;
+        CySysPmSleep();
+    }
+    else
+    {
+        /* BLESS is closing the connection event and cannot go to
+         * Deep-Sleep yet. Sleep until the link layer interrupt, which is
+         * still taken with the interrupts disabled here, and try again on
+         * the next pass. The close time opens the flash write window.
+         * SysTick counts from SYSCLK, which keeps running in Sleep, and
+         * wakes the CPU if the close ends without an interrupt. Clearing
+         * the count also clears its count flag. */
+        LowPowerStats.eventClose++;
+        FlashSched_EventClosed();
+        CySysTickSetReload((cydelayFreqHz / 1000u) * LOWPOWER_EVENT_CLOSE_GUARD_MS);
+        CySysTickClear();
+        CySysTickEnable();
+        CySysPmSleep();
+        CySysTickStop();
+
+        if(CySysTickGetCountFlag() != 0u)
+        {
+            LowPowerStats.guardExpired++;
+        }
+    }
+    CyExitCriticalSection(intrStatus);
+
+    /* BLE link layer timing interrupt will wake up the system from Sleep
+     * and Deep-Sleep modes */
+}
+
+/*******************************************************************************
+* Function Name: LowPower_GetStats
+********************************************************************************
+*
+* Summary:
+*  Returns the number of times each low power branch was taken.
+*
+* Parameters:
+*  LOWPOWER_STATS *stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LowPower_GetStats(LOWPOWER_STATS *stats)
+{
+    *stats = LowPowerStats;
+}
+
+/* [] END OF FILE */
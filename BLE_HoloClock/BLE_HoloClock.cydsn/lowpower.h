@@ -0,0 +1,47 @@
+/*******************************************************************************
+* File Name: lowpower.h
+*
+* Description:
+*  Contains the low power mode entry API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(LOWPOWER_H)
+#define LOWPOWER_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Longest Sleep while BLESS closes a connection event, counted by SysTick
+ * at the current SYSCLK. The link layer interrupt normally ends the wait
+ * much earlier. */
+#define LOWPOWER_EVENT_CLOSE_GUARD_MS   1u
+
+/***************************************
+*        Data Structure Definition
+***************************************/
+/* Number of times each low power branch was taken */
+typedef struct
+{
+    uint32 deepSleep;       /* BLESS in Deep-Sleep or ECO start-up        */
+    uint32 sleep;           /* BLESS active                               */
+    uint32 eventClose;      /* BLESS closing a connection event           */
+    uint32 guardExpired;    /* Event close waits ended by SysTick         */
+} LOWPOWER_STATS;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void LowPower_Init(void);
+void LowPower_Enter(void);
+void LowPower_GetStats(LOWPOWER_STATS *stats);
+
+#endif /* LOWPOWER_H */
+
+/* [] END OF FILE */
@@ -34,17 +34,60 @@
 #include "ias.h"
 #include "common.h"
 #include "main.h"
+#include "swtimer.h"
+#include "kvstore.h"
+#include "flashsched.h"
+#include "connparam.h"
+#include "bulk.h"
+#include "telemetry.h"
+#include "bledispatch.h"
+#include "lowpower.h"
+
+/* Blinks the alert LED during a mild alert. The callback only flags the
+ * blink, which is handled in the main loop. */
+static SWTIMER blinkTimer;
+static volatile uint8 blinkDue = 0u;
+
+/* Stack events handled by the application */
+typedef struct
+{
+    uint32 event;
+    BLEDISPATCH_HANDLER handler;
+} STACK_EVENT_T;
+
+static void DisconnectedEventHandler(uint32 event, void *eventParam);
+static void ConnectedEventHandler(uint32 event, void *eventParam);
+static void AdvertisementEventHandler(uint32 event, void *eventParam);
+static void ErrorEventHandler(uint32 event, void *eventParam);
+static void ConnUpdateEventHandler(uint32 event, void *eventParam);
+static void ConnParamRspEventHandler(uint32 event, void *eventParam);
+
+static const STACK_EVENT_T stackEvents[] =
+{
+    { CYBLE_EVT_STACK_ON,                        DisconnectedEventHandler  },
+    { CYBLE_EVT_GAP_DEVICE_DISCONNECTED,         DisconnectedEventHandler  },
+    { CYBLE_EVT_GAP_DEVICE_CONNECTED,            ConnectedEventHandler     },
+    { CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP,   AdvertisementEventHandler },
+    { CYBLE_EVT_HARDWARE_ERROR,                  ErrorEventHandler         },
+    { CYBLE_EVT_HCI_STATUS,                      ErrorEventHandler         },
+    { CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE,  ConnUpdateEventHandler    },
+    { CYBLE_EVT_L2CAP_CONN_PARAM_UPDATE_RSP,     ConnParamRspEventHandler  },
+};
+#define STACK_EVENT_COUNT   (sizeof(stackEvents) / sizeof(stackEvents[0]))
+
+static BLEDISPATCH_NODE stackEventNodes[STACK_EVENT_COUNT];
 
 
 /*******************************************************************************
-* Function Name: StackEventHandler
+* Function Name: DisconnectedEventHandler
 ********************************************************************************
 *
 * Summary:
-*  This is an event callback function to receive events from the BLE Component.
+*  Handles CYBLE_EVT_STACK_ON and CYBLE_EVT_GAP_DEVICE_DISCONNECTED. These are
+*  mandatory events to be handled by Find Me Target design.
 *
 * Parameters:
-*  uint8 event:       Event from the CYBLE component
+*  uint32 event:      Event from the CYBLE component
 *  void* eventParams: A structure instance for corresponding event type. The
 *                     list of event structure is described in the component
 *                     datasheet.
@@ -53,101 +96,213 @@
 *  None
 *
 *******************************************************************************/
-void StackEventHandler(uint32 event, void *eventParam)
+static void DisconnectedEventHandler(uint32 event, void *eventParam)
 {
-    switch(event)
-    {
-        /* Mandatory events to be handled by Find Me Target design */
-        case CYBLE_EVT_STACK_ON:
-        case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
-            /* Start BLE advertisement for 30 seconds and update link
-             * status on LEDs */
-            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
-            Advertising_LED_Write(LED_ON);
-            alertLevel = NO_ALERT;
-            break;
-
-        case CYBLE_EVT_GAP_DEVICE_CONNECTED:
-            /* BLE link is established */
-            Advertising_LED_Write(LED_OFF);
-            Disconnect_LED_Write(LED_OFF);
-            break;
-
-        case CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP:
-            if(CyBle_GetState() == CYBLE_STATE_DISCONNECTED)
-            {
-                /* Advertisement event timed out, go to low power
-                 * mode (Stop mode) and wait for device reset
-                 * event to wake up the device again */
-                Advertising_LED_Write(LED_OFF);
-                Disconnect_LED_Write(LED_ON);
-                CySysPmSetWakeupPolarity(CY_PM_STOP_WAKEUP_ACTIVE_HIGH);
-                CySysPmStop();
-               
-                /* Code execution will not reach here */
-            }
-            break;
+    (void)event;
+    (void)eventParam;
+
+    /* Start BLE advertisement for 30 seconds and update link
+     * status on LEDs */
+    CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_FAST);
+    Advertising_LED_Write(LED_ON);
+    alertLevel = NO_ALERT;
+    ConnParam_Disconnected();
+}
 
-        /* Other events that are generated by the BLE Component that
-         * are not required for functioning of this design */
-        /**********************************************************
-        *                       General Events
-        ***********************************************************/
-        case CYBLE_EVT_HARDWARE_ERROR:    /* This event indicates that some internal HW error has occurred. */
-            break;
+/*******************************************************************************
+* Function Name: ConnectedEventHandler
+********************************************************************************
+*
+* Summary:
+*  Handles CYBLE_EVT_GAP_DEVICE_CONNECTED.
+*
+* Parameters:
+*  uint32 event:      Event from the CYBLE component
+*  void* eventParams: The connection parameters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnectedEventHandler(uint32 event, void *eventParam)
+{
+    CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T *connParam;
 
-        case CYBLE_EVT_HCI_STATUS:
-            break;
+    (void)event;
 
-        /**********************************************************
-        *                       GAP Events
-        ***********************************************************/
-        case CYBLE_EVT_GAP_AUTH_REQ:
-            break;
+    /* BLE link is established */
+    Advertising_LED_Write(LED_OFF);
+    Disconnect_LED_Write(LED_OFF);
+    connParam = (CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T *)eventParam;
+    FlashSched_SetConnInterval(connParam->connIntv);
+    ConnParam_Connected(connParam->connIntv, connParam->connLatency);
+}
 
-        case CYBLE_EVT_GAP_PASSKEY_ENTRY_REQUEST:
-            break;
+/*******************************************************************************
+* Function Name: AdvertisementEventHandler
+********************************************************************************
+*
+* Summary:
+*  Handles CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP.
+*
+* Parameters:
+*  uint32 event:      Event from the CYBLE component
+*  void* eventParams: Not used.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AdvertisementEventHandler(uint32 event, void *eventParam)
+{
+    (void)event;
+    (void)eventParam;
 
-        case CYBLE_EVT_GAP_PASSKEY_DISPLAY_REQUEST:
-            break;
+    if(CyBle_GetState() == CYBLE_STATE_DISCONNECTED)
+    {
+        /* Advertisement event timed out, go to low power
+         * mode (Stop mode) and wait for device reset
+         * event to wake up the device again */
+        Advertising_LED_Write(LED_OFF);
+        Disconnect_LED_Write(LED_ON);
+        CySysPmSetWakeupPolarity(CY_PM_STOP_WAKEUP_ACTIVE_HIGH);
+        CySysPmStop();
+       
+        /* Code execution will not reach here */
+    }
+}
 
-        case CYBLE_EVT_GAP_AUTH_COMPLETE:
+/*******************************************************************************
+* Function Name: ErrorEventHandler
+********************************************************************************
+*
+* Summary:
+*  Handles CYBLE_EVT_HARDWARE_ERROR and CYBLE_EVT_HCI_STATUS by counting them
+*  in the telemetry.
+*
+* Parameters:
+*  uint32 event:      Event from the CYBLE component
+*  void* eventParams: Not used.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ErrorEventHandler(uint32 event, void *eventParam)
+{
+    (void)eventParam;
 
-            break;
-        case CYBLE_EVT_GAP_AUTH_FAILED:
+    Telemetry_CountError((event == CYBLE_EVT_HARDWARE_ERROR) ?
+        TELEMETRY_ERR_HARDWARE : TELEMETRY_ERR_HCI);
+}
 
-            break;
+/*******************************************************************************
+* Function Name: ConnUpdateEventHandler
+********************************************************************************
+*
+* Summary:
+*  Handles CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE. An update that failed,
+*  with a non-zero HCI status, leaves the parameters unchanged and is not
+*  reported.
+*
+* Parameters:
+*  uint32 event:      Event from the CYBLE component
+*  void* eventParams: The new connection parameters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnUpdateEventHandler(uint32 event, void *eventParam)
+{
+    CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T *connParam;
 
-        case CYBLE_EVT_GAP_ENCRYPT_CHANGE:
-            break;
+    (void)event;
 
-        case CYBLE_EVT_GAPC_CONNECTION_UPDATE_COMPLETE:
-            break;
+    connParam = (CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T *)eventParam;
+    if(connParam->status == 0u)
+    {
+        FlashSched_SetConnInterval(connParam->connIntv);
+        ConnParam_Updated(connParam->connIntv, connParam->connLatency);
+    }
+}
 
-        /**********************************************************
-        *                       GATT Events
-        ***********************************************************/
-        case CYBLE_EVT_GATT_CONNECT_IND:
-            break;
+/*******************************************************************************
+* Function Name: ConnParamRspEventHandler
+********************************************************************************
+*
+* Summary:
+*  Handles CYBLE_EVT_L2CAP_CONN_PARAM_UPDATE_RSP.
+*
+* Parameters:
+*  uint32 event:      Event from the CYBLE component
+*  void* eventParams: The result of the request.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnParamRspEventHandler(uint32 event, void *eventParam)
+{
+    (void)event;
 
-        case CYBLE_EVT_GATT_DISCONNECT_IND:
-            break;
+    ConnParam_UpdateRsp(*(uint16 *)eventParam);
+}
 
-        case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
-            break;
+/*******************************************************************************
+* Function Name: StackEventsInit
+********************************************************************************
+*
+* Summary:
+*  Registers the application handlers of the BLE Component events. The
+*  other events are not required for functioning of this design and cost
+*  only a table lookup. CYBLE_EVT_PENDING_FLASH_WRITE needs no handler:
+*  the stack flags the data in cyBle_pendingFlashWrite and it is stored by
+*  FlashSched_Run() in the next idle window.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void StackEventsInit(void)
+{
+    uint8 result = BLEDISPATCH_OK;
+    uint8 i;
 
-        case CYBLE_EVT_GATTS_READ_CHAR_VAL_ACCESS_REQ:
-            break;
+    for(i = 0u; i < STACK_EVENT_COUNT; i++)
+    {
+        result |= BleDispatch_Register(&stackEventNodes[i], stackEvents[i].event, stackEvents[i].handler);
+    }
+    if(result != BLEDISPATCH_OK)
+    {
+        /* BLEDISPATCH_MAX_EVENTS is too small for the handlers of the design */
+        CYASSERT(0u != 0u);
+    }
+}
 
-        /**********************************************************
-        *                       Other Events
-        ***********************************************************/
-        case CYBLE_EVT_PENDING_FLASH_WRITE:
-            break;
 
-        default:
-            break;
-    }
+/*******************************************************************************
+* Function Name: BlinkTimerCallback
+********************************************************************************
+*
+* Summary:
+*  Called from the WDT interrupt when the blink timer expires.
+*
+* Parameters:
+*  SWTIMER *timer: The blink timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void BlinkTimerCallback(SWTIMER *timer)
+{
+    (void)timer;
+    
+    blinkDue = 1u;
 }
 
 
@@ -171,7 +326,13 @@ int main()
 
     CyGlobalIntEnable;
 
-    apiResult = CyBle_Start(StackEventHandler);
+    /* Register the BLE event handlers of the services and the application.
+     * The handlers of an event run in this order. */
+    Bulk_Init();
+    Telemetry_Init();
+    StackEventsInit();
+
+    apiResult = CyBle_Start(BleDispatch_Event);
 
     if(apiResult != CYBLE_ERROR_OK)
     {
@@ -181,78 +342,91 @@ int main()
 
     CyBle_IasRegisterAttrCallback(IasEventHandler);
 
+    /* Start the WDT timebase and the software timers. The LFCLK runs from
+     * the WCO, so the timebase needs no calibration. */
+    CySysTimebaseStart();
+    SwTimer_Init();
+
+    /* Account the time spent in each power mode */
+    CySysPmStatsStart();
+
+    /* Set up the guard of the Sleep at connection event close */
+    LowPower_Init();
+
+    /* Run SYSCLK at the idle level. The clock is raised while the BLE
+     * stack events are processed. */
+    CySysClkGovInit(SYSCLK_IDLE_DIV);
+
+    /* Build the index of the key-value store */
+    KvStore_Init();
+
     for(;;)
     {
-        static uint8 toggleTimeout = 0;
-        CYBLE_BLESS_STATE_T blessState;
-        uint8 intrStatus;
-
         /* Single API call to service all the BLE stack events. Must be
          * called at least once in a BLE connection interval */
+        (void)CySysClkGovSetLevel(CY_SYS_CLK_GOV_BURST);
         CyBle_ProcessEvents();
+
+        /* Program a pending flash row if the last connection event closed
+         * recently enough for the write to end before the next one */
+        (void)FlashSched_Run();
+        (void)CySysClkGovSetLevel(CY_SYS_CLK_GOV_IDLE);
+        
+        /* Servicing the BLE stack is the first work done after the wakeup */
+        CySysPmStatsWork();
         
+        /* Queue the next bulk data notifications */
+        Bulk_Process();
+
+        /* Send the telemetry batch when it is full or due */
+        Telemetry_Process();
+
+        /* Ask for a short connection interval while an alert is active
+         * and for a long one with slave latency otherwise */
+        ConnParam_Demand(CONNPARAM_DEMAND_ALERT, (alertLevel != NO_ALERT) ? 1u : 0u);
+        ConnParam_Process();
+
         /* Update Alert Level value on the blue LED */
         switch(alertLevel)
         {
             case NO_ALERT:
+            SwTimer_Stop(&blinkTimer);
             Alert_LED_Write(LED_OFF);
             break;
 
             case MILD_ALERT:
-            toggleTimeout++;
-            if(toggleTimeout == LED_TOGGLE_TIMEOUT)
+            if(SwTimer_IsActive(&blinkTimer) == 0u)
+            {
+                blinkDue = 0u;
+                SwTimer_Start(&blinkTimer, LED_BLINK_PERIOD_MS, LED_BLINK_PERIOD_MS, BlinkTimerCallback);
+            }
+            if(blinkDue != 0u)
             {
                 /* Toggle alert LED after timeout */
                 Alert_LED_Write(Alert_LED_Read() ^ 0x01);
-                toggleTimeout = 0;
+                blinkDue = 0u;
                 Laser_Write( ON );
                 LED_Write( ON );
-                CyDelay( 30000 );
+                SwTimer_Delay( 30000 );
                 Laser_Write( OFF );
                 LED_Write( OFF );
             }
             break;
 
             case HIGH_ALERT:
+            SwTimer_Stop(&blinkTimer);
             Alert_LED_Write(LED_ON);
                 Laser_Write( ON );
                 LED_Write( ON );
-                CyDelay( 900000 );
+                SwTimer_Delay( 900000 );
                 Laser_Write( OFF );
                 LED_Write( OFF );
             break;
         }
 
-        /* Configure BLESS in Deep-Sleep mode */
-        CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
-        
-        /* Prevent interrupts while entering system low power modes */
-        intrStatus = CyEnterCriticalSection();
-        
-        /* Get the current state of BLESS block */
-        blessState = CyBle_GetBleSsState();
-        
-        /* If BLESS is in Deep-Sleep mode or the XTAL oscillator is turning on, 
-         * then PSoC 4 BLE can enter Deep-Sleep mode (1.3uA current consumption) */
-        if(blessState == CYBLE_BLESS_STATE_ECO_ON || 
-            blessState == CYBLE_BLESS_STATE_DEEPSLEEP)
-        {
-            CySysPmDeepSleep();
-        }
-        else if(blessState != CYBLE_BLESS_STATE_EVENT_CLOSE)
-        {
-            /* If BLESS is active, then configure PSoC 4 BLE system in 
-             * Sleep mode (~1.6mA current consumption) */
-            CySysPmSleep();
-        }
-        else
-        {
-            /* Keep trying to enter either Sleep or Deep-Sleep mode */    
-        }
-        CyExitCriticalSection(intrStatus);
-        
-        /* BLE link layer timing interrupt will wake up the system from Sleep 
-         * and Deep-Sleep modes */
+        /* Enter the deepest low power mode that BLESS allows. The BLE
+         * link layer timing interrupt wakes the system up. */
+        LowPower_Enter();
     }
 }
 
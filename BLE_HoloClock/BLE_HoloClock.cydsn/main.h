@@ -43,6 +43,10 @@
 #define	ON						15
 #define	OFF						0
 
+/* SYSCLK prescaler used by the clock governor outside of the BLE event
+ * processing. HFCLK / 2 = 6 MHz. */
+#define SYSCLK_IDLE_DIV			CY_SYS_CLK_SYSCLK_DIV2
+
 /*****************************************************************************
 * Data Type Definition
 *****************************************************************************/
@@ -0,0 +1,745 @@
+/*******************************************************************************
+* File Name: swtimer.c
+*
+* Description:
+*  This file provides one-shot and periodic software timers on a
+*  hierarchical timer wheel driven by WDT counter 0. Starting and stopping a
+*  timer only links or unlinks it from a wheel slot, which is O(1). The
+*  wheel does not tick: WDT counter 0 runs free and its match is set to the
+*  next slot that holds a timer, so the device sleeps until then. The time
+*  is taken from the WDT timebase (CySysTimebaseGetTicks()), which must be
+*  started before SwTimer_Init().
+*
+*  EveeHappyAlarm.cydsn carries the same timer wheel. Each kit project is
+*  built and distributed on its own, so both keep their own copy in their
+*  own format; a change to the timer logic must be made in both.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include "swtimer.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Timer lists of the wheel slots and a bit per non-empty slot. */
+static SWTIMER *SwTimerSlot[SWTIMER_LEVELS][SWTIMER_SLOTS];
+static uint16 SwTimerOccupied[SWTIMER_LEVELS];
+
+/* Next wheel tick to be processed. */
+static uint32 SwTimerClock = 0u;
+
+
+/*******************************************************************************
+* Function Name: SwTimer_GetTime
+********************************************************************************
+*
+* Summary:
+*  Returns the current time in wheel ticks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Time in wheel ticks, wrapping after about 49 days.
+*
+*******************************************************************************/
+uint32 SwTimer_GetTime(void)
+{
+    return((uint32)(CySysTimebaseGetTicks() >> SWTIMER_TICK_SHIFT));
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_MsToTicks
+********************************************************************************
+*
+* Summary:
+*  Converts milliseconds to wheel ticks with the calibrated LFCLK frequency,
+*  rounding up.
+*
+* Parameters:
+*  uint32 ms: Time in milliseconds.
+*
+* Return:
+*  uint32: Time in wheel ticks.
+*
+*******************************************************************************/
+static uint32 SwTimer_MsToTicks(uint32 ms)
+{
+    uint64 lfclkTicks = CySysTimebaseUsToTicks((uint64)ms * 1000u);
+    
+    return((uint32)((lfclkTicks + ((1u << SWTIMER_TICK_SHIFT) - 1u)) >> SWTIMER_TICK_SHIFT));
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Link
+********************************************************************************
+*
+* Summary:
+*  Adds a timer to the wheel slot that matches its expiry time.
+*
+* Parameters:
+*  SWTIMER *timer: Timer to add.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_Link(SWTIMER *timer)
+{
+    uint32 delta = timer->expires - SwTimerClock;
+    uint32 position;
+    uint8 level = 0u;
+    
+    if((int32)delta < 0)
+    {
+        /* Already expired: run on the next processed tick. */
+        delta = 0u;
+    }
+    else if(delta > SWTIMER_MAX_DELTA)
+    {
+        /* Beyond the wheel: park at the end and re-insert from there. */
+        delta = SWTIMER_MAX_DELTA;
+    }
+    else
+    {
+    }
+    
+    while((level < (SWTIMER_LEVELS - 1u)) && 
+          ((delta >> ((level + 1u) * SWTIMER_SLOT_BITS)) != 0u))
+    {
+        level++;
+    }
+    
+    position = SwTimerClock + delta;
+    timer->level = level;
+    timer->slot = (uint8)((position >> (level * SWTIMER_SLOT_BITS)) & SWTIMER_SLOT_MASK);
+    
+    timer->prev = (void *)0;
+    timer->next = SwTimerSlot[level][timer->slot];
+    if(timer->next != (void *)0)
+    {
+        timer->next->prev = timer;
+    }
+    SwTimerSlot[level][timer->slot] = timer;
+    SwTimerOccupied[level] |= (uint16)(1u << timer->slot);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Unlink
+********************************************************************************
+*
+* Summary:
+*  Removes a timer from its wheel slot.
+*
+* Parameters:
+*  SWTIMER *timer: Timer to remove.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_Unlink(SWTIMER *timer)
+{
+    if(timer->prev != (void *)0)
+    {
+        timer->prev->next = timer->next;
+    }
+    else
+    {
+        SwTimerSlot[timer->level][timer->slot] = timer->next;
+        if(timer->next == (void *)0)
+        {
+            SwTimerOccupied[timer->level] &= (uint16)~(1u << timer->slot);
+        }
+    }
+    
+    if(timer->next != (void *)0)
+    {
+        timer->next->prev = timer->prev;
+    }
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_TakeSlot
+********************************************************************************
+*
+* Summary:
+*  Empties a wheel slot and returns its timer list.
+*
+* Parameters:
+*  uint8 level: Wheel level.
+*  uint8 slot: Slot in the level.
+*
+* Return:
+*  SWTIMER *: First timer of the list, or NULL.
+*
+*******************************************************************************/
+static SWTIMER *SwTimer_TakeSlot(uint8 level, uint8 slot)
+{
+    SWTIMER *list = SwTimerSlot[level][slot];
+    
+    SwTimerSlot[level][slot] = (void *)0;
+    SwTimerOccupied[level] &= (uint16)~(1u << slot);
+    
+    return(list);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Cascade
+********************************************************************************
+*
+* Summary:
+*  Moves the timers of a slot of a higher level to the lower levels, when
+*  the wheel clock enters the time range of that slot.
+*
+* Parameters:
+*  uint8 level: Wheel level, 1 or higher.
+*
+* Return:
+*  uint8: Index of the cascaded slot. The next level is cascaded as well when
+*        this is 0.
+*
+*******************************************************************************/
+static uint8 SwTimer_Cascade(uint8 level)
+{
+    uint8 slot = (uint8)((SwTimerClock >> (level * SWTIMER_SLOT_BITS)) & SWTIMER_SLOT_MASK);
+    SWTIMER *timer = SwTimer_TakeSlot(level, slot);
+    SWTIMER *next;
+    
+    while(timer != (void *)0)
+    {
+        next = timer->next;
+        SwTimer_Link(timer);
+        timer = next;
+    }
+    
+    return(slot);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_RunSlot
+********************************************************************************
+*
+* Summary:
+*  Runs the callbacks of the timers in the level 0 slot of the current wheel
+*  tick. Periodic timers are re-armed before their callback runs, so the
+*  callback may stop or restart them.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_RunSlot(void)
+{
+    SWTIMER *timer = SwTimer_TakeSlot(0u, (uint8)(SwTimerClock & SWTIMER_SLOT_MASK));
+    SWTIMER *next;
+    
+    while(timer != (void *)0)
+    {
+        next = timer->next;
+        
+        if((int32)(timer->expires - SwTimerClock) > 0)
+        {
+            /* Parked at the end of the wheel, not yet due. */
+            SwTimer_Link(timer);
+        }
+        else
+        {
+            if(timer->period != 0u)
+            {
+                timer->expires += timer->period;
+                if((int32)(timer->expires - SwTimerClock) <= 0)
+                {
+                    /* Missed periods are dropped instead of run in a burst. */
+                    timer->expires = SwTimerClock + timer->period;
+                }
+                SwTimer_Link(timer);
+            }
+            else
+            {
+                timer->active = 0u;
+            }
+            
+            timer->callback(timer);
+        }
+        timer = next;
+    }
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_NextEvent
+********************************************************************************
+*
+* Summary:
+*  Returns the number of wheel ticks from the wheel clock to the next slot
+*  that has to be run or cascaded. Empty slots are skipped with the
+*  occupancy bits, so the wheel never steps through idle ticks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Wheel ticks to the next event, SWTIMER_MAX_DELTA if there is none.
+*
+*******************************************************************************/
+static uint32 SwTimer_NextEvent(void)
+{
+    uint32 next = SWTIMER_MAX_DELTA;
+    uint32 block;
+    uint32 candidate;
+    uint8 level;
+    uint8 index;
+    uint8 distance;
+    uint8 first;
+    
+    for(level = 0u; level < SWTIMER_LEVELS; level++)
+    {
+        if(SwTimerOccupied[level] != 0u)
+        {
+            block = SwTimerClock >> (level * SWTIMER_SLOT_BITS);
+            index = (uint8)(block & SWTIMER_SLOT_MASK);
+            
+            /* The current slot is due now if the clock is at its start and
+             * it has not been processed yet. Otherwise the current slot of
+             * the higher levels was cascaded when the clock entered it, and
+             * it is cascaded next one full turn later. */
+            first = ((SwTimerClock & ((1uL << (level * SWTIMER_SLOT_BITS)) - 1u)) == 0u) ? 0u : 1u;
+            for(distance = first; distance < (SWTIMER_SLOTS + first); distance++)
+            {
+                if((SwTimerOccupied[level] & (uint16)(1u << ((index + distance) & SWTIMER_SLOT_MASK))) != 0u)
+                {
+                    break;
+                }
+            }
+            
+            if(distance < (SWTIMER_SLOTS + first))
+            {
+                candidate = ((block + distance) << (level * SWTIMER_SLOT_BITS)) - SwTimerClock;
+                if(candidate < next)
+                {
+                    next = candidate;
+                }
+            }
+        }
+    }
+    
+    return(next);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Schedule
+********************************************************************************
+*
+* Summary:
+*  Sets the WDT counter 0 match to the next wheel event.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_Schedule(void)
+{
+    uint32 now = (uint32)CySysTimebaseGetTicks();
+    uint32 wake = (SwTimerClock + SwTimer_NextEvent()) << SWTIMER_TICK_SHIFT;
+    uint32 sleepTicks = wake - now;
+    uint32 match;
+    
+    if(((int32)sleepTicks < (int32)SWTIMER_MIN_SLEEP_TICKS))
+    {
+        sleepTicks = SWTIMER_MIN_SLEEP_TICKS;
+    }
+    else if(sleepTicks > SWTIMER_MAX_SLEEP_TICKS)
+    {
+        sleepTicks = SWTIMER_MAX_SLEEP_TICKS;
+    }
+    else
+    {
+    }
+    
+    match = (CySysWdtGetCount(CY_SYS_WDT_COUNTER0) + sleepTicks) & CY_SYS_WDT_LOWER_16BITS_MASK;
+    if(match != CySysWdtGetMatch(CY_SYS_WDT_COUNTER0))
+    {
+        CySysWdtSetMatch(CY_SYS_WDT_COUNTER0, match);
+    }
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Process
+********************************************************************************
+*
+* Summary:
+*  WDT counter 0 interrupt callback. Advances the wheel clock to the current
+*  time, jumping directly from one non-empty slot to the next, runs the
+*  expired timers and sets the next match.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_Process(void)
+{
+    uint32 target = SwTimer_GetTime() + 1u;
+    uint32 step;
+    uint8 level;
+    
+    while((int32)(target - SwTimerClock) > 0)
+    {
+        /* Cascade the higher levels when the clock enters their slots. */
+        if((SwTimerClock & SWTIMER_SLOT_MASK) == 0u)
+        {
+            level = 1u;
+            while((SwTimer_Cascade(level) == 0u) && (level < (SWTIMER_LEVELS - 1u)))
+            {
+                level++;
+            }
+        }
+        
+        if((SwTimerOccupied[0u] & (uint16)(1u << (SwTimerClock & SWTIMER_SLOT_MASK))) != 0u)
+        {
+            SwTimer_RunSlot();
+        }
+        SwTimerClock++;
+        
+        /* Jump to the next non-empty slot. A slot boundary is never jumped
+         * from, as its cascade is not yet done. */
+        if((SwTimerClock & SWTIMER_SLOT_MASK) != 0u)
+        {
+            step = SwTimer_NextEvent();
+            if(step > (target - SwTimerClock))
+            {
+                step = target - SwTimerClock;
+            }
+            SwTimerClock += step;
+        }
+    }
+    
+    SwTimer_Schedule();
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Init
+********************************************************************************
+*
+* Summary:
+*  Sets up WDT counter 0 to run free with an interrupt on match, and 
+*  connects the wheel to the WDT interrupt.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SwTimer_Init(void)
+{
+    uint8 level;
+    uint8 slot;
+    
+    for(level = 0u; level < SWTIMER_LEVELS; level++)
+    {
+        for(slot = 0u; slot < SWTIMER_SLOTS; slot++)
+        {
+            SwTimerSlot[level][slot] = (void *)0;
+        }
+        SwTimerOccupied[level] = 0u;
+    }
+    SwTimerClock = SwTimer_GetTime();
+    
+    /* The mode and clear-on-match setting can only be changed while the 
+     * counter is disabled. */
+    CySysWdtDisable(CY_SYS_WDT_COUNTER0_MASK);
+    CySysWdtSetMode(CY_SYS_WDT_COUNTER0, CY_SYS_WDT_MODE_INT);
+    CySysWdtSetClearOnMatch(CY_SYS_WDT_COUNTER0, 0u);
+    CySysWdtSetMatch(CY_SYS_WDT_COUNTER0, SWTIMER_MAX_SLEEP_TICKS);
+    CySysWdtEnable(CY_SYS_WDT_COUNTER0_MASK);
+    
+    (void) CySysWdtSetInterruptCallback(CY_SYS_WDT_COUNTER0, SwTimer_Process);
+    CySysWdtEnableCounterIsr(CY_SYS_WDT_COUNTER0);
+    
+    (void) CyIntSetVector(CY_INT_WDT_IRQN, &CySysWdtIsr);
+    CyIntEnable(CY_INT_WDT_IRQN);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Start
+********************************************************************************
+*
+* Summary:
+*  Starts or restarts a timer. The callback runs in the WDT interrupt, so it
+*  must be short.
+*
+* Parameters:
+*  SWTIMER *timer: Timer to start.
+*  uint32 timeoutMs: Time to the first expiry in milliseconds.
+*  uint32 periodMs: Period in milliseconds, or 0 for a one-shot timer.
+*  SWTIMER_CALLBACK callback: Function called on every expiry.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SwTimer_Start(SWTIMER *timer, uint32 timeoutMs, uint32 periodMs, SWTIMER_CALLBACK callback)
+{
+    uint8 interruptState;
+    
+    interruptState = CyEnterCriticalSection();
+    
+    if(timer->active != 0u)
+    {
+        SwTimer_Unlink(timer);
+    }
+    
+    timer->expires = SwTimer_GetTime() + SwTimer_MsToTicks(timeoutMs);
+    timer->period = SwTimer_MsToTicks(periodMs);
+    if((periodMs != 0u) && (timer->period == 0u))
+    {
+        timer->period = 1u;
+    }
+    timer->callback = callback;
+    timer->active = 1u;
+    SwTimer_Link(timer);
+    
+    SwTimer_Schedule();
+    
+    CyExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Stop
+********************************************************************************
+*
+* Summary:
+*  Stops a timer. Has no effect if the timer is not running.
+*
+* Parameters:
+*  SWTIMER *timer: Timer to stop.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SwTimer_Stop(SWTIMER *timer)
+{
+    uint8 interruptState;
+    
+    interruptState = CyEnterCriticalSection();
+    
+    if(timer->active != 0u)
+    {
+        SwTimer_Unlink(timer);
+        timer->active = 0u;
+    }
+    
+    CyExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_IsActive
+********************************************************************************
+*
+* Summary:
+*  Returns whether a timer is running.
+*
+* Parameters:
+*  const SWTIMER *timer: Timer to check.
+*
+* Return:
+*  uint8: Nonzero if the timer is running.
+*
+*******************************************************************************/
+uint8 SwTimer_IsActive(const SWTIMER *timer)
+{
+    return(timer->active);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_GetIdleTime
+********************************************************************************
+*
+* Summary:
+*  Returns the time until the wheel has to run again, which is the time the
+*  device can stay in a low power mode without delaying a timer.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Time in wheel ticks, 0 if a timer is due.
+*
+*******************************************************************************/
+uint32 SwTimer_GetIdleTime(void)
+{
+    uint32 idle;
+    uint8 interruptState;
+    
+    interruptState = CyEnterCriticalSection();
+    
+    idle = (SwTimerClock + SwTimer_NextEvent()) - SwTimer_GetTime();
+    if((int32)idle < 0)
+    {
+        idle = 0u;
+    }
+    
+    CyExitCriticalSection(interruptState);
+    
+    return(idle);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_DelayCallback
+********************************************************************************
+*
+* Summary:
+*  Callback of the delay timer. The delay ends when the one-shot timer is 
+*  no longer active, so there is nothing to do.
+*
+* Parameters:
+*  SWTIMER *timer: The delay timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_DelayCallback(SWTIMER *timer)
+{
+    (void) timer;
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_DelayLowPower
+********************************************************************************
+*
+* Summary:
+*  Waits for the given time in a low power mode. A one-shot timer is started
+*  and the device sleeps until it expires. Other interrupts wake the device
+*  as usual and are serviced during the delay.
+*
+* Parameters:
+*  uint32 milliseconds: Time to wait.
+*  uint8 deepSleep: Nonzero to wait in Deep-Sleep instead of Sleep.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SwTimer_DelayLowPower(uint32 milliseconds, uint8 deepSleep)
+{
+    SWTIMER delayTimer;
+    uint8 interruptState;
+    
+    if(milliseconds != 0u)
+    {
+        /* The wheel clock may be just before its next tick, so one more 
+         * millisecond makes sure that at least the requested time passes. */
+        delayTimer.active = 0u;
+        SwTimer_Start(&delayTimer, milliseconds + 1u, 0u, SwTimer_DelayCallback);
+        
+        while(SwTimer_IsActive(&delayTimer) != 0u)
+        {
+            /* The timer is checked again with the interrupts disabled, so 
+             * that an expiry just before the WFI does not delay the wake-up
+             * to the next timer. The WFI still wakes on the pending 
+             * interrupt, which is serviced once the interrupts are enabled. */
+            interruptState = CyEnterCriticalSection();
+            if(SwTimer_IsActive(&delayTimer) != 0u)
+            {
+                if(deepSleep != 0u)
+                {
+                    CySysPmDeepSleep();
+                }
+                else
+                {
+                    CySysPmSleep();
+                }
+            }
+            CyExitCriticalSection(interruptState);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_Delay
+********************************************************************************
+*
+* Summary:
+*  Replacement for CyDelay() that waits in Sleep mode instead of running the
+*  CPU. The delay is at most about 1 ms longer than requested. Must not be 
+*  called from an interrupt or with the interrupts disabled, as the WDT 
+*  interrupt ends the delay.
+*
+* Parameters:
+*  uint32 milliseconds: Time to wait.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SwTimer_Delay(uint32 milliseconds)
+{
+    SwTimer_DelayLowPower(milliseconds, 0u);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_DelayDeepSleep
+********************************************************************************
+*
+* Summary:
+*  Same as SwTimer_Delay(), but waits in Deep-Sleep mode. The caller must 
+*  prepare the Components that do not run in Deep-Sleep before the call.
+*
+* Parameters:
+*  uint32 milliseconds: Time to wait.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SwTimer_DelayDeepSleep(uint32 milliseconds)
+{
+    SwTimer_DelayLowPower(milliseconds, 1u);
+}
+
+/*******************************************************************************
+* Function Name: SwTimer_DelayUs
+********************************************************************************
+*
+* Summary:
+*  Replacement for CyDelayUs(). Delays shorter than 1 ms are too short to 
+*  sleep and are busy-waited with CyDelayUs(). Longer delays are rounded up
+*  to milliseconds and passed to SwTimer_Delay().
+*
+* Parameters:
+*  uint32 microseconds: Time to wait.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SwTimer_DelayUs(uint32 microseconds)
+{
+    if(microseconds < SWTIMER_MIN_DELAY_US)
+    {
+        CyDelayUs((uint16)microseconds);
+    }
+    else
+    {
+        SwTimer_Delay((microseconds + (SWTIMER_MIN_DELAY_US - 1u)) / SWTIMER_MIN_DELAY_US);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name: swtimer.h
+*
+* Description:
+*  Contains the software timer API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(SWTIMER_H)
+#define SWTIMER_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* One wheel tick is 2^SWTIMER_TICK_SHIFT LFCLK ticks, about 1 ms. */
+#define SWTIMER_TICK_SHIFT          5u
+
+/* The wheel has SWTIMER_LEVELS levels of SWTIMER_SLOTS slots. Level n holds
+ * the timers that expire within 16^(n + 1) wheel ticks, so timeouts up to
+ * about 65 s are placed directly. Longer timeouts are re-inserted when they
+ * reach the end of the wheel. */
+#define SWTIMER_LEVELS              4u
+#define SWTIMER_SLOT_BITS           4u
+#define SWTIMER_SLOTS               (1u << SWTIMER_SLOT_BITS)
+#define SWTIMER_SLOT_MASK           (SWTIMER_SLOTS - 1u)
+#define SWTIMER_MAX_DELTA           ((1uL << (SWTIMER_LEVELS * SWTIMER_SLOT_BITS)) - 1u)
+
+/* Limits of the WDT counter 0 match distance in LFCLK ticks. The match is
+ * never set closer than a few LFCLK cycles, as it takes that long to take
+ * effect, and never further than the 16-bit counter can reach. */
+#define SWTIMER_MIN_SLEEP_TICKS     4u
+#define SWTIMER_MAX_SLEEP_TICKS     0xFF00u
+
+/* Shortest delay in microseconds that is slept instead of busy-waited. */
+#define SWTIMER_MIN_DELAY_US        1000u
+
+/***************************************
+*        Data Structure Definition
+***************************************/
+struct SWTIMER_s;
+
+/* Called from the WDT interrupt when the timer expires. */
+typedef void (*SWTIMER_CALLBACK)(struct SWTIMER_s *timer);
+
+/* A software timer. The structure is owned by the caller and linked into
+ * the wheel while the timer runs, so it must stay allocated until it is
+ * stopped. */
+typedef struct SWTIMER_s
+{
+    struct SWTIMER_s *next;
+    struct SWTIMER_s *prev;
+    uint32 expires;             /* Expiry time in wheel ticks             */
+    uint32 period;              /* Period in wheel ticks, 0 for one-shot  */
+    SWTIMER_CALLBACK callback;
+    uint8 level;                /* Wheel position while active            */
+    uint8 slot;
+    uint8 active;
+} SWTIMER;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void SwTimer_Init(void);
+void SwTimer_Start(SWTIMER *timer, uint32 timeoutMs, uint32 periodMs, SWTIMER_CALLBACK callback);
+void SwTimer_Stop(SWTIMER *timer);
+uint8 SwTimer_IsActive(const SWTIMER *timer);
+uint32 SwTimer_GetTime(void);
+uint32 SwTimer_GetIdleTime(void);
+void SwTimer_Delay(uint32 milliseconds);
+void SwTimer_DelayDeepSleep(uint32 milliseconds);
+void SwTimer_DelayUs(uint32 microseconds);
+
+#endif /* SWTIMER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,511 @@
+/*******************************************************************************
+* File Name: telemetry.c
+*
+* Description:
+*  This file reports the device telemetry through the Telemetry
+*  characteristic. Alert Level changes, power mode residency, low power
+*  branch counters and error counters are packed as records in a batch,
+*  and the batch goes out in a single notification once it is full or
+*  TELEMETRY_LATENCY_MS after its first record. The residency and the
+*  counters are state, so a newer snapshot replaces the one still waiting
+*  in the batch. A batch is only handed to the stack while it has a free
+*  buffer, so a notification never fails for lack of memory and the batch
+*  is kept until it is sent.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <project.h>
+#include <string.h>
+#include "telemetry.h"
+#include "swtimer.h"
+#include "flashsched.h"
+#include "connparam.h"
+#include "lowpower.h"
+#include "bledispatch.h"
+#include "cccd.h"
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Records waiting to be sent */
+static uint8 TelemetryBatch[CYBLE_TELEMETRY_DATA_LEN];
+static uint32 TelemetryLength = 0u;
+
+/* Set while the client has the notifications enabled */
+static uint8 TelemetryEnabled = 0u;
+
+/* Set when the send of the current batch has been deferred */
+static uint8 TelemetryStalled = 0u;
+
+static uint32 TelemetryErrors[TELEMETRY_ERR_COUNT];
+
+/* The timer callbacks only flag the work, which is done in
+ * Telemetry_Process(). */
+static SWTIMER latencyTimer;
+static SWTIMER snapshotTimer;
+static volatile uint8 flushDue = 0u;
+static volatile uint8 snapshotDue = 0u;
+
+static BLEDISPATCH_NODE telemetryWriteReqNode;
+static BLEDISPATCH_NODE telemetryDisconnectedNode;
+
+
+/*******************************************************************************
+* Function Name: LatencyTimerCallback
+********************************************************************************
+*
+* Summary:
+*  Called from the WDT interrupt when the oldest record of the batch has
+*  waited TELEMETRY_LATENCY_MS.
+*
+* Parameters:
+*  SWTIMER *timer: The latency timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LatencyTimerCallback(SWTIMER *timer)
+{
+    (void)timer;
+
+    flushDue = 1u;
+}
+
+/*******************************************************************************
+* Function Name: SnapshotTimerCallback
+********************************************************************************
+*
+* Summary:
+*  Called from the WDT interrupt every TELEMETRY_SNAPSHOT_MS.
+*
+* Parameters:
+*  SWTIMER *timer: The snapshot timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SnapshotTimerCallback(SWTIMER *timer)
+{
+    (void)timer;
+
+    snapshotDue = 1u;
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Put16
+********************************************************************************
+*
+* Summary:
+*  Stores a counter in 2 bytes, little-endian. Larger values saturate.
+*
+* Parameters:
+*  uint8 dst[]: Destination.
+*  uint32 value: Counter value.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_Put16(uint8 dst[], uint32 value)
+{
+    if(value > 0xFFFFu)
+    {
+        value = 0xFFFFu;
+    }
+    dst[0u] = (uint8)value;
+    dst[1u] = (uint8)(value >> 8u);
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Put32
+********************************************************************************
+*
+* Summary:
+*  Stores a value in 4 bytes, little-endian.
+*
+* Parameters:
+*  uint8 dst[]: Destination.
+*  uint32 value: Value.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_Put32(uint8 dst[], uint32 value)
+{
+    dst[0u] = (uint8)value;
+    dst[1u] = (uint8)(value >> 8u);
+    dst[2u] = (uint8)(value >> 16u);
+    dst[3u] = (uint8)(value >> 24u);
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Append
+********************************************************************************
+*
+* Summary:
+*  Adds a record to the batch and starts the latency timer with the first
+*  record. If replace is set and the batch holds a record of the same
+*  type, the payload of that record is overwritten instead.
+*
+* Parameters:
+*  uint8 type: Record type.
+*  const uint8 payload[]: Record payload.
+*  uint8 length: Payload length.
+*  uint8 replace: 1 to replace a record of the same type.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_Append(uint8 type, const uint8 payload[], uint8 length, uint8 replace)
+{
+    uint32 offset = 0u;
+    uint8 found = 0u;
+
+    if(replace != 0u)
+    {
+        while((offset < TelemetryLength) && (found == 0u))
+        {
+            if(TelemetryBatch[offset] == type)
+            {
+                (void)memcpy(&TelemetryBatch[offset + TELEMETRY_RECORD_HEADER], payload, length);
+                found = 1u;
+            }
+            else
+            {
+                offset += TELEMETRY_RECORD_HEADER + TelemetryBatch[offset + 1u];
+            }
+        }
+    }
+
+    if(found == 0u)
+    {
+        if((TelemetryLength + TELEMETRY_RECORD_HEADER + length) > sizeof(TelemetryBatch))
+        {
+            /* The stack has been busy for the whole batch */
+            TelemetryErrors[TELEMETRY_ERR_DROPPED]++;
+        }
+        else
+        {
+            if(TelemetryLength == 0u)
+            {
+                flushDue = 0u;
+                SwTimer_Start(&latencyTimer, TELEMETRY_LATENCY_MS, 0u, LatencyTimerCallback);
+            }
+
+            TelemetryBatch[TelemetryLength] = type;
+            TelemetryBatch[TelemetryLength + 1u] = length;
+            (void)memcpy(&TelemetryBatch[TelemetryLength + TELEMETRY_RECORD_HEADER], payload, length);
+            TelemetryLength += TELEMETRY_RECORD_HEADER + length;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Snapshot
+********************************************************************************
+*
+* Summary:
+*  Adds the power mode residency, the low power branch counters and the
+*  error counters to the batch.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_Snapshot(void)
+{
+    const CY_PM_STATS_STRUCT *pmStats;
+    CONNPARAM_STATS connStats;
+    LOWPOWER_STATS lpStats;
+    uint8 payload[TELEMETRY_POWER_LEN];
+    uint32 i;
+
+    pmStats = CySysPmStatsGet();
+    Telemetry_Put32(&payload[0u], (uint32)pmStats->residency[CY_PM_STATS_ACTIVE]);
+    Telemetry_Put32(&payload[4u], (uint32)pmStats->residency[CY_PM_STATS_SLEEP]);
+    Telemetry_Put32(&payload[8u], (uint32)pmStats->residency[CY_PM_STATS_DEEPSLEEP]);
+    Telemetry_Put32(&payload[12u], pmStats->wakeLatencyMax);
+    Telemetry_Append(TELEMETRY_REC_POWER, payload, TELEMETRY_POWER_LEN, 1u);
+
+    LowPower_GetStats(&lpStats);
+    Telemetry_Put32(&payload[0u], lpStats.deepSleep);
+    Telemetry_Put32(&payload[4u], lpStats.sleep);
+    Telemetry_Put32(&payload[8u], lpStats.eventClose);
+    Telemetry_Put32(&payload[12u], lpStats.guardExpired);
+    Telemetry_Append(TELEMETRY_REC_LOWPOWER, payload, TELEMETRY_LOWPOWER_LEN, 1u);
+
+    ConnParam_GetStats(&connStats);
+    TelemetryErrors[TELEMETRY_ERR_CONN_PARAM] = connStats.rejected;
+    TelemetryErrors[TELEMETRY_ERR_FLASH] = FlashSched_GetDeferred();
+
+    for(i = 0u; i < TELEMETRY_ERR_COUNT; i++)
+    {
+        Telemetry_Put16(&payload[i * 2u], TelemetryErrors[i]);
+    }
+    Telemetry_Append(TELEMETRY_REC_ERRORS, payload, TELEMETRY_ERRORS_LEN, 1u);
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Flush
+********************************************************************************
+*
+* Summary:
+*  Sends the whole records that fit in one notification, if the stack has
+*  a free buffer. The records that do not fit are sent on the next pass.
+*
+* Parameters:
+*  uint32 limit: Largest notification payload.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_Flush(uint32 limit)
+{
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T ntf;
+    uint32 length = 0u;
+
+    while((length < TelemetryLength) &&
+          ((length + TELEMETRY_RECORD_HEADER + TelemetryBatch[length + 1u]) <= limit))
+    {
+        length += TELEMETRY_RECORD_HEADER + TelemetryBatch[length + 1u];
+    }
+
+    ntf.attrHandle = CYBLE_TELEMETRY_CHAR_HANDLE;
+    ntf.value.val = TelemetryBatch;
+    ntf.value.len = (uint16)length;
+
+    if((CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE) &&
+       (CyBle_GattsNotification(cyBle_connHandle, &ntf) == CYBLE_ERROR_OK))
+    {
+        TelemetryLength -= length;
+        (void)memmove(TelemetryBatch, &TelemetryBatch[length], TelemetryLength);
+        TelemetryStalled = 0u;
+
+        if(TelemetryLength == 0u)
+        {
+            SwTimer_Stop(&latencyTimer);
+            flushDue = 0u;
+        }
+        else
+        {
+            /* The rest goes out on the next pass */
+            flushDue = 1u;
+        }
+    }
+    else if(TelemetryStalled == 0u)
+    {
+        /* Retried when the stack reports free buffers */
+        TelemetryErrors[TELEMETRY_ERR_STALLED]++;
+        TelemetryStalled = 1u;
+    }
+    else
+    {
+        /* Already counted for this batch */
+    }
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_WriteReq
+********************************************************************************
+*
+* Summary:
+*  Handles the writes to the Client Characteristic Configuration descriptor
+*  of the Telemetry characteristic.
+*
+* Parameters:
+*  uint32 event:      CYBLE_EVT_GATTS_WRITE_REQ.
+*  void* eventParams: A structure instance of CYBLE_GATTS_WRITE_REQ_PARAM_T
+*                     type.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_WriteReq(uint32 event, void *eventParam)
+{
+    (void)event;
+
+    Cccd_WriteReq((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam, CYBLE_TELEMETRY_CCCD_HANDLE);
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Disconnected
+********************************************************************************
+*
+* Summary:
+*  Clears the client configuration, which does not outlive the connection.
+*
+* Parameters:
+*  uint32 event:      CYBLE_EVT_GAP_DEVICE_DISCONNECTED.
+*  void* eventParams: Not used.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Telemetry_Disconnected(uint32 event, void *eventParam)
+{
+    (void)event;
+    (void)eventParam;
+
+    Cccd_Clear(CYBLE_TELEMETRY_CCCD_HANDLE);
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Init
+********************************************************************************
+*
+* Summary:
+*  Registers the BLE event handlers of the Telemetry service. Called
+*  before CyBle_Start().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Telemetry_Init(void)
+{
+    uint8 result;
+
+    result = BleDispatch_Register(&telemetryWriteReqNode, CYBLE_EVT_GATTS_WRITE_REQ, Telemetry_WriteReq);
+    result |= BleDispatch_Register(&telemetryDisconnectedNode, CYBLE_EVT_GAP_DEVICE_DISCONNECTED, Telemetry_Disconnected);
+    if(result != BLEDISPATCH_OK)
+    {
+        /* BLEDISPATCH_MAX_EVENTS is too small for the handlers of the design */
+        CYASSERT(0u != 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Alert
+********************************************************************************
+*
+* Summary:
+*  Reports a change of the Alert Level.
+*
+* Parameters:
+*  uint8 level: New Alert Level.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Telemetry_Alert(uint8 level)
+{
+    uint8 payload[TELEMETRY_ALERT_LEN];
+
+    if(TelemetryEnabled != 0u)
+    {
+        payload[0u] = level;
+        Telemetry_Put32(&payload[1u], SwTimer_GetTime());
+        Telemetry_Append(TELEMETRY_REC_ALERT, payload, TELEMETRY_ALERT_LEN, 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_CountError
+********************************************************************************
+*
+* Summary:
+*  Counts an error. The counters are reported with the next snapshot.
+*
+* Parameters:
+*  uint8 error: TELEMETRY_ERR_HARDWARE or TELEMETRY_ERR_HCI.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Telemetry_CountError(uint8 error)
+{
+    if(error < TELEMETRY_ERR_COUNT)
+    {
+        TelemetryErrors[error]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_Process
+********************************************************************************
+*
+* Summary:
+*  Takes the periodic snapshots and sends the batch when it is due. Called
+*  from the main loop after CyBle_ProcessEvents().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Telemetry_Process(void)
+{
+    uint16 mtu = CYBLE_GATT_DEFAULT_MTU;
+    uint32 limit;
+
+    if((CyBle_GetState() != CYBLE_STATE_CONNECTED) ||
+       (!CYBLE_IS_NOTIFICATION_ENABLED(CYBLE_TELEMETRY_CCCD_HANDLE)))
+    {
+        if(TelemetryEnabled != 0u)
+        {
+            /* Nobody listens: drop the batch and stop the timers */
+            SwTimer_Stop(&latencyTimer);
+            SwTimer_Stop(&snapshotTimer);
+            TelemetryLength = 0u;
+            TelemetryStalled = 0u;
+            TelemetryEnabled = 0u;
+        }
+    }
+    else
+    {
+        if(TelemetryEnabled == 0u)
+        {
+            /* Report the current state right away */
+            TelemetryEnabled = 1u;
+            snapshotDue = 1u;
+            SwTimer_Start(&snapshotTimer, TELEMETRY_SNAPSHOT_MS, TELEMETRY_SNAPSHOT_MS, SnapshotTimerCallback);
+        }
+
+        if(snapshotDue != 0u)
+        {
+            snapshotDue = 0u;
+            Telemetry_Snapshot();
+        }
+
+        if(TelemetryLength != 0u)
+        {
+            (void)CyBle_GattGetMtuSize(&mtu);
+            limit = (uint32)mtu - TELEMETRY_NTF_HEADER_SIZE;
+            if(limit > sizeof(TelemetryBatch))
+            {
+                limit = sizeof(TelemetryBatch);
+            }
+
+            /* Send early once the next record, at most a power record,
+             * might not fit in the notification */
+            if((flushDue != 0u) ||
+               ((TelemetryLength + TELEMETRY_RECORD_HEADER + TELEMETRY_POWER_LEN) > limit))
+            {
+                Telemetry_Flush(limit);
+            }
+        }
+    }
+}
+
+/* [] END OF FILE */
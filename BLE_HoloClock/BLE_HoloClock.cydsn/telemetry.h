@@ -0,0 +1,77 @@
+/*******************************************************************************
+* File Name: telemetry.h
+*
+* Description:
+*  Contains the telemetry service API and constants.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(TELEMETRY_H)
+#define TELEMETRY_H
+
+#include "cytypes.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* A batch is sent this long after its first record, so that the records
+ * raised close together share one notification. */
+#define TELEMETRY_LATENCY_MS        1000u
+
+/* Period of the power mode and error counter snapshots. */
+#define TELEMETRY_SNAPSHOT_MS       10000u
+
+/* Size of the ATT Handle Value Notification header. */
+#define TELEMETRY_NTF_HEADER_SIZE   3u
+
+/* Record layout: type, payload length and the payload. Multi-byte fields
+ * are little-endian. */
+#define TELEMETRY_RECORD_HEADER     2u
+
+/* Alert Level change: level (1), wheel time in ~1 ms ticks (4). Every
+ * change is kept. */
+#define TELEMETRY_REC_ALERT         0x01u
+#define TELEMETRY_ALERT_LEN         5u
+
+/* Power mode residency: total Active, Sleep and Deep-Sleep time in LFCLK
+ * ticks, low 32 bits (4 each), longest wake latency in LFCLK ticks (4).
+ * A newer snapshot replaces the one waiting in the batch. */
+#define TELEMETRY_REC_POWER         0x02u
+#define TELEMETRY_POWER_LEN         16u
+
+/* Error counters: TELEMETRY_ERR_COUNT counters of 2 bytes each, which
+ * saturate at 0xFFFF. A newer snapshot replaces the one waiting in the
+ * batch. */
+#define TELEMETRY_REC_ERRORS        0x03u
+
+/* Low power branches: number of Deep-Sleep, Sleep and connection event
+ * close waits, and of the waits ended by the SysTick guard, low 32 bits (4
+ * each). A newer snapshot replaces the one waiting in the batch. */
+#define TELEMETRY_REC_LOWPOWER      0x04u
+#define TELEMETRY_LOWPOWER_LEN      16u
+
+/* Error counters, in the order of the record */
+#define TELEMETRY_ERR_HARDWARE      0u  /* CYBLE_EVT_HARDWARE_ERROR            */
+#define TELEMETRY_ERR_HCI           1u  /* CYBLE_EVT_HCI_STATUS                */
+#define TELEMETRY_ERR_CONN_PARAM    2u  /* Connection updates rejected         */
+#define TELEMETRY_ERR_FLASH         3u  /* Flash writes deferred               */
+#define TELEMETRY_ERR_DROPPED       4u  /* Records dropped on a full batch     */
+#define TELEMETRY_ERR_STALLED       5u  /* Sends deferred on a busy stack      */
+#define TELEMETRY_ERR_COUNT         6u
+#define TELEMETRY_ERRORS_LEN        (TELEMETRY_ERR_COUNT * 2u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void Telemetry_Init(void);
+void Telemetry_Alert(uint8 level);
+void Telemetry_CountError(uint8 error);
+void Telemetry_Process(void);
+
+#endif /* TELEMETRY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/*******************************************************************************
+* File Name: ble_sizing.c
+*
+* Description:
+*  Host evaluation of the stack RAM sizing macros of BLE.h. The generated
+*  BLE.h and stack headers are built against the stand-ins in stub/, with
+*  CYBLE_GATT_MTU_CONFIG and CYBLE_GATT_NTF_BUF_COUNT taken from the
+*  command line, so the RAM cost of another MTU or notification buffer
+*  count is known before the customizer settings are changed:
+*
+*      make sizing SIZING_MTU=247 SIZING_NTF_BUF=4
+*
+*  Prints the terms of CYBLE_STACK_RAM_SIZE in the order of
+*  cyBle_stackRamReport, and fails if the terms do not add up to it or the
+*  MTU is out of range.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <stdio.h>
+#include "BLE.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Largest link layer data payload of a Bluetooth 4.1 controller. */
+#define SIZING_LL_PAYLOAD           27u
+
+
+/*******************************************************************************
+* Function Name: Sizing_Print
+********************************************************************************
+*
+* Summary:
+*  Prints one term of the stack RAM size.
+*
+* Parameters:
+*  const char *name: Term.
+*  uint32 bytes: Size of the term.
+*  uint32 count: Number of buffers in the term, 0 for a single block.
+*
+* Return:
+*  uint32: bytes.
+*
+*******************************************************************************/
+static uint32 Sizing_Print(const char *name, uint32 bytes, uint32 count)
+{
+    if(count != 0u)
+    {
+        printf("  %-28s %5lu bytes  (%lu x %lu)\n", name, (unsigned long)bytes,
+               (unsigned long)count, (unsigned long)(bytes / count));
+    }
+    else
+    {
+        printf("  %-28s %5lu bytes\n", name, (unsigned long)bytes);
+    }
+    return(bytes);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Prints the stack RAM size of the configuration and checks it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if the configuration is consistent, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32 sum = 0u;
+    uint32 packets;
+    int result = 0;
+
+    packets = ((uint32)CYBLE_GATT_MTU + CYBLE_L2CAP_HDR_SZ + SIZING_LL_PAYLOAD - 1u) / SIZING_LL_PAYLOAD;
+
+    printf("CYBLE_GATT_MTU %lu, CYBLE_GATT_NTF_BUF_COUNT %lu\n",
+           (unsigned long)CYBLE_GATT_MTU, (unsigned long)CYBLE_GATT_NTF_BUF_COUNT);
+    printf("  full-MTU notification: %lu link layer packets, %lu bytes unused in the last\n",
+           (unsigned long)packets,
+           (unsigned long)((packets * SIZING_LL_PAYLOAD) - (CYBLE_GATT_MTU + CYBLE_L2CAP_HDR_SZ)));
+
+    sum += Sizing_Print("stack data", CYBLE_DEFAULT_RAM_SIZE_SOC, 0u);
+    sum += Sizing_Print("ATT MTU buffers",
+                        CYBLE_GATT_MTU_PLUS_L2CAP_MEM_EXT * CYBLE_GATT_MTU_BUF_COUNT,
+                        CYBLE_GATT_MTU_BUF_COUNT);
+    sum += Sizing_Print("longest attribute", CYBLE_GATT_MAX_ATTR_LEN_PLUS_L2CAP_MEM_EXT, 0u);
+    sum += Sizing_Print("L2CAP PSM", CYBLE_L2CAP_PSM_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_PSM_COUNT,
+                        CYBLE_L2CAP_PSM_COUNT);
+    sum += Sizing_Print("L2CAP channels",
+                        (CYBLE_L2CAP_CBFC_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT) +
+                        (CYBLE_L2CAP_MTU_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT) +
+                        (CYBLE_L2CAP_MPS_PLUS_L2CAP_MEM_EXT * CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT *
+                        (CYBLE_L2CAP_MTU / CYBLE_L2CAP_MPS)),
+                        CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT);
+    sum += Sizing_Print("buffer manager", CYBLE_STACK_BUFFER_MGR_UTIL_RAM_SZ * CYBLE_STACK_BUF_COUNT,
+                        CYBLE_STACK_BUF_COUNT);
+    printf("  %-28s %5lu bytes\n", "CYBLE_STACK_RAM_SIZE", (unsigned long)CYBLE_STACK_RAM_SIZE);
+
+    if(CYBLE_ALIGN_TO_4(sum) != CYBLE_STACK_RAM_SIZE)
+    {
+        printf("the terms add up to %lu bytes\n", (unsigned long)CYBLE_ALIGN_TO_4(sum));
+        result = 1;
+    }
+    if((CYBLE_GATT_MTU < CYBLE_GATT_DEFAULT_MTU) || (CYBLE_GATT_MTU > CYBLE_GATT_MAX_MTU))
+    {
+        printf("CYBLE_GATT_MTU must be from %u to %u\n", CYBLE_GATT_DEFAULT_MTU, CYBLE_GATT_MAX_MTU);
+        result = 1;
+    }
+    return(result);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,176 @@
+/*******************************************************************************
+* File Name: flashsim.c
+*
+* Description:
+*  This file simulates the flash programming of the device for the host
+*  tests. The flash is host memory: a flash address is a host address and
+*  CySysFlashWriteRow() programs the 128-byte row at rowNum * 128. The tests
+*  are linked at fixed low addresses, so the flash arrays of the modules
+*  are reachable through the 32-bit addresses the modules compute.
+*
+*  A power loss can be injected at a chosen row program. The row is then
+*  left erased and the program fails; the test restarts the module under
+*  test as the device would after the reset. FlashSim_EraseAll() erases the
+*  rows programmed so far, so that each test can start from a blank device.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <string.h>
+#include "CyFlash.h"
+#include "flashsim.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+/* Number of distinct rows FlashSim_EraseAll() can track. */
+#define FLASHSIM_MAX_ROWS           64u
+
+/***************************************
+*        Local Variables
+***************************************/
+static uint32 FlashSimPrograms = 0u;
+static uint32 FlashSimPowerLossAt = 0u;
+
+static uint32 FlashSimRows[FLASHSIM_MAX_ROWS];
+static uint32 FlashSimRowCount = 0u;
+
+
+/*******************************************************************************
+* Function Name: FlashSim_ClearStats
+********************************************************************************
+*
+* Summary:
+*  Clears the count of programmed rows.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void FlashSim_ClearStats(void)
+{
+    FlashSimPrograms = 0u;
+}
+
+/*******************************************************************************
+* Function Name: FlashSim_GetRowsProgrammed
+********************************************************************************
+*
+* Summary:
+*  Returns the number of rows programmed since FlashSim_ClearStats(),
+*  including the one interrupted by a power loss.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Number of row programs.
+*
+*******************************************************************************/
+uint32 FlashSim_GetRowsProgrammed(void)
+{
+    return(FlashSimPrograms);
+}
+
+/*******************************************************************************
+* Function Name: FlashSim_SetPowerLossAt
+********************************************************************************
+*
+* Summary:
+*  Injects a power loss during a row program.
+*
+* Parameters:
+*  uint32 program: Row program, counted from 1 after the next
+*                  FlashSim_ClearStats(), that loses power. 0 disables the
+*                  injection.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void FlashSim_SetPowerLossAt(uint32 program)
+{
+    FlashSimPowerLossAt = program;
+}
+
+/*******************************************************************************
+* Function Name: FlashSim_EraseAll
+********************************************************************************
+*
+* Summary:
+*  Erases every row programmed so far.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void FlashSim_EraseAll(void)
+{
+    uint32 index;
+
+    for(index = 0u; index < FlashSimRowCount; index++)
+    {
+        memset((uint8 *)(uintptr_t)(CY_FLASH_BASE + (FlashSimRows[index] * CY_FLASH_SIZEOF_ROW)), 0,
+               CY_FLASH_SIZEOF_ROW);
+    }
+    FlashSimRowCount = 0u;
+}
+
+/*******************************************************************************
+* Function Name: CySysFlashWriteRow
+********************************************************************************
+*
+* Summary:
+*  Erases and programs a flash row.
+*
+* Parameters:
+*  uint32 rowNum: Row number.
+*  const uint8 rowData[]: CY_FLASH_SIZEOF_ROW bytes to program.
+*
+* Return:
+*  uint32: CY_SYS_FLASH_SUCCESS, or CY_SYS_FLASH_PROTECTED when the program
+*          lost power.
+*
+*******************************************************************************/
+uint32 CySysFlashWriteRow(uint32 rowNum, const uint8 rowData[])
+{
+    uint8 *row = (uint8 *)(uintptr_t)(CY_FLASH_BASE + (rowNum * CY_FLASH_SIZEOF_ROW));
+    uint32 result = CY_SYS_FLASH_SUCCESS;
+    uint32 index;
+
+    index = 0u;
+    while((index < FlashSimRowCount) && (FlashSimRows[index] != rowNum))
+    {
+        index++;
+    }
+    if((index == FlashSimRowCount) && (FlashSimRowCount < FLASHSIM_MAX_ROWS))
+    {
+        FlashSimRows[FlashSimRowCount] = rowNum;
+        FlashSimRowCount++;
+    }
+
+    FlashSimPrograms++;
+
+    if(FlashSimPrograms == FlashSimPowerLossAt)
+    {
+        memset(row, 0, CY_FLASH_SIZEOF_ROW);
+        result = CY_SYS_FLASH_PROTECTED;
+    }
+    else
+    {
+        memcpy(row, rowData, CY_FLASH_SIZEOF_ROW);
+    }
+
+    return(result);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,28 @@
+/*******************************************************************************
+* File Name: flashsim.h
+*
+* Description:
+*  Contains the API of the simulated flash used by the host tests.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(FLASHSIM_H)
+#define FLASHSIM_H
+
+#include "cytypes.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void FlashSim_ClearStats(void);
+uint32 FlashSim_GetRowsProgrammed(void);
+void FlashSim_SetPowerLossAt(uint32 program);
+void FlashSim_EraseAll(void);
+
+#endif /* FLASHSIM_H */
+
+/* [] END OF FILE */
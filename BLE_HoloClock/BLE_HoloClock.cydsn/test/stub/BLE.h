@@ -0,0 +1,138 @@
+/*******************************************************************************
+* File Name: BLE.h
+*
+* Description:
+*  Host build stand-in for the BLE component header. Provides only the
+*  types, constants and functions used by the modules built for the host
+*  tests. The functions are implemented by the tests. The notification
+*  state of a characteristic is read with TestBle_GetCccd().
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_BLE_CYBLE_H)
+#define CY_BLE_CYBLE_H
+
+#include "cytypes.h"
+#include "CyLib.h"
+#include "CyFlash.h"
+
+#define CYBLE_PROFILE               (0u)
+#define CYBLE_HCI                   (1u)
+#define CYBLE_MODE                  (CYBLE_PROFILE)
+
+/***************************************
+*        Constants
+***************************************/
+#define CYBLE_EVT_GAP_DEVICE_DISCONNECTED   (0x28u)
+#define CYBLE_EVT_GATTS_WRITE_REQ           (0x4Cu)
+
+#define CYBLE_STACK_STATE_BUSY              (0x01u)
+#define CYBLE_STACK_STATE_FREE              (0x00u)
+
+#define CYBLE_GATT_DEFAULT_MTU              (23u)
+#define CYBLE_GATT_MTU                      (0x009Eu)
+#define CYBLE_GATT_WRITE_REQ                (0x12u)
+
+#define CYBLE_GATT_DB_LOCALLY_INITIATED     (0x00u)
+#define CYBLE_GATT_DB_PEER_INITIATED        (0x40u)
+
+#define CYBLE_CCCD_NOTIFICATION             (0x0001u)
+#define CYBLE_CCCD_LEN                      (0x02u)
+
+#define CYBLE_BULK_DATA_CHAR_HANDLE         (0x0011u)
+#define CYBLE_BULK_DATA_CCCD_HANDLE         (0x0012u)
+#define CYBLE_TELEMETRY_CHAR_HANDLE         (0x0015u)
+#define CYBLE_TELEMETRY_CCCD_HANDLE         (0x0016u)
+#define CYBLE_TELEMETRY_DATA_LEN            (64u)
+
+/***************************************
+*        Data Types
+***************************************/
+typedef enum
+{
+    CYBLE_ERROR_OK = 0,
+    CYBLE_ERROR_INVALID_PARAMETER,
+    CYBLE_ERROR_INVALID_OPERATION,
+    CYBLE_ERROR_MEMORY_ALLOCATION_FAILED
+} CYBLE_API_RESULT_T;
+
+typedef enum
+{
+    CYBLE_GATT_ERR_NONE = 0,
+    CYBLE_GATT_ERR_INVALID_HANDLE
+} CYBLE_GATT_ERR_CODE_T;
+
+typedef enum
+{
+    CYBLE_STATE_STOPPED,
+    CYBLE_STATE_INITIALIZING,
+    CYBLE_STATE_CONNECTED,
+    CYBLE_STATE_ADVERTISING,
+    CYBLE_STATE_DISCONNECTED
+} CYBLE_STATE_T;
+
+typedef uint16 CYBLE_GATT_DB_ATTR_HANDLE_T;
+
+typedef struct
+{
+    uint8 bdHandle;
+    uint8 attId;
+} CYBLE_CONN_HANDLE_T;
+
+typedef struct
+{
+    uint8 *val;
+    uint16 len;
+    uint16 actualLen;
+} CYBLE_GATT_VALUE_T;
+
+typedef struct
+{
+    CYBLE_GATT_VALUE_T value;
+    CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle;
+} CYBLE_GATT_HANDLE_VALUE_PAIR_T;
+
+typedef CYBLE_GATT_HANDLE_VALUE_PAIR_T CYBLE_GATTS_HANDLE_VALUE_NTF_T;
+
+typedef struct
+{
+    CYBLE_GATT_DB_ATTR_HANDLE_T attrHandle;
+    uint8 opcode;
+    CYBLE_GATT_ERR_CODE_T errorCode;
+} CYBLE_GATTS_ERR_PARAM_T;
+
+typedef struct
+{
+    CYBLE_CONN_HANDLE_T connHandle;
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValPair;
+} CYBLE_GATTS_WRITE_REQ_PARAM_T;
+
+/***************************************
+*        Stack State and API
+***************************************/
+extern CYBLE_STATE_T cyBle_state;
+extern uint8 cyBle_busyStatus;
+extern CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+#define CyBle_GetState()                    (cyBle_state)
+#define CyBle_GattGetBusyStatus()           (cyBle_busyStatus)
+
+#define CYBLE_IS_NOTIFICATION_ENABLED(handle) \
+        ((0u) != (CYBLE_CCCD_NOTIFICATION & TestBle_GetCccd(handle)))
+
+uint16 TestBle_GetCccd(CYBLE_GATT_DB_ATTR_HANDLE_T handle);
+
+CYBLE_API_RESULT_T CyBle_GattGetMtuSize(uint16 *mtu);
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam);
+CYBLE_GATT_ERR_CODE_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair,
+    uint16 offset, CYBLE_CONN_HANDLE_T *connHandle, uint8 flags);
+CYBLE_API_RESULT_T CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle);
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_ERR_PARAM_T *errRspParam);
+
+#endif /* CY_BLE_CYBLE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,32 @@
+/*******************************************************************************
+* File Name: BLE_STACK_PVT.h
+*
+* Description:
+*  Host build stand-in for the private BLE stack header. The radio trim
+*  registers are given dummy addresses: BLE_HAL_PVT.c refers to them, but
+*  the host tests never run the trim code.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_BLE_CYBLE_STACK_PVT_H)
+#define CY_BLE_CYBLE_STACK_PVT_H
+
+#include "cytypes.h"
+
+#define CYREG_SFLASH_BLESS_BB_BUMP2     (0x0F4001ACuL)
+#define CYREG_SFLASH_BLESS_BB_XO        (0x0F4001AEuL)
+#define CYREG_SFLASH_BLESS_SY_BUMP1     (0x0F4001B0uL)
+#define CYREG_SFLASH_BLESS_LDO          (0x0F4001B2uL)
+
+#define CYREG_BLE_BLERD_LDO             (0x40E80D20uL)
+#define CYREG_BLE_BLERD_SY_BUMP1        (0x40E80D24uL)
+#define CYREG_BLE_BLERD_BB_BUMP2        (0x40E80D28uL)
+#define CYREG_BLE_BLERD_BB_XO           (0x40E80D2CuL)
+
+#endif /* CY_BLE_CYBLE_STACK_PVT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,29 @@
+/*******************************************************************************
+* File Name: BLE_bless_isr.h
+*
+* Description:
+*  Host build stand-in for the BLESS interrupt component header. The
+*  interrupt calls do nothing.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_ISR_BLE_bless_isr_H)
+#define CY_ISR_BLE_bless_isr_H
+
+#include "cytypes.h"
+
+#define BLE_bless_isr_INTC_PRIOR_NUMBER     (0u)
+
+#define BLE_bless_isr_Enable()              ((void)0)
+#define BLE_bless_isr_Disable()             ((void)0)
+#define BLE_bless_isr_SetVector(address)    ((void)0)
+#define BLE_bless_isr_SetPriority(priority) ((void)0)
+#define BLE_bless_isr_StartEx(address)      ((void)0)
+
+#endif /* CY_ISR_BLE_bless_isr_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,37 @@
+/*******************************************************************************
+* File Name: CyFlash.h
+*
+* Description:
+*  Host build stand-in for the PSoC Creator CyFlash.h. The flash starts at
+*  address 0, so a flash address is a host address, and CySysFlashWriteRow()
+*  is provided by the simulated flash of flashsim.c.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_BOOT_CYFLASH_H)
+#define CY_BOOT_CYFLASH_H
+
+#include "cytypes.h"
+
+#define CYDEV_FLASH_BASE                (0x00000000u)
+#define CYDEV_FLASH_SIZE                (0x80000000u)
+
+#define CY_FLASH_BASE                   (CYDEV_FLASH_BASE)
+#define CY_FLASH_SIZE                   (CYDEV_FLASH_SIZE)
+#define CY_FLASH_SIZEOF_ARRAY           (0x00010000u)
+#define CY_FLASH_SIZEOF_ROW             (0x00000080u)
+
+/* CySysFlashWriteRow() - return codes */
+#define CY_SYS_FLASH_SUCCESS            (0x00u)
+#define CY_SYS_FLASH_INVALID_ADDR       (0x04u)
+#define CY_SYS_FLASH_PROTECTED          (0x05u)
+
+uint32 CySysFlashWriteRow(uint32 rowNum, const uint8 rowData[]);
+
+#endif /* CY_BOOT_CYFLASH_H */
+
+/* [] END OF FILE */
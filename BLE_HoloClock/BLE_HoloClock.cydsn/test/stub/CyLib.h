@@ -0,0 +1,27 @@
+/*******************************************************************************
+* File Name: CyLib.h
+*
+* Description:
+*  Host build stand-in for the PSoC Creator CyLib.h. The delays return at
+*  once and CYASSERT() aborts the test instead of halting.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_BOOT_CYLIB_H)
+#define CY_BOOT_CYLIB_H
+
+#include <assert.h>
+#include "cytypes.h"
+
+#define CyDelay(milliseconds)       ((void)(milliseconds))
+#define CyDelayUs(microseconds)     ((void)(microseconds))
+
+#define CYASSERT(x)                 assert(0u != (uint32)(x))
+
+#endif /* CY_BOOT_CYLIB_H */
+
+/* [] END OF FILE */
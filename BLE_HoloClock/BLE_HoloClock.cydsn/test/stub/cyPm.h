@@ -0,0 +1,35 @@
+/*******************************************************************************
+* File Name: cyPm.h
+*
+* Description:
+*  Host build stand-in for the PSoC Creator cyPm.h. Provides only the power
+*  mode statistics read by the modules built for the host tests.
+*  CySysPmStatsGet() is implemented by the tests.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_BOOT_CYPM_H)
+#define CY_BOOT_CYPM_H
+
+#include "cytypes.h"
+
+#define CY_PM_STATS_ACTIVE          (0u)
+#define CY_PM_STATS_SLEEP           (1u)
+#define CY_PM_STATS_DEEPSLEEP       (2u)
+#define CY_PM_STATS_MODES           (3u)
+
+typedef struct
+{
+    uint64 residency[CY_PM_STATS_MODES];
+    uint32 wakeLatencyMax;
+} CY_PM_STATS_STRUCT;
+
+const CY_PM_STATS_STRUCT * CySysPmStatsGet(void);
+
+#endif /* CY_BOOT_CYPM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,53 @@
+/*******************************************************************************
+* File Name: cytypes.h
+*
+* Description:
+*  Host build stand-in for the PSoC Creator cytypes.h. Provides only the
+*  types and macros used by the modules built for the host tests. Register
+*  addresses are host addresses, which the tests keep below 4 GB.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(CY_BOOT_CYTYPES_H)
+#define CY_BOOT_CYTYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t     uint8;
+typedef uint16_t    uint16;
+typedef uint32_t    uint32;
+typedef uint64_t    uint64;
+typedef int8_t      int8;
+typedef int16_t     int16;
+typedef int32_t     int32;
+
+typedef volatile uint8  reg8;
+typedef volatile uint16 reg16;
+typedef volatile uint32 reg32;
+
+typedef uint32      cystatus;
+
+#define CYRET_SUCCESS               (0x00u)
+#define CYRET_BAD_PARAM             (0x01u)
+#define CYRET_UNKNOWN               ((cystatus)0xFFFFFFFFu)
+
+#define CY_INLINE                   inline
+#define CY_SECTION(name)            __attribute__ ((section(name)))
+#define CY_ALIGN(align)             __attribute__ ((aligned(align)))
+
+#define CY_ISR(FuncName)            void FuncName (void)
+#define CY_ISR_PROTO(FuncName)      void FuncName (void)
+
+#define CY_GET_REG8(addr)           (*((const reg8 *)(uintptr_t)(addr)))
+#define CY_GET_REG32(addr)          (*((const reg32 *)(uintptr_t)(addr)))
+#define CY_SET_REG32(addr, value)   (*((reg32 *)(uintptr_t)(addr)) = (uint32)(value))
+#define CY_GET_XTND_REG8(addr)      CY_GET_REG8(addr)
+
+#endif /* CY_BOOT_CYTYPES_H */
+
+/* [] END OF FILE */
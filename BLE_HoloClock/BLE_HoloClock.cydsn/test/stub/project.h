@@ -0,0 +1,24 @@
+/*******************************************************************************
+* File Name: project.h
+*
+* Description:
+*  Host build stand-in for the PSoC Creator project.h.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#if !defined(PROJECT_H)
+#define PROJECT_H
+
+#include "cytypes.h"
+#include "CyLib.h"
+#include "CyFlash.h"
+#include "cyPm.h"
+#include "BLE.h"
+
+#endif /* PROJECT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,457 @@
+/*******************************************************************************
+* File Name: test_bulk.c
+*
+* Description:
+*  Host test of the bulk data transfer against a model of the stack
+*  notification buffers. The model takes notifications until its buffers
+*  are used, then reports the stack busy until the next connection event
+*  sends them. Checks that the block arrives whole in full-MTU chunks, that
+*  no notification is offered to a busy stack, and that the transfer stops
+*  when the client disables the notifications or disconnects.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <project.h>
+#include "bulk.h"
+#include "bledispatch.h"
+#include "connparam.h"
+#include "swtimer.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+#define TEST_CHECK(cond)            Test_Check((cond), #cond, __LINE__)
+
+#define TEST_BLOCK_SIZE             1000u
+#define TEST_MAX_CHUNKS             64u
+
+/* Wheel ticks between two connection events. */
+#define TEST_EVENT_TICKS            30u
+
+/***************************************
+*        Global Variables
+***************************************/
+CYBLE_STATE_T cyBle_state = CYBLE_STATE_STOPPED;
+uint8 cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+/***************************************
+*        Local Variables
+***************************************/
+static uint8 TestBlock[TEST_BLOCK_SIZE];
+
+/* Model of the stack: negotiated MTU, notification buffers, client
+ * configuration, and what the peer received. */
+static uint16 TestMtu = CYBLE_GATT_DEFAULT_MTU;
+static uint32 TestBufCount = 0u;
+static uint32 TestBufFree = 0u;
+static uint16 TestCccd = 0u;
+static uint8 TestReceived[TEST_BLOCK_SIZE];
+static uint32 TestReceivedLength = 0u;
+static uint16 TestChunks[TEST_MAX_CHUNKS];
+static uint32 TestChunkCount = 0u;
+static uint32 TestRefused = 0u;
+static uint32 TestWriteRsps = 0u;
+
+static uint32 TestTime = 0u;
+static uint8 TestDemand = 0u;
+
+static uint32 TestFailures = 0u;
+
+
+/*******************************************************************************
+* Host stand-ins for the stack and the modules that are not part of the test.
+*******************************************************************************/
+uint32 SwTimer_GetTime(void)
+{
+    return(TestTime);
+}
+
+void ConnParam_Demand(uint8 reasons, uint8 enable)
+{
+    if(enable != 0u)
+    {
+        TestDemand |= reasons;
+    }
+    else
+    {
+        TestDemand &= (uint8)~reasons;
+    }
+}
+
+uint16 TestBle_GetCccd(CYBLE_GATT_DB_ATTR_HANDLE_T handle)
+{
+    return((handle == CYBLE_BULK_DATA_CCCD_HANDLE) ? TestCccd : 0u);
+}
+
+CYBLE_API_RESULT_T CyBle_GattGetMtuSize(uint16 *mtu)
+{
+    *mtu = TestMtu;
+    return(CYBLE_ERROR_OK);
+}
+
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+    uint16 length = ntfParam->value.len;
+
+    (void)connHandle;
+
+    if((cyBle_busyStatus != CYBLE_STACK_STATE_FREE) || (TestBufFree == 0u) ||
+       (ntfParam->attrHandle != CYBLE_BULK_DATA_CHAR_HANDLE) || (length > (TestMtu - BULK_NTF_HEADER_SIZE)) ||
+       ((TestReceivedLength + length) > TEST_BLOCK_SIZE) || (TestChunkCount >= TEST_MAX_CHUNKS))
+    {
+        TestRefused++;
+        result = CYBLE_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    else
+    {
+        memcpy(&TestReceived[TestReceivedLength], ntfParam->value.val, length);
+        TestReceivedLength += length;
+        TestChunks[TestChunkCount] = length;
+        TestChunkCount++;
+
+        TestBufFree--;
+        if(TestBufFree == 0u)
+        {
+            cyBle_busyStatus = CYBLE_STACK_STATE_BUSY;
+        }
+    }
+
+    return(result);
+}
+
+CYBLE_GATT_ERR_CODE_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair,
+    uint16 offset, CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    CYBLE_GATT_ERR_CODE_T result = CYBLE_GATT_ERR_INVALID_HANDLE;
+
+    (void)offset;
+    (void)connHandle;
+    (void)flags;
+
+    if(handleValuePair->attrHandle == CYBLE_BULK_DATA_CCCD_HANDLE)
+    {
+        TestCccd = (uint16)handleValuePair->value.val[0u] | (uint16)((uint16)handleValuePair->value.val[1u] << 8u);
+        result = CYBLE_GATT_ERR_NONE;
+    }
+
+    return(result);
+}
+
+CYBLE_API_RESULT_T CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle)
+{
+    (void)connHandle;
+
+    TestWriteRsps++;
+    return(CYBLE_ERROR_OK);
+}
+
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_ERR_PARAM_T *errRspParam)
+{
+    (void)connHandle;
+    (void)errRspParam;
+
+    return(CYBLE_ERROR_OK);
+}
+
+/*******************************************************************************
+* Function Name: Test_Check
+********************************************************************************
+*
+* Summary:
+*  Reports a failed check.
+*
+* Parameters:
+*  int pass: Result of the check.
+*  const char *text: Checked expression.
+*  int line: Line of the check.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Check(int pass, const char *text, int line)
+{
+    if(pass == 0)
+    {
+        printf("test_bulk.c:%d: check failed: %s\n", line, text);
+        TestFailures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_WriteCccd
+********************************************************************************
+*
+* Summary:
+*  Delivers a client write of the Bulk Data client configuration through
+*  the event dispatcher.
+*
+* Parameters:
+*  uint16 value: Client configuration written.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_WriteCccd(uint16 value)
+{
+    CYBLE_GATTS_WRITE_REQ_PARAM_T writeParam;
+    uint8 cccdValue[CYBLE_CCCD_LEN];
+    uint32 writeRsps = TestWriteRsps;
+
+    cccdValue[0u] = (uint8)value;
+    cccdValue[1u] = (uint8)(value >> 8u);
+    writeParam.connHandle = cyBle_connHandle;
+    writeParam.handleValPair.attrHandle = CYBLE_BULK_DATA_CCCD_HANDLE;
+    writeParam.handleValPair.value.val = cccdValue;
+    writeParam.handleValPair.value.len = CYBLE_CCCD_LEN;
+
+    BleDispatch_Event(CYBLE_EVT_GATTS_WRITE_REQ, &writeParam);
+
+    TEST_CHECK(TestCccd == value);
+    TEST_CHECK(TestWriteRsps == (writeRsps + 1u));
+}
+
+/*******************************************************************************
+* Function Name: Test_Connect
+********************************************************************************
+*
+* Summary:
+*  Starts a connection with an MTU and a number of notification buffers,
+*  and lets the client enable the notifications.
+*
+* Parameters:
+*  uint16 mtu: Negotiated ATT MTU.
+*  uint32 buffers: Notifications the stack can queue.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Connect(uint16 mtu, uint32 buffers)
+{
+    cyBle_state = CYBLE_STATE_CONNECTED;
+    cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+    TestMtu = mtu;
+    TestBufCount = buffers;
+    TestBufFree = buffers;
+
+    TestReceivedLength = 0u;
+    TestChunkCount = 0u;
+    TestRefused = 0u;
+
+    Test_WriteCccd(CYBLE_CCCD_NOTIFICATION);
+}
+
+/*******************************************************************************
+* Function Name: Test_ConnectionEvent
+********************************************************************************
+*
+* Summary:
+*  Sends the queued notifications, which frees the stack buffers.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_ConnectionEvent(void)
+{
+    TestBufFree = TestBufCount;
+    cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+    TestTime += TEST_EVENT_TICKS;
+}
+
+/*******************************************************************************
+* Function Name: Test_Transfer
+********************************************************************************
+*
+* Summary:
+*  Sends a block and runs Bulk_Process() once per connection event until
+*  the transfer ends. Each event must fill the stack buffers with full-MTU
+*  chunks, the last chunk excepted.
+*
+* Parameters:
+*  const char *what: Transfer checked.
+*  uint16 mtu: Negotiated ATT MTU.
+*  uint32 length: Block length.
+*  uint32 buffers: Notifications the stack can queue.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Transfer(const char *what, uint16 mtu, uint32 length, uint32 buffers)
+{
+    BULK_STATS stats;
+    uint32 chunkSize = (uint32)mtu - BULK_NTF_HEADER_SIZE;
+    uint32 chunks = (length + chunkSize - 1u) / chunkSize;
+    uint32 events = (chunks + buffers - 1u) / buffers;
+    uint32 event = 0u;
+    uint32 queued;
+    uint32 index;
+
+    Test_Connect(mtu, buffers);
+
+    TEST_CHECK(Bulk_Send(TestBlock, length) == BULK_OK);
+    TEST_CHECK(Bulk_IsActive() == 1u);
+    TEST_CHECK(TestDemand == CONNPARAM_DEMAND_TRANSFER);
+    TEST_CHECK(Bulk_Send(TestBlock, length) == BULK_BUSY);
+
+    while((Bulk_IsActive() != 0u) && (event <= events))
+    {
+        queued = TestChunkCount;
+        Bulk_Process();
+        queued = TestChunkCount - queued;
+
+        TEST_CHECK((queued == buffers) || (TestChunkCount == chunks));
+        Test_ConnectionEvent();
+        event++;
+    }
+
+    Bulk_GetStats(&stats);
+    printf("%-28s %3lu notifications, %3lu connection events, %3lu stalls\n", what,
+           (unsigned long)stats.notifications, (unsigned long)event, (unsigned long)stats.stalls);
+
+    TEST_CHECK(Bulk_IsActive() == 0u);
+    TEST_CHECK(TestDemand == 0u);
+    TEST_CHECK(event == events);
+    TEST_CHECK(TestRefused == 0u);
+
+    TEST_CHECK(TestReceivedLength == length);
+    TEST_CHECK(memcmp(TestReceived, TestBlock, length) == 0);
+    TEST_CHECK(TestChunkCount == chunks);
+    for(index = 0u; (index + 1u) < TestChunkCount; index++)
+    {
+        TEST_CHECK(TestChunks[index] == chunkSize);
+    }
+
+    TEST_CHECK(stats.bytes == length);
+    TEST_CHECK(stats.notifications == chunks);
+    TEST_CHECK(stats.stalls == (events - 1u));
+    TEST_CHECK(stats.chunkSize == chunkSize);
+    TEST_CHECK(stats.durationTicks == ((events - 1u) * TEST_EVENT_TICKS));
+}
+
+/*******************************************************************************
+* Function Name: Test_NotEnabled
+********************************************************************************
+*
+* Summary:
+*  A block is refused without a connection or while the client has not
+*  enabled the notifications. An empty block starts no transfer.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_NotEnabled(void)
+{
+    cyBle_state = CYBLE_STATE_ADVERTISING;
+    TEST_CHECK(Bulk_Send(TestBlock, TEST_BLOCK_SIZE) == BULK_NOT_ENABLED);
+
+    cyBle_state = CYBLE_STATE_CONNECTED;
+    TEST_CHECK(Bulk_Send(TestBlock, TEST_BLOCK_SIZE) == BULK_NOT_ENABLED);
+
+    Test_WriteCccd(CYBLE_CCCD_NOTIFICATION);
+    TEST_CHECK(Bulk_Send(TestBlock, 0u) == BULK_OK);
+    TEST_CHECK(Bulk_IsActive() == 0u);
+    TEST_CHECK(TestDemand == 0u);
+}
+
+/*******************************************************************************
+* Function Name: Test_Stop
+********************************************************************************
+*
+* Summary:
+*  Stops a transfer by disabling the notifications, then another by
+*  disconnecting. Nothing more is notified and the short connection
+*  interval is released.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Stop(void)
+{
+    uint32 chunks;
+
+    Test_Connect(CYBLE_GATT_MTU, 3u);
+    TEST_CHECK(Bulk_Send(TestBlock, TEST_BLOCK_SIZE) == BULK_OK);
+    Bulk_Process();
+    Test_ConnectionEvent();
+
+    Test_WriteCccd(0u);
+    chunks = TestChunkCount;
+    Bulk_Process();
+    TEST_CHECK(TestChunkCount == chunks);
+    TEST_CHECK(Bulk_IsActive() == 0u);
+    TEST_CHECK(TestDemand == 0u);
+
+    Test_Connect(CYBLE_GATT_MTU, 3u);
+    TEST_CHECK(Bulk_Send(TestBlock, TEST_BLOCK_SIZE) == BULK_OK);
+    Bulk_Process();
+
+    cyBle_state = CYBLE_STATE_DISCONNECTED;
+    BleDispatch_Event(CYBLE_EVT_GAP_DEVICE_DISCONNECTED, NULL);
+    TEST_CHECK(TestCccd == 0u);
+    TEST_CHECK(Bulk_IsActive() == 0u);
+    TEST_CHECK(TestDemand == 0u);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Runs the tests.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if all checks passed, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32 index;
+
+    for(index = 0u; index < TEST_BLOCK_SIZE; index++)
+    {
+        TestBlock[index] = (uint8)((index * 31u) + 7u);
+    }
+
+    Bulk_Init();
+
+    Test_NotEnabled();
+    Test_Transfer("Default MTU, 3 buffers", CYBLE_GATT_DEFAULT_MTU, TEST_BLOCK_SIZE, 3u);
+    Test_Transfer("Full MTU, 3 buffers", CYBLE_GATT_MTU, TEST_BLOCK_SIZE, 3u);
+    Test_Transfer("Full MTU, 1 buffer", CYBLE_GATT_MTU, TEST_BLOCK_SIZE, 1u);
+    Test_Transfer("Full MTU, exact chunks", CYBLE_GATT_MTU, 6u * (CYBLE_GATT_MTU - BULK_NTF_HEADER_SIZE), 3u);
+    Test_Stop();
+
+    if(TestFailures != 0u)
+    {
+        printf("%lu check(s) failed\n", (unsigned long)TestFailures);
+    }
+    return((TestFailures == 0u) ? 0 : 1);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,361 @@
+/*******************************************************************************
+* File Name: test_kvstore.c
+*
+* Description:
+*  Host test of the key-value store against the simulated flash. Checks
+*  every stored value against a model after the writes and after a restart,
+*  that a store holding the most keys of the longest values keeps taking
+*  writes, and that a reset while a row is reused loses no record.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "kvstore.h"
+#include "flashsim.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+#define TEST_CHECK(cond)            Test_Check((cond), #cond, __LINE__)
+
+/* Keys used by the tests, 1 to TEST_KEYS. */
+#define TEST_KEYS                   KVSTORE_MAX_KEYS
+
+/* Rewrites of the last key after the store is filled. */
+#define TEST_REWRITES               40u
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Version of the value written last for each key, 0 when the key is not
+ * stored, and the value length. */
+static uint32 TestVersion[TEST_KEYS + 1u];
+static uint8 TestLength[TEST_KEYS + 1u];
+
+static uint32 TestFailures = 0u;
+
+
+/*******************************************************************************
+* Function Name: Test_Check
+********************************************************************************
+*
+* Summary:
+*  Reports a failed check.
+*
+* Parameters:
+*  int pass: Result of the check.
+*  const char *text: Checked expression.
+*  int line: Line of the check.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Check(int pass, const char *text, int line)
+{
+    if(pass == 0)
+    {
+        printf("test_kvstore.c:%d: check failed: %s\n", line, text);
+        TestFailures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Value
+********************************************************************************
+*
+* Summary:
+*  Builds the value of a version of a key.
+*
+* Parameters:
+*  uint8 data[]: Buffer of KVSTORE_MAX_VALUE bytes for the value.
+*  uint8 key: Key.
+*  uint32 version: Version of the value.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Value(uint8 data[], uint8 key, uint32 version)
+{
+    uint32 index;
+
+    for(index = 0u; index < KVSTORE_MAX_VALUE; index++)
+    {
+        data[index] = (uint8)((key * 13u) + (version * 7u) + index);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Reset
+********************************************************************************
+*
+* Summary:
+*  Erases the store and the model, and starts the store on the blank flash.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Reset(void)
+{
+    FlashSim_EraseAll();
+    memset(TestVersion, 0, sizeof(TestVersion));
+    memset(TestLength, 0, sizeof(TestLength));
+    KvStore_Init();
+}
+
+/*******************************************************************************
+* Function Name: Test_Write
+********************************************************************************
+*
+* Summary:
+*  Writes the next version of a key and updates the model when the store
+*  accepts it.
+*
+* Parameters:
+*  uint8 key: Key, 1 to TEST_KEYS.
+*  uint8 length: Value length.
+*
+* Return:
+*  uint8: Result of KvStore_Write().
+*
+*******************************************************************************/
+static uint8 Test_Write(uint8 key, uint8 length)
+{
+    uint8 data[KVSTORE_MAX_VALUE];
+    uint8 result;
+
+    Test_Value(data, key, TestVersion[key] + 1u);
+    result = KvStore_Write(key, data, length);
+    if(result == KVSTORE_OK)
+    {
+        TestVersion[key]++;
+        TestLength[key] = length;
+    }
+
+    return(result);
+}
+
+/*******************************************************************************
+* Function Name: Test_Verify
+********************************************************************************
+*
+* Summary:
+*  Compares every key of the store with the model.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Verify(void)
+{
+    uint8 expected[KVSTORE_MAX_VALUE];
+    uint8 data[KVSTORE_MAX_VALUE];
+    uint8 length;
+    uint8 key;
+
+    for(key = 1u; key <= TEST_KEYS; key++)
+    {
+        length = KvStore_Read(key, data, sizeof(data));
+        TEST_CHECK(length == TestLength[key]);
+
+        if((length == TestLength[key]) && (length != 0u))
+        {
+            Test_Value(expected, key, TestVersion[key]);
+            TEST_CHECK(memcmp(data, expected, length) == 0);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Fill
+********************************************************************************
+*
+* Summary:
+*  Stores TEST_KEYS keys of KVSTORE_MAX_VALUE bytes, three to a row, then
+*  rewrites the last key. Once the log wraps, the oldest row holds three
+*  live records that leave no room for a fourth.
+*
+* Parameters:
+*  uint32 rewrites: Number of rewrites of the last key.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Fill(uint32 rewrites)
+{
+    uint32 count;
+    uint8 key;
+
+    for(key = 1u; key <= TEST_KEYS; key++)
+    {
+        TEST_CHECK(Test_Write(key, KVSTORE_MAX_VALUE) == KVSTORE_OK);
+    }
+    for(count = 0u; count < rewrites; count++)
+    {
+        TEST_CHECK(Test_Write(TEST_KEYS, KVSTORE_MAX_VALUE) == KVSTORE_OK);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Updates
+********************************************************************************
+*
+* Summary:
+*  Updates and deletes short values over several turns of the log. Every
+*  write programs one row, unless the head row is full.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Updates(void)
+{
+    uint32 count;
+    uint8 key;
+
+    Test_Reset();
+    FlashSim_ClearStats();
+
+    for(count = 0u; count < 200u; count++)
+    {
+        key = (uint8)((count % 5u) + 1u);
+        TEST_CHECK(Test_Write(key, (uint8)((count % 8u) + 1u)) == KVSTORE_OK);
+    }
+    printf("%-28s %3lu rows programmed\n", "200 updates", (unsigned long)FlashSim_GetRowsProgrammed());
+    TEST_CHECK(FlashSim_GetRowsProgrammed() < 220u);
+
+    TEST_CHECK(KvStore_Delete(3u) == KVSTORE_OK);
+    TestVersion[3u] = 0u;
+    TestLength[3u] = 0u;
+    Test_Verify();
+
+    KvStore_Init();
+    Test_Verify();
+}
+
+/*******************************************************************************
+* Function Name: Test_Full
+********************************************************************************
+*
+* Summary:
+*  Fills the store with the most keys of the longest values and keeps
+*  rewriting one of them. Every write must be accepted.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Full(void)
+{
+    Test_Reset();
+    FlashSim_ClearStats();
+
+    Test_Fill(TEST_REWRITES);
+    printf("%-28s %3lu rows programmed\n", "Full store writes", (unsigned long)FlashSim_GetRowsProgrammed());
+    Test_Verify();
+
+    KvStore_Init();
+    Test_Verify();
+}
+
+/*******************************************************************************
+* Function Name: Test_PowerLoss
+********************************************************************************
+*
+* Summary:
+*  Finds the first rewrite of the full store that reuses more than one row,
+*  then repeats it with a power loss at each of its row programs. After the
+*  restart, every key must hold the value it had before the rewrite, and
+*  the rewrite must succeed when it is retried.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_PowerLoss(void)
+{
+    uint32 rewrites = 0u;
+    uint32 programs = 0u;
+    uint32 program;
+
+    Test_Reset();
+    Test_Fill(0u);
+    while((programs <= 1u) && (rewrites < TEST_REWRITES))
+    {
+        FlashSim_ClearStats();
+        TEST_CHECK(Test_Write(TEST_KEYS, KVSTORE_MAX_VALUE) == KVSTORE_OK);
+        programs = FlashSim_GetRowsProgrammed();
+        rewrites++;
+    }
+    printf("%-28s %3lu rows programmed\n", "Rewrite that reuses rows", (unsigned long)programs);
+    TEST_CHECK(programs > 1u);
+
+    for(program = 1u; program <= programs; program++)
+    {
+        Test_Reset();
+        Test_Fill(rewrites - 1u);
+
+        FlashSim_ClearStats();
+        FlashSim_SetPowerLossAt(program);
+        TEST_CHECK(Test_Write(TEST_KEYS, KVSTORE_MAX_VALUE) == KVSTORE_FLASH_ERROR);
+        FlashSim_SetPowerLossAt(0u);
+
+        KvStore_Init();
+        Test_Verify();
+
+        TEST_CHECK(Test_Write(TEST_KEYS, KVSTORE_MAX_VALUE) == KVSTORE_OK);
+        Test_Verify();
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Runs the tests.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if all checks passed, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+    Test_Updates();
+    Test_Full();
+    Test_PowerLoss();
+
+    if(TestFailures != 0u)
+    {
+        printf("%lu check(s) failed\n", (unsigned long)TestFailures);
+    }
+    return((TestFailures == 0u) ? 0 : 1);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,224 @@
+/*******************************************************************************
+* File Name: test_nvram.c
+*
+* Description:
+*  Host test of CyBLE_Nvram_Write() and CyBLE_Nvram_Erase() of the BLE
+*  component against the simulated flash. Checks the flash contents after
+*  each call and the number of rows it programs: rows that already hold
+*  the data must not be programmed.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "BLE_HAL_PVT.h"
+#include "flashsim.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+#define TEST_CHECK(cond)            Test_Check((cond), #cond, __LINE__)
+
+#define TEST_FLASH_ROWS             4u
+#define TEST_FLASH_SIZE             (TEST_FLASH_ROWS * CY_FLASH_SIZEOF_ROW)
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Simulated flash region, row aligned like cyBle_flashStorage. */
+static uint8 TestFlash[TEST_FLASH_SIZE] CY_ALIGN(CY_FLASH_SIZEOF_ROW);
+static uint8 TestImage[TEST_FLASH_SIZE];
+
+static uint32 TestFailures = 0u;
+
+
+/*******************************************************************************
+* Function Name: Test_Check
+********************************************************************************
+*
+* Summary:
+*  Reports a failed check.
+*
+* Parameters:
+*  int pass: Result of the check.
+*  const char *text: Checked expression.
+*  int line: Line of the check.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Check(int pass, const char *text, int line)
+{
+    if(pass == 0)
+    {
+        printf("test_nvram.c:%d: check failed: %s\n", line, text);
+        TestFailures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Write
+********************************************************************************
+*
+* Summary:
+*  Writes a part of TestImage to the same place of the simulated flash and
+*  checks the result, the flash contents and the number of rows programmed.
+*
+* Parameters:
+*  const char *what: Operation checked.
+*  uint32 offset: Offset of the data in the region.
+*  uint16 length: Length of the data.
+*  uint32 rows: Expected number of programmed rows.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Write(const char *what, uint32 offset, uint16 length, uint32 rows)
+{
+    FlashSim_ClearStats();
+
+    TEST_CHECK(CyBLE_Nvram_Write(&TestImage[offset], &TestFlash[offset], length) == CYRET_SUCCESS);
+    printf("%-28s %3lu rows programmed\n", what, (unsigned long)FlashSim_GetRowsProgrammed());
+
+    TEST_CHECK(FlashSim_GetRowsProgrammed() == rows);
+    TEST_CHECK(CyBLE_Nvram_GetRowsWritten() == rows);
+    TEST_CHECK(memcmp(TestFlash, TestImage, TEST_FLASH_SIZE) == 0);
+}
+
+/*******************************************************************************
+* Function Name: Test_WriteRows
+********************************************************************************
+*
+* Summary:
+*  Writes data that is new, unchanged, changed in one byte, and unaligned
+*  across a row boundary.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_WriteRows(void)
+{
+    uint32 index;
+
+    for(index = 0u; index < TEST_FLASH_SIZE; index++)
+    {
+        TestImage[index] = (uint8)((index * 7u) + 1u);
+    }
+
+    Test_Write("Write(new)", 0u, TEST_FLASH_SIZE, TEST_FLASH_ROWS);
+    Test_Write("Write(unchanged)", 0u, TEST_FLASH_SIZE, 0u);
+
+    TestImage[200u]++;
+    Test_Write("Write(one byte)", 0u, TEST_FLASH_SIZE, 1u);
+
+    /* Bytes 100 to 299 span rows 0 to 2, but only rows 0 and 2 change. */
+    TestImage[100u]++;
+    TestImage[299u]++;
+    Test_Write("Write(unaligned)", 100u, 200u, 2u);
+}
+
+/*******************************************************************************
+* Function Name: Test_Erase
+********************************************************************************
+*
+* Summary:
+*  Erases an unaligned range that covers four rows, then erases it again.
+*  Each row is programmed at most once, and not at all when it is already
+*  erased. The bytes around the range are kept.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Erase(void)
+{
+    FlashSim_ClearStats();
+    TEST_CHECK(CyBLE_Nvram_Erase(&TestFlash[100u], 300u) == CYRET_SUCCESS);
+    printf("%-28s %3lu rows programmed\n", "Erase(unaligned)", (unsigned long)FlashSim_GetRowsProgrammed());
+    TEST_CHECK(FlashSim_GetRowsProgrammed() == 4u);
+    TEST_CHECK(CyBLE_Nvram_GetRowsWritten() == 4u);
+
+    memset(&TestImage[100u], 0, 300u);
+    TEST_CHECK(memcmp(TestFlash, TestImage, TEST_FLASH_SIZE) == 0);
+
+    FlashSim_ClearStats();
+    TEST_CHECK(CyBLE_Nvram_Erase(&TestFlash[100u], 300u) == CYRET_SUCCESS);
+    printf("%-28s %3lu rows programmed\n", "Erase(erased)", (unsigned long)FlashSim_GetRowsProgrammed());
+    TEST_CHECK(FlashSim_GetRowsProgrammed() == 0u);
+    TEST_CHECK(CyBLE_Nvram_GetRowsWritten() == 0u);
+}
+
+/*******************************************************************************
+* Function Name: Test_Errors
+********************************************************************************
+*
+* Summary:
+*  Writes past the end of the flash, which must program nothing, and fails
+*  a row program, which must be reported as CYRET_UNKNOWN.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Errors(void)
+{
+    const uint8 *end = (const uint8 *)(uintptr_t)(CYBLE_HAL_FLASH_END_ADDR - 16u);
+
+    FlashSim_ClearStats();
+    TEST_CHECK(CyBLE_Nvram_Write(TestImage, end, 32u) == CYRET_BAD_PARAM);
+    TEST_CHECK(FlashSim_GetRowsProgrammed() == 0u);
+
+    TestImage[0u]++;
+    TestImage[CY_FLASH_SIZEOF_ROW]++;
+    FlashSim_ClearStats();
+    FlashSim_SetPowerLossAt(2u);
+    TEST_CHECK(CyBLE_Nvram_Write(TestImage, TestFlash, TEST_FLASH_SIZE) == CYRET_UNKNOWN);
+    FlashSim_SetPowerLossAt(0u);
+    TEST_CHECK(FlashSim_GetRowsProgrammed() == 2u);
+    TEST_CHECK(CyBLE_Nvram_GetRowsWritten() == 1u);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Runs the tests.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if all checks passed, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+    Test_WriteRows();
+    Test_Erase();
+    Test_Errors();
+
+    if(TestFailures != 0u)
+    {
+        printf("%lu check(s) failed\n", (unsigned long)TestFailures);
+    }
+    return((TestFailures == 0u) ? 0 : 1);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,813 @@
+/*******************************************************************************
+* File Name: test_telemetry.c
+*
+* Description:
+*  Host test of the telemetry batching against a model of the stack
+*  notification buffers. The timers are fired by the test. Checks that a
+*  newer snapshot replaces the records waiting in the batch, that every
+*  notification carries whole records within the MTU, that a stalled batch
+*  is counted once however often it is retried, and that the client
+*  configuration is cleared on disconnection.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <project.h>
+#include "telemetry.h"
+#include "bledispatch.h"
+#include "connparam.h"
+#include "flashsched.h"
+#include "lowpower.h"
+#include "swtimer.h"
+
+/***************************************
+*        MACRO Definition
+***************************************/
+#define TEST_CHECK(cond)            Test_Check((cond), #cond, __LINE__)
+
+#define TEST_MAX_NTF                16u
+#define TEST_MAX_RECORDS            32u
+
+/* Retries of a stalled batch, more than one connection event's worth */
+#define TEST_RETRIES                5u
+
+/***************************************
+*        Global Variables
+***************************************/
+CYBLE_STATE_T cyBle_state = CYBLE_STATE_STOPPED;
+uint8 cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+CYBLE_CONN_HANDLE_T cyBle_connHandle;
+
+/***************************************
+*        Local Variables
+***************************************/
+/* Model of the stack: negotiated MTU, notification buffers, client
+ * configuration, and the notifications the peer received. */
+static uint16 TestMtu = CYBLE_GATT_DEFAULT_MTU;
+static uint32 TestBufCount = 0u;
+static uint32 TestBufFree = 0u;
+static uint16 TestCccd = 0u;
+static uint8 TestNtf[TEST_MAX_NTF][CYBLE_TELEMETRY_DATA_LEN];
+static uint16 TestNtfLength[TEST_MAX_NTF];
+static uint32 TestNtfCount = 0u;
+static uint32 TestRefused = 0u;
+static uint32 TestWriteRsps = 0u;
+
+/* Timers started by the module, fired by the test */
+static SWTIMER *TestLatencyTimer = NULL;
+static SWTIMER *TestSnapshotTimer = NULL;
+
+/* Statistics read by the snapshots */
+static CY_PM_STATS_STRUCT TestPmStats;
+static LOWPOWER_STATS TestLpStats;
+static CONNPARAM_STATS TestConnStats;
+static uint32 TestDeferred = 0u;
+
+static uint32 TestFailures = 0u;
+
+
+/*******************************************************************************
+* Host stand-ins for the stack and the modules that are not part of the test.
+*******************************************************************************/
+void SwTimer_Start(SWTIMER *timer, uint32 timeoutMs, uint32 periodMs, SWTIMER_CALLBACK callback)
+{
+    (void)timeoutMs;
+
+    timer->period = periodMs;
+    timer->callback = callback;
+    timer->active = 1u;
+
+    if(periodMs != 0u)
+    {
+        TestSnapshotTimer = timer;
+    }
+    else
+    {
+        TestLatencyTimer = timer;
+    }
+}
+
+void SwTimer_Stop(SWTIMER *timer)
+{
+    timer->active = 0u;
+}
+
+uint32 SwTimer_GetTime(void)
+{
+    return(0u);
+}
+
+uint32 FlashSched_GetDeferred(void)
+{
+    return(TestDeferred);
+}
+
+void ConnParam_GetStats(CONNPARAM_STATS *stats)
+{
+    *stats = TestConnStats;
+}
+
+void LowPower_GetStats(LOWPOWER_STATS *stats)
+{
+    *stats = TestLpStats;
+}
+
+const CY_PM_STATS_STRUCT * CySysPmStatsGet(void)
+{
+    return(&TestPmStats);
+}
+
+uint16 TestBle_GetCccd(CYBLE_GATT_DB_ATTR_HANDLE_T handle)
+{
+    return((handle == CYBLE_TELEMETRY_CCCD_HANDLE) ? TestCccd : 0u);
+}
+
+CYBLE_API_RESULT_T CyBle_GattGetMtuSize(uint16 *mtu)
+{
+    *mtu = TestMtu;
+    return(CYBLE_ERROR_OK);
+}
+
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    CYBLE_API_RESULT_T result = CYBLE_ERROR_OK;
+    uint16 length = ntfParam->value.len;
+
+    (void)connHandle;
+
+    if((cyBle_busyStatus != CYBLE_STACK_STATE_FREE) || (TestBufFree == 0u) ||
+       (ntfParam->attrHandle != CYBLE_TELEMETRY_CHAR_HANDLE) ||
+       (length > (TestMtu - TELEMETRY_NTF_HEADER_SIZE)) || (length > CYBLE_TELEMETRY_DATA_LEN) ||
+       (TestNtfCount >= TEST_MAX_NTF))
+    {
+        TestRefused++;
+        result = CYBLE_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    else
+    {
+        memcpy(TestNtf[TestNtfCount], ntfParam->value.val, length);
+        TestNtfLength[TestNtfCount] = length;
+        TestNtfCount++;
+
+        TestBufFree--;
+        if(TestBufFree == 0u)
+        {
+            cyBle_busyStatus = CYBLE_STACK_STATE_BUSY;
+        }
+    }
+
+    return(result);
+}
+
+CYBLE_GATT_ERR_CODE_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair,
+    uint16 offset, CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    CYBLE_GATT_ERR_CODE_T result = CYBLE_GATT_ERR_INVALID_HANDLE;
+
+    (void)offset;
+    (void)connHandle;
+    (void)flags;
+
+    if(handleValuePair->attrHandle == CYBLE_TELEMETRY_CCCD_HANDLE)
+    {
+        TestCccd = (uint16)handleValuePair->value.val[0u] | (uint16)((uint16)handleValuePair->value.val[1u] << 8u);
+        result = CYBLE_GATT_ERR_NONE;
+    }
+
+    return(result);
+}
+
+CYBLE_API_RESULT_T CyBle_GattsWriteRsp(CYBLE_CONN_HANDLE_T connHandle)
+{
+    (void)connHandle;
+
+    TestWriteRsps++;
+    return(CYBLE_ERROR_OK);
+}
+
+CYBLE_API_RESULT_T CyBle_GattsErrorRsp(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_ERR_PARAM_T *errRspParam)
+{
+    (void)connHandle;
+    (void)errRspParam;
+
+    return(CYBLE_ERROR_OK);
+}
+
+/*******************************************************************************
+* Function Name: Test_Check
+********************************************************************************
+*
+* Summary:
+*  Reports a failed check.
+*
+* Parameters:
+*  int pass: Result of the check.
+*  const char *text: Checked expression.
+*  int line: Line of the check.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Check(int pass, const char *text, int line)
+{
+    if(pass == 0)
+    {
+        printf("test_telemetry.c:%d: check failed: %s\n", line, text);
+        TestFailures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Get16
+********************************************************************************
+*
+* Summary:
+*  Reads a little-endian 2-byte field of a record.
+*
+* Parameters:
+*  const uint8 src[]: Field.
+*
+* Return:
+*  uint32: Field value.
+*
+*******************************************************************************/
+static uint32 Test_Get16(const uint8 src[])
+{
+    return((uint32)src[0u] | ((uint32)src[1u] << 8u));
+}
+
+/*******************************************************************************
+* Function Name: Test_Get32
+********************************************************************************
+*
+* Summary:
+*  Reads a little-endian 4-byte field of a record.
+*
+* Parameters:
+*  const uint8 src[]: Field.
+*
+* Return:
+*  uint32: Field value.
+*
+*******************************************************************************/
+static uint32 Test_Get32(const uint8 src[])
+{
+    return(Test_Get16(&src[0u]) | (Test_Get16(&src[2u]) << 16u));
+}
+
+/*******************************************************************************
+* Function Name: Test_RecordLength
+********************************************************************************
+*
+* Summary:
+*  Returns the payload length of a record type.
+*
+* Parameters:
+*  uint8 type: Record type.
+*
+* Return:
+*  uint32: Payload length, 0 for an unknown type.
+*
+*******************************************************************************/
+static uint32 Test_RecordLength(uint8 type)
+{
+    uint32 length = 0u;
+
+    switch(type)
+    {
+    case TELEMETRY_REC_ALERT:
+        length = TELEMETRY_ALERT_LEN;
+        break;
+    case TELEMETRY_REC_POWER:
+        length = TELEMETRY_POWER_LEN;
+        break;
+    case TELEMETRY_REC_ERRORS:
+        length = TELEMETRY_ERRORS_LEN;
+        break;
+    case TELEMETRY_REC_LOWPOWER:
+        length = TELEMETRY_LOWPOWER_LEN;
+        break;
+    default:
+        break;
+    }
+    return(length);
+}
+
+/*******************************************************************************
+* Function Name: Test_Records
+********************************************************************************
+*
+* Summary:
+*  Parses the received notifications, each of which must hold whole
+*  records of a known type and length.
+*
+* Parameters:
+*  uint8 types[]: Receives the record types in the order received.
+*
+* Return:
+*  uint32: Number of records.
+*
+*******************************************************************************/
+static uint32 Test_Records(uint8 types[])
+{
+    uint32 count = 0u;
+    uint32 ntf;
+    uint32 offset;
+    uint32 length;
+
+    for(ntf = 0u; ntf < TestNtfCount; ntf++)
+    {
+        offset = 0u;
+        while(offset < TestNtfLength[ntf])
+        {
+            length = Test_RecordLength(TestNtf[ntf][offset]);
+            TEST_CHECK((offset + TELEMETRY_RECORD_HEADER) <= TestNtfLength[ntf]);
+            TEST_CHECK(length != 0u);
+            TEST_CHECK(TestNtf[ntf][offset + 1u] == length);
+            TEST_CHECK((offset + TELEMETRY_RECORD_HEADER + length) <= TestNtfLength[ntf]);
+
+            if((length == 0u) || (count >= TEST_MAX_RECORDS))
+            {
+                /* Not parsable any further */
+                offset = TestNtfLength[ntf];
+            }
+            else
+            {
+                types[count] = TestNtf[ntf][offset];
+                count++;
+                offset += TELEMETRY_RECORD_HEADER + length;
+            }
+        }
+    }
+    return(count);
+}
+
+/*******************************************************************************
+* Function Name: Test_FindRecord
+********************************************************************************
+*
+* Summary:
+*  Finds the last record of a type in the received notifications.
+*
+* Parameters:
+*  uint8 type: Record type.
+*
+* Return:
+*  const uint8 *: Payload of the record, NULL if none was received.
+*
+*******************************************************************************/
+static const uint8 *Test_FindRecord(uint8 type)
+{
+    const uint8 *payload = NULL;
+    uint32 ntf;
+    uint32 offset;
+
+    for(ntf = 0u; ntf < TestNtfCount; ntf++)
+    {
+        offset = 0u;
+        while((offset + TELEMETRY_RECORD_HEADER) <= TestNtfLength[ntf])
+        {
+            if(TestNtf[ntf][offset] == type)
+            {
+                payload = &TestNtf[ntf][offset + TELEMETRY_RECORD_HEADER];
+            }
+            offset += TELEMETRY_RECORD_HEADER + TestNtf[ntf][offset + 1u];
+        }
+    }
+    return(payload);
+}
+
+/*******************************************************************************
+* Function Name: Test_Fire
+********************************************************************************
+*
+* Summary:
+*  Expires a running timer of the module.
+*
+* Parameters:
+*  SWTIMER *timer: Timer.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Fire(SWTIMER *timer)
+{
+    TEST_CHECK((timer != NULL) && (timer->active != 0u));
+
+    if((timer != NULL) && (timer->active != 0u))
+    {
+        if(timer->period == 0u)
+        {
+            timer->active = 0u;
+        }
+        timer->callback(timer);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_WriteCccd
+********************************************************************************
+*
+* Summary:
+*  Delivers a client write of the Telemetry client configuration through
+*  the event dispatcher.
+*
+* Parameters:
+*  uint16 value: Client configuration written.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_WriteCccd(uint16 value)
+{
+    CYBLE_GATTS_WRITE_REQ_PARAM_T writeParam;
+    uint8 cccdValue[CYBLE_CCCD_LEN];
+    uint32 writeRsps = TestWriteRsps;
+
+    cccdValue[0u] = (uint8)value;
+    cccdValue[1u] = (uint8)(value >> 8u);
+    writeParam.connHandle = cyBle_connHandle;
+    writeParam.handleValPair.attrHandle = CYBLE_TELEMETRY_CCCD_HANDLE;
+    writeParam.handleValPair.value.val = cccdValue;
+    writeParam.handleValPair.value.len = CYBLE_CCCD_LEN;
+
+    BleDispatch_Event(CYBLE_EVT_GATTS_WRITE_REQ, &writeParam);
+
+    TEST_CHECK(TestCccd == value);
+    TEST_CHECK(TestWriteRsps == (writeRsps + 1u));
+}
+
+/*******************************************************************************
+* Function Name: Test_Connect
+********************************************************************************
+*
+* Summary:
+*  Starts a connection with an MTU and a number of notification buffers,
+*  and lets the client enable the notifications.
+*
+* Parameters:
+*  uint16 mtu: Negotiated ATT MTU.
+*  uint32 buffers: Notifications the stack can queue.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Connect(uint16 mtu, uint32 buffers)
+{
+    cyBle_state = CYBLE_STATE_CONNECTED;
+    cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+    TestMtu = mtu;
+    TestBufCount = buffers;
+    TestBufFree = buffers;
+
+    TestNtfCount = 0u;
+    TestRefused = 0u;
+
+    Test_WriteCccd(CYBLE_CCCD_NOTIFICATION);
+}
+
+/*******************************************************************************
+* Function Name: Test_Disconnect
+********************************************************************************
+*
+* Summary:
+*  Ends the connection. The client configuration must be cleared, and the
+*  module must drop its batch and stop its timers.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Disconnect(void)
+{
+    uint32 ntfCount = TestNtfCount;
+
+    cyBle_state = CYBLE_STATE_DISCONNECTED;
+    BleDispatch_Event(CYBLE_EVT_GAP_DEVICE_DISCONNECTED, NULL);
+    TEST_CHECK(TestCccd == 0u);
+
+    Telemetry_Process();
+    TEST_CHECK(TestNtfCount == ntfCount);
+    TEST_CHECK((TestLatencyTimer == NULL) || (TestLatencyTimer->active == 0u));
+    TEST_CHECK((TestSnapshotTimer == NULL) || (TestSnapshotTimer->active == 0u));
+}
+
+/*******************************************************************************
+* Function Name: Test_ConnectionEvent
+********************************************************************************
+*
+* Summary:
+*  Sends the queued notifications, which frees the stack buffers.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_ConnectionEvent(void)
+{
+    TestBufFree = TestBufCount;
+    cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+}
+
+/*******************************************************************************
+* Function Name: Test_SetStats
+********************************************************************************
+*
+* Summary:
+*  Sets the statistics read by the next snapshot, all derived from one
+*  value.
+*
+* Parameters:
+*  uint32 base: Value of the statistics.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_SetStats(uint32 base)
+{
+    /* The record holds the low 32 bits of the residency */
+    TestPmStats.residency[CY_PM_STATS_ACTIVE] = 0x100000000ull + base;
+    TestPmStats.residency[CY_PM_STATS_SLEEP] = base + 1u;
+    TestPmStats.residency[CY_PM_STATS_DEEPSLEEP] = base + 2u;
+    TestPmStats.wakeLatencyMax = base + 3u;
+
+    TestLpStats.deepSleep = base + 4u;
+    TestLpStats.sleep = base + 5u;
+    TestLpStats.eventClose = base + 6u;
+    TestLpStats.guardExpired = base + 7u;
+
+    TestConnStats.rejected = base + 8u;
+    TestDeferred = base + 9u;
+}
+
+/*******************************************************************************
+* Function Name: Test_CheckSnapshot
+********************************************************************************
+*
+* Summary:
+*  Checks the last power, low power and error records received against
+*  the statistics set by Test_SetStats().
+*
+* Parameters:
+*  uint32 base: Value of the statistics.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_CheckSnapshot(uint32 base)
+{
+    const uint8 *power = Test_FindRecord(TELEMETRY_REC_POWER);
+    const uint8 *lowPower = Test_FindRecord(TELEMETRY_REC_LOWPOWER);
+    const uint8 *errors = Test_FindRecord(TELEMETRY_REC_ERRORS);
+
+    TEST_CHECK((power != NULL) && (lowPower != NULL) && (errors != NULL));
+
+    if((power != NULL) && (lowPower != NULL) && (errors != NULL))
+    {
+        TEST_CHECK(Test_Get32(&power[0u]) == base);
+        TEST_CHECK(Test_Get32(&power[4u]) == (base + 1u));
+        TEST_CHECK(Test_Get32(&power[8u]) == (base + 2u));
+        TEST_CHECK(Test_Get32(&power[12u]) == (base + 3u));
+
+        TEST_CHECK(Test_Get32(&lowPower[0u]) == (base + 4u));
+        TEST_CHECK(Test_Get32(&lowPower[4u]) == (base + 5u));
+        TEST_CHECK(Test_Get32(&lowPower[8u]) == (base + 6u));
+        TEST_CHECK(Test_Get32(&lowPower[12u]) == (base + 7u));
+
+        TEST_CHECK(Test_Get16(&errors[TELEMETRY_ERR_CONN_PARAM * 2u]) == (base + 8u));
+        TEST_CHECK(Test_Get16(&errors[TELEMETRY_ERR_FLASH * 2u]) == (base + 9u));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_Replace
+********************************************************************************
+*
+* Summary:
+*  Takes two snapshots while the stack is busy. The batch must hold one
+*  record of each snapshot type with the newer values, next to every
+*  Alert Level change.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Replace(void)
+{
+    uint8 types[TEST_MAX_RECORDS];
+    uint32 count;
+
+    Test_Connect(CYBLE_GATT_MTU, 3u);
+    cyBle_busyStatus = CYBLE_STACK_STATE_BUSY;
+
+    Test_SetStats(100u);
+    Telemetry_Process();
+    Telemetry_Alert(1u);
+
+    Test_SetStats(200u);
+    Test_Fire(TestSnapshotTimer);
+    Telemetry_Process();
+    Telemetry_Alert(2u);
+    TEST_CHECK(TestNtfCount == 0u);
+
+    Test_ConnectionEvent();
+    Telemetry_Process();
+
+    count = Test_Records(types);
+    TEST_CHECK(TestNtfCount == 1u);
+    TEST_CHECK(count == 5u);
+    if(count == 5u)
+    {
+        TEST_CHECK(types[0u] == TELEMETRY_REC_POWER);
+        TEST_CHECK(types[1u] == TELEMETRY_REC_LOWPOWER);
+        TEST_CHECK(types[2u] == TELEMETRY_REC_ERRORS);
+        TEST_CHECK(types[3u] == TELEMETRY_REC_ALERT);
+        TEST_CHECK(types[4u] == TELEMETRY_REC_ALERT);
+    }
+    Test_CheckSnapshot(200u);
+    TEST_CHECK(TestLatencyTimer->active == 0u);
+    TEST_CHECK(TestRefused == 0u);
+
+    Test_Disconnect();
+}
+
+/*******************************************************************************
+* Function Name: Test_Split
+********************************************************************************
+*
+* Summary:
+*  Sends a batch larger than the default MTU. Each notification must carry
+*  whole records, and all records must arrive in order over the following
+*  passes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Split(void)
+{
+    uint8 types[TEST_MAX_RECORDS];
+    uint32 count;
+    uint32 pass;
+    uint32 ntf;
+
+    Test_Connect(CYBLE_GATT_DEFAULT_MTU, 3u);
+
+    Test_SetStats(300u);
+    Telemetry_Process();
+    Telemetry_Alert(1u);
+    Telemetry_Alert(2u);
+
+    for(pass = 0u; pass < TEST_MAX_NTF; pass++)
+    {
+        Telemetry_Process();
+        Test_ConnectionEvent();
+    }
+
+    /* 18 + 18 + 14 + (7 + 7) bytes of records in 20-byte notifications */
+    count = Test_Records(types);
+    TEST_CHECK(TestNtfCount == 4u);
+    TEST_CHECK(count == 5u);
+    if(count == 5u)
+    {
+        TEST_CHECK(types[0u] == TELEMETRY_REC_POWER);
+        TEST_CHECK(types[1u] == TELEMETRY_REC_LOWPOWER);
+        TEST_CHECK(types[2u] == TELEMETRY_REC_ERRORS);
+        TEST_CHECK(types[3u] == TELEMETRY_REC_ALERT);
+        TEST_CHECK(types[4u] == TELEMETRY_REC_ALERT);
+    }
+    for(ntf = 0u; ntf < TestNtfCount; ntf++)
+    {
+        TEST_CHECK(TestNtfLength[ntf] <= (CYBLE_GATT_DEFAULT_MTU - TELEMETRY_NTF_HEADER_SIZE));
+    }
+    Test_CheckSnapshot(300u);
+    TEST_CHECK(TestLatencyTimer->active == 0u);
+    TEST_CHECK(TestRefused == 0u);
+
+    Test_Disconnect();
+}
+
+/*******************************************************************************
+* Function Name: Test_Stall
+********************************************************************************
+*
+* Summary:
+*  Keeps the stack busy while a batch is due. The stall must be counted
+*  once per batch, however often the send is retried, and no notification
+*  may be offered to the busy stack.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Test_Stall(void)
+{
+    const uint8 *errors;
+    uint32 stalled = 0u;
+    uint32 retry;
+
+    Test_Connect(CYBLE_GATT_MTU, 3u);
+    Telemetry_Process();
+    errors = Test_FindRecord(TELEMETRY_REC_ERRORS);
+    TEST_CHECK(errors != NULL);
+    if(errors != NULL)
+    {
+        stalled = Test_Get16(&errors[TELEMETRY_ERR_STALLED * 2u]);
+    }
+
+    /* First stall: the latency timer makes the alert due */
+    Test_ConnectionEvent();
+    cyBle_busyStatus = CYBLE_STACK_STATE_BUSY;
+    Telemetry_Alert(1u);
+    Test_Fire(TestLatencyTimer);
+    for(retry = 0u; retry < TEST_RETRIES; retry++)
+    {
+        Telemetry_Process();
+    }
+    Test_ConnectionEvent();
+    Telemetry_Process();
+
+    /* Second stall: the snapshot fills the batch */
+    Test_ConnectionEvent();
+    cyBle_busyStatus = CYBLE_STACK_STATE_BUSY;
+    Test_Fire(TestSnapshotTimer);
+    for(retry = 0u; retry < TEST_RETRIES; retry++)
+    {
+        Telemetry_Process();
+    }
+    Test_ConnectionEvent();
+    Telemetry_Process();
+
+    /* The next snapshot reports both */
+    Test_ConnectionEvent();
+    Test_Fire(TestSnapshotTimer);
+    Telemetry_Process();
+
+    errors = Test_FindRecord(TELEMETRY_REC_ERRORS);
+    TEST_CHECK(errors != NULL);
+    if(errors != NULL)
+    {
+        TEST_CHECK(Test_Get16(&errors[TELEMETRY_ERR_STALLED * 2u]) == (stalled + 2u));
+        TEST_CHECK(Test_Get16(&errors[TELEMETRY_ERR_DROPPED * 2u]) == 0u);
+    }
+    TEST_CHECK(TestRefused == 0u);
+
+    Test_Disconnect();
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Runs the tests.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if all checks passed, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+    Telemetry_Init();
+
+    Test_Replace();
+    Test_Split();
+    Test_Stall();
+
+    if(TestFailures != 0u)
+    {
+        printf("%lu check(s) failed\n", (unsigned long)TestFailures);
+    }
+    return((TestFailures == 0u) ? 0 : 1);
+}
+
+/* [] END OF FILE */
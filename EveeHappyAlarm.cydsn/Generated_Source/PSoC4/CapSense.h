@@ -38,7 +38,7 @@
 #define CapSense_TOTAL_SENSOR_MASK (((CapSense_TOTAL_SENSOR_COUNT - 1u) / 8u) + 1u)	
 
 /* Interrupt handler */
-CY_ISR_PROTO(CapSense_ISR);
+CY_RAMFUNC CY_ISR_PROTO(CapSense_ISR);
 
 /* ISR Number and Priority to work with CyLib functions */
 #define CapSense_ISR_NUMBER        (CapSense_ISR__INTC_NUMBER)
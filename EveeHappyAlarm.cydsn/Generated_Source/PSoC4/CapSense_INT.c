@@ -22,6 +22,7 @@
 *  Place your includes, defines and code here 
 ********************************************************************************/
 /* `#START CapSense_ISR_INTC` */
+#include "samplebuf.h"
 
 /* `#END` */
 
@@ -55,7 +56,7 @@
 *  No
 *
 *******************************************************************************/
-CY_ISR(CapSense_ISR)
+CY_RAMFUNC CY_ISR(CapSense_ISR)
 {
     static uint8 CapSense_snsIndexTmp;
 	/*  Place your Interrupt code here. */
@@ -105,6 +106,21 @@ CY_ISR(CapSense_ISR)
 	
 	/*  Place your Interrupt code here. */
     /* `#START CapSense_ISR_EXIT` */
+	/* Queue the proximity raw count once the whole scan is complete, so the
+	 * main loop does not need to read it while the next scan is running.
+	 * The baseline is not updated yet, so the main loop pairs the raw count
+	 * with the baseline once it has updated it. */
+	if((CapSense_csdStatusVar & CapSense_SW_STS_BUSY) == 0u)
+	{
+		SAMPLE proxSample;
+		
+		proxSample.timestamp = SampleBuf_GetTimestamp();
+		proxSample.value[SAMPLE_PROX_RAW] = (int16)CapSense_sensorRaw[0u];
+		proxSample.value[SAMPLE_Y] = 0;
+		proxSample.value[SAMPLE_Z] = 0;
+		proxSample.source = SAMPLE_SRC_PROX;
+		(void) SampleRing_Push(&SampleBuf_proxRing, &proxSample);
+	}
 
     /* `#END` */
 }
@@ -305,6 +305,10 @@ void * _sbrk (int nbytes)
 *  preparation for running the standard c code.  Once initialization is complete
 *  it will call main().  This function will never return.
 *
+*  The __cy_regions table also holds the .ramfunc section, so the CY_RAMFUNC
+*  code is copied from Flash to SRAM by the same loop. The RVDS/MDK and IAR
+*  toolchains copy it in __main() and __iar_data_init3() respectively.
+*
 * Parameters:
 *  None
 *
@@ -73,6 +73,15 @@ typedef void (*cyWdtCallback)(void);
     void   CySysWdtEnableCounterIsr(uint32 counterNum);
     void   CySysWdtDisableCounterIsr(uint32 counterNum);
     void   CySysWdtIsr(void);
+
+    /* Timebase API */
+    void   CySysTimebaseStart(void);
+    uint64 CySysTimebaseGetTicks(void);
+    uint32 CySysTimebaseCalibrate(void);
+    void   CySysTimebaseSetFrequency(uint32 freqHz);
+    uint32 CySysTimebaseGetFrequency(void);
+    uint64 CySysTimebaseTicksToUs(uint64 ticks);
+    uint64 CySysTimebaseUsToTicks(uint64 us);
 #else
     /* WDT API */
     uint32 CySysWdtGetEnabledStatus(void);
@@ -202,6 +211,12 @@ typedef void (*cyWdtCallback)(void);
     #define CY_WDT_NUM_OF_WDT                    (3u)
     #define CY_WDT_NUM_OF_CALLBACKS             (3u)
 
+    /* CySysTimebaseStart() / CySysTimebaseCalibrate() */
+    #define CY_SYS_TIMEBASE_ILO_HZ              (32000u)
+    #define CY_SYS_TIMEBASE_WCO_HZ              (32768u)
+    #define CY_SYS_TIMEBASE_CAL_TICKS           (256u)
+    #define CY_SYS_TIMEBASE_US_PER_S            (1000000u)
+
     #if (CY_PSOC4_4100 || CY_PSOC4_4200)
         #define CY_SYS_WDT_1LFCLK_DELAY_US      ((uint16)( 67u))
         #define CY_SYS_WDT_3LFCLK_DELAY_US      ((uint16)(201u))
@@ -18,9 +18,8 @@
 
 #include "CyLib.h"
 
-#if(CY_IP_SRSSV2 && CY_IP_FMLT)
-    #include "CyFlash.h"
-#endif /* (CY_IP_SRSSV2 && CY_IP_FMLT) */
+/* CySysClkWriteImoFreq() || CySysClkGovApply() */
+#include "CyFlash.h"
 
 
 /* Do not use these definitions directly in your application */
@@ -33,10 +32,20 @@ uint32 cydelay32kMs   = CY_DELAY_MS_OVERFLOW * ((CYDEV_BCLK__SYSCLK__HZ + CY_DEL
 
 static cySysTickCallback CySysTickCallbacks[CY_SYS_SYST_NUM_OF_CALLBACKS];
 static void CySysTickServiceCallbacks(void);
+static void CySysClkGovApply(void);
 #if (CY_PSOC4_4100M || CY_PSOC4_4200M)
     static uint32 CySysClkImoGetWcoLock(void);
 #endif  /* (CY_PSOC4_4100M || CY_PSOC4_4200M) */
 
+/*******************************************************************************
+* Clock governor state. The level, the idle prescaler, the frequency floor and
+* the SYSCLK prescaler currently programmed.
+*******************************************************************************/
+static uint32 cySysClkGovLevel   = CY_SYS_CLK_GOV_BURST;
+static uint32 cySysClkGovIdleDiv = CY_SYS_CLK_SYSCLK_DIV1;
+static uint32 cySysClkGovFloorHz = 0u;
+static uint32 cySysClkGovDiv     = CY_SYS_CLK_SYSCLK_DIV1;
+
 
 /*******************************************************************************
 * Indicates whether or not the SysTick has been initialized. The variable is
@@ -1434,6 +1443,175 @@ void CyDelayFreq(uint32 freq)
 }
 
 
+/*******************************************************************************
+* Function Name: CySysClkGovApply
+********************************************************************************
+*
+* Summary:
+*  Programs the SYSCLK prescaler for the current governor level and floor.
+*  The Flash wait states are increased before SYSCLK increases and decreased
+*  after SYSCLK decreases. CyDelay() is recalibrated to the new frequency.
+*  Must be called within a critical section.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void CySysClkGovApply(void)
+{
+    uint32 divider;
+    uint32 freqHz;
+
+    divider = (CY_SYS_CLK_GOV_IDLE == cySysClkGovLevel) ? cySysClkGovIdleDiv : CY_SYS_CLK_SYSCLK_DIV1;
+
+    /* Do not go below the frequency required by the peripherals */
+    while ((CY_SYS_CLK_SYSCLK_DIV1 != divider) && ((CYDEV_BCLK__HFCLK__HZ >> divider) < cySysClkGovFloorHz))
+    {
+        divider--;
+    }
+
+    if (divider != cySysClkGovDiv)
+    {
+        freqHz = CYDEV_BCLK__HFCLK__HZ >> divider;
+
+        if (divider < cySysClkGovDiv)
+        {
+            CySysFlashSetWaitCycles((freqHz + CY_DELAY_1M_MINUS_1_THRESHOLD) / CY_DELAY_1M_THRESHOLD);
+            CySysClkWriteSysclkDiv(divider);
+        }
+        else
+        {
+            CySysClkWriteSysclkDiv(divider);
+            CySysFlashSetWaitCycles((freqHz + CY_DELAY_1M_MINUS_1_THRESHOLD) / CY_DELAY_1M_THRESHOLD);
+        }
+
+        cySysClkGovDiv = divider;
+        CyDelayFreq(freqHz);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CySysClkGovInit
+********************************************************************************
+*
+* Summary:
+*  Starts the clock governor and switches SYSCLK to the idle level.
+*
+*  The governor changes only the SYSCLK prescaler. HFCLK and the peripheral
+*  clock dividers derived from it (SCB, CapSense, TCPWM) are not changed, so
+*  the peripheral timing stays the same on each transition.
+*
+* Parameters:
+*  idleDiv: SYSCLK prescaler used at the CY_SYS_CLK_GOV_IDLE level. See
+*  CySysClkWriteSysclkDiv() for the valid values.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void CySysClkGovInit(uint32 idleDiv)
+{
+    uint8 interruptState;
+
+    interruptState = CyEnterCriticalSection();
+
+    cySysClkGovDiv = (CY_SYS_CLK_SELECT_REG >> CY_SYS_CLK_SELECT_SYSCLK_DIV_SHIFT) &
+                     CY_SYS_CLK_SELECT_SYSCLK_DIV_MASK;
+    cySysClkGovIdleDiv = idleDiv & CY_SYS_CLK_SELECT_SYSCLK_DIV_MASK;
+    cySysClkGovLevel = CY_SYS_CLK_GOV_IDLE;
+    CySysClkGovApply();
+
+    CyExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: CySysClkGovSetLevel
+********************************************************************************
+*
+* Summary:
+*  Selects the governor level. CY_SYS_CLK_GOV_BURST runs SYSCLK at HFCLK for
+*  the processing bursts. CY_SYS_CLK_GOV_IDLE uses the idle prescaler for
+*  polling and waiting. Can be called from an interrupt; restore the returned
+*  level when the burst is done.
+*
+* Parameters:
+*  level: CY_SYS_CLK_GOV_IDLE or CY_SYS_CLK_GOV_BURST.
+*
+* Return:
+*  The previous level.
+*
+*******************************************************************************/
+uint32 CySysClkGovSetLevel(uint32 level)
+{
+    uint8 interruptState;
+    uint32 previousLevel;
+
+    interruptState = CyEnterCriticalSection();
+
+    previousLevel = cySysClkGovLevel;
+    cySysClkGovLevel = level;
+    CySysClkGovApply();
+
+    CyExitCriticalSection(interruptState);
+
+    return (previousLevel);
+}
+
+
+/*******************************************************************************
+* Function Name: CySysClkGovSetFloor
+********************************************************************************
+*
+* Summary:
+*  Sets the lowest SYSCLK frequency the governor may select. The idle level
+*  is raised to the floor when the idle prescaler would go below it.
+*
+* Parameters:
+*  freqHz: Minimum SYSCLK frequency in Hz. Pass 0 to remove the floor.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void CySysClkGovSetFloor(uint32 freqHz)
+{
+    uint8 interruptState;
+
+    interruptState = CyEnterCriticalSection();
+
+    cySysClkGovFloorHz = freqHz;
+    CySysClkGovApply();
+
+    CyExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: CySysClkGovGetFreq
+********************************************************************************
+*
+* Summary:
+*  Returns the SYSCLK frequency currently selected by the governor.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  SYSCLK frequency in Hz.
+*
+*******************************************************************************/
+uint32 CySysClkGovGetFreq(void)
+{
+    return (CYDEV_BCLK__HFCLK__HZ >> cySysClkGovDiv);
+}
+
+
+
 /*******************************************************************************
 * Function Name: CySysTick_Start
 ********************************************************************************
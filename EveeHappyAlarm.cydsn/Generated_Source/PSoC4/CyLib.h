@@ -48,6 +48,12 @@ void CySysClkWriteHfclkDirect(uint32 clkSelect);
 void CySysClkWriteSysclkDiv(uint32 divider);
 void CySysClkWriteImoFreq(uint32 freq);
 
+/* Clock governor */
+void   CySysClkGovInit(uint32 idleDiv);
+uint32 CySysClkGovSetLevel(uint32 level);
+void   CySysClkGovSetFloor(uint32 freqHz);
+uint32 CySysClkGovGetFreq(void);
+
 #if (CY_PSOC4_4100BL || CY_PSOC4_4200BL)
     void CySysClkWriteEcoDiv(uint32 divider);
 #endif /* (CY_PSOC4_4100BL || CY_PSOC4_4200BL) */
@@ -180,6 +186,11 @@ void CyGetUniqueId(uint32* uniqueId);
 #endif  /* (CY_IP_SRSSV2) */
 
 
+/* CySysClkGovSetLevel() - parameter definitions */
+#define CY_SYS_CLK_GOV_IDLE                             (0u)
+#define CY_SYS_CLK_GOV_BURST                            (1u)
+
+
 /* CySysClkWriteSysclkDiv() - implementation definitions */
 #if(CY_IP_SRSSV2)
     #define CY_SYS_CLK_SELECT_SYSCLK_DIV_SHIFT          (19u)
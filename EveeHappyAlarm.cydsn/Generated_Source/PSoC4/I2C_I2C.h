@@ -228,7 +228,7 @@ typedef struct
     void   I2C_I2CSlaveClearWriteBuf(void);
 #endif /* (I2C_I2C_SLAVE_CONST) */
 
-CY_ISR_PROTO(I2C_I2C_ISR);
+CY_RAMFUNC CY_ISR_PROTO(I2C_I2C_ISR);
 
 
 /***************************************
@@ -34,7 +34,7 @@
 *  None
 *
 *******************************************************************************/
-CY_ISR(I2C_I2C_ISR)
+CY_RAMFUNC CY_ISR(I2C_I2C_ISR)
 {
     uint32 diffCount;
     uint32 endTransfer;
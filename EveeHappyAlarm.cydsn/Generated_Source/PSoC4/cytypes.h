@@ -274,6 +274,7 @@ typedef          char   char8;
     #define XDATA       xdata
 
     #define CY_NOINIT
+    #define CY_RAMFUNC
 
 #else
 
@@ -297,6 +298,11 @@ typedef          char   char8;
         #define CY_NORETURN         __attribute__ ((noreturn))
         #define CY_SECTION(name)    __attribute__ ((section(name)))
 
+        /* Places a function in the .ramfunc section, which the scatter-loading
+        *  code copies from Flash to SRAM before main().
+        */
+        #define CY_RAMFUNC          __attribute__ ((section(".ramfunc"), noinline))
+
         /* Specifies a minimum alignment (in bytes) for variables of the
         *  specified type.
         */
@@ -314,6 +320,7 @@ typedef          char   char8;
         #define CY_NOINIT           __attribute__ ((section(".noinit")))
         #define CY_NORETURN         __attribute__ ((noreturn))
         #define CY_SECTION(name)    __attribute__ ((section(name)))
+        #define CY_RAMFUNC          __attribute__ ((section(".ramfunc"), long_call, noinline))
         #define CY_ALIGN(align)     __attribute__ ((aligned(align)))
         #define CY_PACKED
         #define CY_PACKED_ATTR      __attribute__ ((packed))
@@ -322,6 +329,7 @@ typedef          char   char8;
 
         #define CY_NOINIT           __no_init
         #define CY_NORETURN         __noreturn
+        #define CY_RAMFUNC          __ramfunc
         #define CY_PACKED           __packed
         #define CY_PACKED_ATTR
         #define CY_INLINE           inline
@@ -330,6 +338,15 @@ typedef          char   char8;
 #endif  /* (CY_PSOC3) */
 
 
+/* Defining CY_RAMFUNC_DISABLE leaves the CY_RAMFUNC functions in Flash, e.g.
+*  to compare their execution time with the SRAM copy.
+*/
+#if defined(CY_RAMFUNC_DISABLE)
+    #undef  CY_RAMFUNC
+    #define CY_RAMFUNC
+#endif  /* defined(CY_RAMFUNC_DISABLE) */
+
+
 #if(CY_PSOC3)
 
     /* 8051 naturally returns 8 bit value. */
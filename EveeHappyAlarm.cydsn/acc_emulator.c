@@ -0,0 +1,911 @@
+/*****************************************************************************
+* File Name: acc_emulator.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides a register-level emulator of the onboard accelerometer.
+*  The emulator implements the byte-level I2C master functions used by
+*  accelerometer.c, models the register map defined in accelerometer.h and
+*  produces motion waveforms at the configured output data rate. All bus
+*  activity is counted so that the efficiency of the driver can be checked
+*  without the board.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "accelerometer.h"
+#include "acc_emulator.h"
+
+#if (ACC_EMULATOR_ENABLED)
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* Bus state of the emulated slave. */
+#define ACC_EMU_BUS_IDLE			0x00u
+#define ACC_EMU_BUS_WRITE_ADDR		0x01u	/* Next written byte is the register address */
+#define ACC_EMU_BUS_WRITE_DATA		0x02u
+#define ACC_EMU_BUS_READ_DATA		0x03u
+#define ACC_EMU_BUS_NACKED			0x04u
+
+/* Bits of registers that are not defined in accelerometer.h. */
+#define ACC_EMU_INT_SRC1_DRDY		0x10u
+#define ACC_EMU_INT_SRC1_WUFS		0x02u
+#define ACC_EMU_STATUS_INT			0x10u
+#define ACC_EMU_OSA_MASK			0x0Fu
+
+/* Output data rate period in microseconds, indexed by DATA_CTRL[3:0]. */
+#define ACC_EMU_ODR_PERIOD_TABLE	{ 80000u, 40000u, 20000u, 10000u, 5000u, 2500u, 1250u, 625u, \
+									  1280000u, 640000u, 320000u, 160000u, 80000u, 80000u, 80000u, 80000u }
+
+/* Fraction of a waveform period, in 1/1024 units. */
+#define ACC_EMU_PHASE_ONE			1024
+
+/*****************************************************************************
+* Local Function Prototypes
+*****************************************************************************/
+static uint8 AccEmu_ReadRegister(uint8 reg);
+static void AccEmu_WriteRegister(uint8 reg, uint8 value);
+static void AccEmu_LatchSample(void);
+static int32 AccEmu_WaveformMg(uint8 axis);
+static uint32 AccEmu_I2CMasterSendAddress(uint32 slaveAddress, uint32 bitRnW, uint32 mode);
+static void AccEmu_I2CMasterEndBuf(uint32 status, uint32 mode, uint32 complete);
+
+
+/*****************************************************************************
+* Local Global Variable Declarations
+*****************************************************************************/
+static const uint32 AccEmu_odrPeriodUs[16u] = ACC_EMU_ODR_PERIOD_TABLE;
+
+static uint8 AccEmu_regs[ACC_EMU_REG_COUNT];
+static uint8 AccEmu_regPointer = ZERO;
+static uint8 AccEmu_busState = ACC_EMU_BUS_IDLE;
+
+/* Status reported by AccEmu_I2CMasterStatus(), I2C_I2C_MSTAT_xxx bits. */
+static uint32 AccEmu_masterStatus = ZERO;
+
+static ACC_EMU_WAVEFORM AccEmu_waveform;
+static ACC_EMU_STATS AccEmu_stats;
+
+/* Emulated time and time of the next output sample. */
+static uint32 AccEmu_timeUs = ZERO;
+static uint32 AccEmu_sampleDueUs = ZERO;
+
+/* Transactions in which the address is not acknowledged. */
+static uint32 AccEmu_nackFirst = ZERO;
+static uint32 AccEmu_nackCount = ZERO;
+
+/* State of the wake-up function engine. */
+static int16 AccEmu_prevCounts[ACC_EMU_AXES];
+static uint8 AccEmu_wakeupCount = ZERO;
+
+
+/*******************************************************************************
+* Function Name: AccEmu_Reset
+********************************************************************************
+* Summary:
+* 	Puts the emulated accelerometer in its power-on state. The waveform and
+*   the bus statistics are not changed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AccEmu_Reset(void)
+{
+	uint32 index;
+	
+	for(index = 0u; index < ACC_EMU_REG_COUNT; index++)
+	{
+		AccEmu_regs[index] = ZERO;
+	}
+	
+	AccEmu_regs[ACC_DCST_RESP]       = ACC_SELF_TEST_VAL_1;
+	AccEmu_regs[ACC_WHO_AM_I]        = ACC_WHO_AM_I_VAL;
+	AccEmu_regs[ACC_CTRL_REG_2]      = 0x06u;
+	AccEmu_regs[ACC_INT_CTRL_REG_1]  = 0x10u;
+	AccEmu_regs[ACC_INT_CTRL_REG_2]  = 0x3Fu;
+	AccEmu_regs[ACC_DATA_CTRL_REG]   = 0x02u;
+	AccEmu_regs[ACC_WAKUP_THRESHOLD] = 0x08u;
+	
+	for(index = 0u; index < ACC_EMU_AXES; index++)
+	{
+		AccEmu_prevCounts[index] = ZERO;
+	}
+	
+	AccEmu_regPointer = ZERO;
+	AccEmu_busState = ACC_EMU_BUS_IDLE;
+	AccEmu_masterStatus = ZERO;
+	AccEmu_wakeupCount = ZERO;
+	AccEmu_sampleDueUs = AccEmu_timeUs;
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_SetWaveform
+********************************************************************************
+* Summary:
+* 	Sets the motion applied to the emulated accelerometer.
+*
+* Parameters:
+*  const ACC_EMU_WAVEFORM *waveform: Motion description, in mg.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AccEmu_SetWaveform(const ACC_EMU_WAVEFORM *waveform)
+{
+	AccEmu_waveform = *waveform;
+	
+	if(AccEmu_waveform.periodMs == 0u)
+	{
+		AccEmu_waveform.shape = ACC_EMU_SHAPE_STILL;
+	}
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_AdvanceTime
+********************************************************************************
+* Summary:
+* 	Advances the emulated time. A new sample is latched into the output
+*   registers for every output data rate period that elapses while the
+*   accelerometer is in the operating mode.
+*
+* Parameters:
+*  uint32 elapsedUs: Time elapsed since the previous call, in microseconds.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AccEmu_AdvanceTime(uint32 elapsedUs)
+{
+	uint32 periodUs;
+	
+	AccEmu_timeUs += elapsedUs;
+	
+	if((AccEmu_regs[ACC_CTRL_REG_1] & ACC_PC1_BIT_OR_MASK) == 0u)
+	{
+		/* No samples are produced in standby mode. */
+		AccEmu_sampleDueUs = AccEmu_timeUs;
+	}
+	else
+	{
+		periodUs = AccEmu_odrPeriodUs[AccEmu_regs[ACC_DATA_CTRL_REG] & ACC_EMU_OSA_MASK];
+		
+		while((int32)(AccEmu_timeUs - AccEmu_sampleDueUs) >= 0)
+		{
+			AccEmu_LatchSample();
+			AccEmu_sampleDueUs += periodUs;
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_PeekRegister
+********************************************************************************
+* Summary:
+* 	Returns a register value without the side effects of a bus read.
+*
+* Parameters:
+*  uint8 reg: Register address.
+*
+* Return:
+*  uint8: Register value.
+*
+*******************************************************************************/
+uint8 AccEmu_PeekRegister(uint8 reg)
+{
+	return(AccEmu_regs[reg & (ACC_EMU_REG_COUNT - 1u)]);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_GetStats
+********************************************************************************
+* Summary:
+* 	Copies the bus statistics.
+*
+* Parameters:
+*  ACC_EMU_STATS *stats: Destination of the statistics.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AccEmu_GetStats(ACC_EMU_STATS *stats)
+{
+	*stats = AccEmu_stats;
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_ClearStats
+********************************************************************************
+* Summary:
+* 	Clears the bus statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AccEmu_ClearStats(void)
+{
+	AccEmu_stats.transactions = ZERO;
+	AccEmu_stats.restarts     = ZERO;
+	AccEmu_stats.addressBytes = ZERO;
+	AccEmu_stats.bytesWritten = ZERO;
+	AccEmu_stats.bytesRead    = ZERO;
+	AccEmu_stats.nacks        = ZERO;
+	AccEmu_stats.protectedWrites = ZERO;
+	AccEmu_stats.samples      = ZERO;
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_SetNackAt
+********************************************************************************
+* Summary:
+* 	Makes the emulated accelerometer NACK its address in consecutive
+*   transactions, numbered as in the bus statistics, to test the error paths
+*   of the driver.
+*
+* Parameters:
+*  uint32 transaction: Number of the first transaction to NACK.
+*  uint32 count: Number of transactions to NACK, 0 to disable the fault.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void AccEmu_SetNackAt(uint32 transaction, uint32 count)
+{
+	AccEmu_nackFirst = transaction;
+	AccEmu_nackCount = count;
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_WaveformMg
+********************************************************************************
+* Summary:
+* 	Evaluates the waveform of one axis at the current emulated time.
+*
+* Parameters:
+*  uint8 axis: Axis index, 0 = x, 1 = y, 2 = z.
+*
+* Return:
+*  int32: Acceleration in mg.
+*
+*******************************************************************************/
+static int32 AccEmu_WaveformMg(uint8 axis)
+{
+	int32 phase;
+	int32 shape = ZERO;
+	uint32 periodUs;
+	
+	if(AccEmu_waveform.shape != ACC_EMU_SHAPE_STILL)
+	{
+		periodUs = (uint32)AccEmu_waveform.periodMs * 1000u;
+		phase = (int32)(((AccEmu_timeUs % periodUs) / 1000u) * ACC_EMU_PHASE_ONE / AccEmu_waveform.periodMs);
+		
+		if(AccEmu_waveform.shape == ACC_EMU_SHAPE_TRIANGLE)
+		{
+			shape = (phase < (ACC_EMU_PHASE_ONE / 2)) ? 
+					((phase * 4) - ACC_EMU_PHASE_ONE) : ((3 * ACC_EMU_PHASE_ONE) - (phase * 4));
+		}
+		else
+		{
+			shape = (phase < (ACC_EMU_PHASE_ONE / 2)) ? ACC_EMU_PHASE_ONE : -ACC_EMU_PHASE_ONE;
+		}
+	}
+	
+	return((int32)AccEmu_waveform.offsetMg[axis] + 
+		   (((int32)AccEmu_waveform.amplitudeMg[axis] * shape) / ACC_EMU_PHASE_ONE));
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_LatchSample
+********************************************************************************
+* Summary:
+* 	Converts the waveform to counts using the resolution and range selected
+*   in CTRL_REG1, updates the output registers and runs the wake-up function
+*   engine.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void AccEmu_LatchSample(void)
+{
+	uint8 ctrl1 = AccEmu_regs[ACC_CTRL_REG_1];
+	uint8 highRes = ((ctrl1 & ACC_RES_BIT_OR_MASK) != 0u) ? 1u : 0u;
+	uint8 gsel = (uint8)((ctrl1 & (ACC_GSEL1_BIT_OR_MASK | ACC_GSEL0_BIT_OR_MASK)) >> 3u);
+	int32 countsPerG;
+	int32 limit;
+	int32 counts;
+	int32 delta;
+	uint8 motion = FALSE;
+	uint8 axis;
+	uint16 raw;
+	
+	countsPerG = ((highRes != 0u) ? G2_MODE_RESOLUTION : (G2_MODE_RESOLUTION >> 4u)) >> gsel;
+	limit = (highRes != 0u) ? 2047 : 127;
+	
+	for(axis = 0u; axis < ACC_EMU_AXES; axis++)
+	{
+		counts = (AccEmu_WaveformMg(axis) * countsPerG) / 1000;
+		
+		if(counts > limit)
+		{
+			counts = limit;
+		}
+		else if(counts < (-limit - 1))
+		{
+			counts = -limit - 1;
+		}
+		else
+		{
+		}
+		
+		/* The output is left justified in the 16-bit register pair. */
+		raw = (highRes != 0u) ? (uint16)((uint32)counts << 4u) : (uint16)((uint32)counts << 8u);
+		AccEmu_regs[ACC_XOUT_L + (axis * 2u)] = (uint8)(raw & 0xFFu);
+		AccEmu_regs[ACC_XOUT_H + (axis * 2u)] = (uint8)(raw >> 8u);
+		
+		/* The wake-up threshold is in 1/16 g units. */
+		delta = counts - AccEmu_prevCounts[axis];
+		if(delta < 0)
+		{
+			delta = -delta;
+		}
+		if((delta * 16) > ((int32)AccEmu_regs[ACC_WAKUP_THRESHOLD] * countsPerG))
+		{
+			motion = TRUE;
+		}
+		AccEmu_prevCounts[axis] = (int16)counts;
+	}
+	
+	if((ctrl1 & ACC_DRDYE_BIT_OR_MASK) != 0u)
+	{
+		AccEmu_regs[ACC_INT_SRC_1] |= ACC_EMU_INT_SRC1_DRDY;
+		AccEmu_regs[ACC_STATUS_REG] |= ACC_EMU_STATUS_INT;
+	}
+	
+	if(((ctrl1 & ACC_WUFE_BIT_OR_MASK) != 0u) && (motion == TRUE))
+	{
+		AccEmu_wakeupCount++;
+		if(AccEmu_wakeupCount >= AccEmu_regs[ACC_WAKEUP_TIMER])
+		{
+			AccEmu_regs[ACC_INT_SRC_1] |= ACC_EMU_INT_SRC1_WUFS;
+			AccEmu_regs[ACC_STATUS_REG] |= ACC_EMU_STATUS_INT;
+		}
+	}
+	else
+	{
+		AccEmu_wakeupCount = ZERO;
+	}
+	
+	AccEmu_stats.samples++;
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_ReadRegister
+********************************************************************************
+* Summary:
+* 	Reads a register over the emulated bus, including the read side effects
+*   of the DCST_RESP and INT_REL registers.
+*
+* Parameters:
+*  uint8 reg: Register address.
+*
+* Return:
+*  uint8: Register value.
+*
+*******************************************************************************/
+static uint8 AccEmu_ReadRegister(uint8 reg)
+{
+	uint8 value = AccEmu_regs[reg];
+	
+	if(reg == ACC_DCST_RESP)
+	{
+		/* 0xAA is returned once after DCST is set, then the register
+		 * returns to 0x55 and the DCST bit is cleared. */
+		if(value == ACC_SELF_TEST_VAL_2)
+		{
+			AccEmu_regs[ACC_DCST_RESP] = ACC_SELF_TEST_VAL_1;
+			AccEmu_regs[ACC_CTRL_REG_2] &= ACC_DCST_BIT_AND_MASK;
+		}
+	}
+	else if(reg == ACC_INT_REL)
+	{
+		/* Reading INT_REL clears all latched interrupts. */
+		AccEmu_regs[ACC_INT_SRC_1] = ZERO;
+		AccEmu_regs[ACC_INT_SRC_2] = ZERO;
+		AccEmu_regs[ACC_STATUS_REG] &= (uint8) ~ACC_EMU_STATUS_INT;
+	}
+	else
+	{
+	}
+	
+	return(value);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_WriteRegister
+********************************************************************************
+* Summary:
+* 	Writes a register over the emulated bus. Read-only registers ignore the
+*   write. While the PC1 bit of CTRL_REG1 is 1, a CTRL_REG1 write can only
+*   change PC1, and the registers from CTRL_REG2 to WAKEUP_THRESHOLD cannot
+*   be changed. The ignored writes are counted.
+*
+* Parameters:
+*  uint8 reg: Register address.
+*  uint8 value: Value to write.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void AccEmu_WriteRegister(uint8 reg, uint8 value)
+{
+	uint8 standby = ((AccEmu_regs[ACC_CTRL_REG_1] & ACC_PC1_BIT_OR_MASK) == 0u) ? TRUE : FALSE;
+	
+	switch(reg)
+	{
+		case ACC_CTRL_REG_1:
+			if(standby == TRUE)
+			{
+				AccEmu_regs[reg] = value;
+			}
+			else
+			{
+				if(((AccEmu_regs[reg] ^ value) & ACC_PC1_BIT_AND_MASK) != 0u)
+				{
+					AccEmu_stats.protectedWrites++;
+				}
+				AccEmu_regs[reg] = (uint8)((AccEmu_regs[reg] & ACC_PC1_BIT_AND_MASK) | 
+										   (value & ACC_PC1_BIT_OR_MASK));
+			}
+			break;
+		
+		case ACC_CTRL_REG_2:
+			if(standby == FALSE)
+			{
+				AccEmu_stats.protectedWrites++;
+			}
+			else
+			{
+				if((value & ACC_SRST_BIT_OR_MASK) != 0u)
+				{
+					AccEmu_Reset();
+				}
+				else
+				{
+					AccEmu_regs[reg] = value;
+					if((value & ACC_DCST_BIT_OR_MASK) != 0u)
+					{
+						AccEmu_regs[ACC_DCST_RESP] = ACC_SELF_TEST_VAL_2;
+					}
+				}
+			}
+			break;
+		
+		case ACC_INT_CTRL_REG_1:
+		case ACC_INT_CTRL_REG_2:
+		case ACC_DATA_CTRL_REG:
+		case ACC_WAKEUP_TIMER:
+		case ACC_SELF_TEST:
+		case ACC_WAKUP_THRESHOLD:
+			if(standby == TRUE)
+			{
+				AccEmu_regs[reg] = value;
+			}
+			else
+			{
+				AccEmu_stats.protectedWrites++;
+			}
+			break;
+		
+		default:
+			/* Read-only or reserved register. */
+			break;
+	}
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterSendStart
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterSendStart().
+*
+* Parameters:
+*  uint32 slaveAddress: 7-bit slave address.
+*  uint32 bitRnW: I2C_I2C_WRITE_XFER_MODE or I2C_I2C_READ_XFER_MODE.
+*
+* Return:
+*  uint32: I2C master status.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterSendStart(uint32 slaveAddress, uint32 bitRnW)
+{
+	uint32 status = I2C_I2C_MSTR_NO_ERROR;
+	
+	if(AccEmu_busState != ACC_EMU_BUS_IDLE)
+	{
+		status = I2C_I2C_MSTR_NOT_READY;
+	}
+	else
+	{
+		AccEmu_stats.transactions++;
+		AccEmu_stats.addressBytes++;
+		
+		if((slaveAddress != ACCELEROMETER_ADDR) || 
+		   ((AccEmu_stats.transactions - AccEmu_nackFirst) < AccEmu_nackCount))
+		{
+			AccEmu_stats.nacks++;
+			AccEmu_busState = ACC_EMU_BUS_NACKED;
+			status = I2C_I2C_MSTR_ERR_LB_NAK;
+		}
+		else
+		{
+			AccEmu_busState = (bitRnW == ACC_READ) ? ACC_EMU_BUS_READ_DATA : ACC_EMU_BUS_WRITE_ADDR;
+		}
+	}
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterSendRestart
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterSendRestart().
+*
+* Parameters:
+*  uint32 slaveAddress: 7-bit slave address.
+*  uint32 bitRnW: I2C_I2C_WRITE_XFER_MODE or I2C_I2C_READ_XFER_MODE.
+*
+* Return:
+*  uint32: I2C master status.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterSendRestart(uint32 slaveAddress, uint32 bitRnW)
+{
+	uint32 status = I2C_I2C_MSTR_NO_ERROR;
+	
+	if(AccEmu_busState == ACC_EMU_BUS_IDLE)
+	{
+		status = I2C_I2C_MSTR_NOT_READY;
+	}
+	else
+	{
+		AccEmu_stats.restarts++;
+		AccEmu_stats.addressBytes++;
+		
+		if(slaveAddress != ACCELEROMETER_ADDR)
+		{
+			AccEmu_stats.nacks++;
+			AccEmu_busState = ACC_EMU_BUS_NACKED;
+			status = I2C_I2C_MSTR_ERR_LB_NAK;
+		}
+		else
+		{
+			AccEmu_busState = (bitRnW == ACC_READ) ? ACC_EMU_BUS_READ_DATA : ACC_EMU_BUS_WRITE_ADDR;
+		}
+	}
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterSendStop
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterSendStop().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32: I2C master status.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterSendStop(void)
+{
+	uint32 status = I2C_I2C_MSTR_NO_ERROR;
+	
+	if(AccEmu_busState == ACC_EMU_BUS_IDLE)
+	{
+		status = I2C_I2C_MSTR_NOT_READY;
+	}
+	
+	AccEmu_busState = ACC_EMU_BUS_IDLE;
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterWriteByte
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterWriteByte(). The first byte after the address sets
+*   the register pointer, the following bytes are written with auto-increment.
+*
+* Parameters:
+*  uint32 theByte: Byte to write.
+*
+* Return:
+*  uint32: I2C master status.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterWriteByte(uint32 theByte)
+{
+	uint32 status = I2C_I2C_MSTR_NO_ERROR;
+	
+	if(AccEmu_busState == ACC_EMU_BUS_WRITE_ADDR)
+	{
+		AccEmu_regPointer = (uint8)(theByte & (ACC_EMU_REG_COUNT - 1u));
+		AccEmu_busState = ACC_EMU_BUS_WRITE_DATA;
+		AccEmu_stats.bytesWritten++;
+	}
+	else if(AccEmu_busState == ACC_EMU_BUS_WRITE_DATA)
+	{
+		AccEmu_WriteRegister(AccEmu_regPointer, (uint8)theByte);
+		AccEmu_regPointer = (AccEmu_regPointer + 1u) & (ACC_EMU_REG_COUNT - 1u);
+		AccEmu_stats.bytesWritten++;
+	}
+	else
+	{
+		status = I2C_I2C_MSTR_NOT_READY;
+	}
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterReadByte
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterReadByte(). Reads the register at the register
+*   pointer and advances the pointer.
+*
+* Parameters:
+*  uint32 ackNack: I2C_I2C_ACK_DATA or I2C_I2C_NAK_DATA.
+*
+* Return:
+*  uint32: Byte read.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterReadByte(uint32 ackNack)
+{
+	uint32 value = 0xFFu;
+	
+	if(AccEmu_busState == ACC_EMU_BUS_READ_DATA)
+	{
+		value = AccEmu_ReadRegister(AccEmu_regPointer);
+		AccEmu_regPointer = (AccEmu_regPointer + 1u) & (ACC_EMU_REG_COUNT - 1u);
+		AccEmu_stats.bytesRead++;
+		
+		if(ackNack == I2C_I2C_NAK_DATA)
+		{
+			/* The master ends the read, only Stop or Restart may follow. */
+			AccEmu_busState = ACC_EMU_BUS_NACKED;
+		}
+	}
+	
+	return(value);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterSendAddress
+********************************************************************************
+* Summary:
+* 	Begins a buffer transfer with a Start, or a repeated Start if the mode
+*   asks for it.
+*
+* Parameters:
+*  uint32 slaveAddress: 7-bit slave address.
+*  uint32 bitRnW: I2C_I2C_WRITE_XFER_MODE or I2C_I2C_READ_XFER_MODE.
+*  uint32 mode: I2C_I2C_MODE_xxx bits of the transfer.
+*
+* Return:
+*  uint32: I2C master status.
+*
+*******************************************************************************/
+static uint32 AccEmu_I2CMasterSendAddress(uint32 slaveAddress, uint32 bitRnW, uint32 mode)
+{
+	uint32 status;
+	
+	if((mode & I2C_I2C_MODE_REPEAT_START) != 0u)
+	{
+		status = AccEmu_I2CMasterSendRestart(slaveAddress, bitRnW);
+	}
+	else
+	{
+		status = AccEmu_I2CMasterSendStart(slaveAddress, bitRnW);
+	}
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterEndBuf
+********************************************************************************
+* Summary:
+* 	Ends a buffer transfer as the Component interrupt does: the bus is left
+*   halted in I2C_I2C_MODE_NO_STOP, even after an error, and released with a
+*   Stop otherwise.
+*
+* Parameters:
+*  uint32 status: I2C master status of the last byte or address.
+*  uint32 mode: I2C_I2C_MODE_xxx bits of the transfer.
+*  uint32 complete: I2C_I2C_MSTAT_RD_CMPLT or I2C_I2C_MSTAT_WR_CMPLT.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void AccEmu_I2CMasterEndBuf(uint32 status, uint32 mode, uint32 complete)
+{
+	if((mode & I2C_I2C_MODE_NO_STOP) == 0u)
+	{
+		(void) AccEmu_I2CMasterSendStop();
+	}
+	
+	AccEmu_masterStatus |= complete;
+	if(status != I2C_I2C_MSTR_NO_ERROR)
+	{
+		AccEmu_masterStatus |= I2C_I2C_MSTAT_ERR_XFER;
+	}
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterWriteBuf
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterWriteBuf(). The transfer is complete on return.
+*
+* Parameters:
+*  uint32 slaveAddress: 7-bit slave address.
+*  uint8 *wrData: Bytes to write.
+*  uint32 cnt: Number of bytes to write.
+*  uint32 mode: I2C_I2C_MODE_xxx bits of the transfer.
+*
+* Return:
+*  uint32: I2C_I2C_MSTR_NOT_READY if the bus is not in the state the mode
+*          expects, I2C_I2C_MSTR_NO_ERROR otherwise.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterWriteBuf(uint32 slaveAddress, uint8 *wrData, uint32 cnt, uint32 mode)
+{
+	uint32 status;
+	uint32 index;
+	
+	status = AccEmu_I2CMasterSendAddress(slaveAddress, I2C_I2C_WRITE_XFER_MODE, mode);
+	if(status != I2C_I2C_MSTR_NOT_READY)
+	{
+		for(index = 0u; (index < cnt) && (status == I2C_I2C_MSTR_NO_ERROR); index++)
+		{
+			status = AccEmu_I2CMasterWriteByte(wrData[index]);
+		}
+		AccEmu_I2CMasterEndBuf(status, mode, I2C_I2C_MSTAT_WR_CMPLT);
+		status = I2C_I2C_MSTR_NO_ERROR;
+	}
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterReadBuf
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterReadBuf(). Every byte but the last one is ACKed.
+*   The transfer is complete on return.
+*
+* Parameters:
+*  uint32 slaveAddress: 7-bit slave address.
+*  uint8 *rdData: Buffer for the bytes read.
+*  uint32 cnt: Number of bytes to read.
+*  uint32 mode: I2C_I2C_MODE_xxx bits of the transfer.
+*
+* Return:
+*  uint32: I2C_I2C_MSTR_NOT_READY if the bus is not in the state the mode
+*          expects, I2C_I2C_MSTR_NO_ERROR otherwise.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterReadBuf(uint32 slaveAddress, uint8 *rdData, uint32 cnt, uint32 mode)
+{
+	uint32 status;
+	uint32 index;
+	
+	status = AccEmu_I2CMasterSendAddress(slaveAddress, I2C_I2C_READ_XFER_MODE, mode);
+	if(status != I2C_I2C_MSTR_NOT_READY)
+	{
+		if(status == I2C_I2C_MSTR_NO_ERROR)
+		{
+			for(index = 0u; index < cnt; index++)
+			{
+				rdData[index] = (uint8)AccEmu_I2CMasterReadByte((index < (cnt - 1u)) ? 
+								I2C_I2C_ACK_DATA : I2C_I2C_NAK_DATA);
+			}
+		}
+		AccEmu_I2CMasterEndBuf(status, mode, I2C_I2C_MSTAT_RD_CMPLT);
+		status = I2C_I2C_MSTR_NO_ERROR;
+	}
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterStatus
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterStatus(). No transfer is ever in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32: I2C_I2C_MSTAT_xxx bits.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterStatus(void)
+{
+	return(AccEmu_masterStatus);
+}
+
+/*******************************************************************************
+* Function Name: AccEmu_I2CMasterClearStatus
+********************************************************************************
+* Summary:
+* 	Emulates I2C_I2CMasterClearStatus().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32: I2C_I2C_MSTAT_xxx bits before they were cleared.
+*
+*******************************************************************************/
+uint32 AccEmu_I2CMasterClearStatus(void)
+{
+	uint32 status = AccEmu_masterStatus;
+	
+	AccEmu_masterStatus = ZERO;
+	return(status);
+}
+
+#endif /* ACC_EMULATOR_ENABLED */
+
+/* [] END OF FILE */
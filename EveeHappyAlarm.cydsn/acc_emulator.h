@@ -0,0 +1,131 @@
+/*****************************************************************************
+* File Name: acc_emulator.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  acc_emulator.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(ACC_EMULATOR_H)
+#define ACC_EMULATOR_H
+
+#include "cytypes.h"
+#include "I2C_I2C.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* Change this define to 1 to run the accelerometer driver against the
+ * register-level emulator instead of the on-board accelerometer. The
+ * emulator replaces only the I2C master functions, so the driver code under
+ * test is the same code that runs on the board. The buffer functions run
+ * the whole transfer before returning, the caller then plays the part of
+ * the I2C interrupt. The
+ * host tests in test/ build the driver this way, with the PSoC Creator
+ * headers replaced by the stand-ins in test/stub. */
+#if !defined(ACC_EMULATOR_ENABLED)
+#define ACC_EMULATOR_ENABLED		0
+#endif
+
+/* Waveform shapes applied to every axis. */
+#define ACC_EMU_SHAPE_STILL			0x00u
+#define ACC_EMU_SHAPE_TRIANGLE		0x01u
+#define ACC_EMU_SHAPE_SQUARE		0x02u
+
+#define ACC_EMU_AXES				3u
+#define ACC_EMU_REG_COUNT			0x80u
+
+/* Redirect the I2C master functions to the emulator. This header must
+ * be included after the I2C Component header, which it includes itself. */
+#if (ACC_EMULATOR_ENABLED)
+	#define I2C_I2CMasterSendStart(addr, rw)	AccEmu_I2CMasterSendStart((addr), (rw))
+	#define I2C_I2CMasterSendRestart(addr, rw)	AccEmu_I2CMasterSendRestart((addr), (rw))
+	#define I2C_I2CMasterSendStop()				AccEmu_I2CMasterSendStop()
+	#define I2C_I2CMasterWriteByte(data)		AccEmu_I2CMasterWriteByte((data))
+	#define I2C_I2CMasterReadByte(ackNack)		AccEmu_I2CMasterReadByte((ackNack))
+	#define I2C_I2CMasterWriteBuf(addr, data, cnt, mode)	AccEmu_I2CMasterWriteBuf((addr), (data), (cnt), (mode))
+	#define I2C_I2CMasterReadBuf(addr, data, cnt, mode)		AccEmu_I2CMasterReadBuf((addr), (data), (cnt), (mode))
+	#define I2C_I2CMasterStatus()				AccEmu_I2CMasterStatus()
+	#define I2C_I2CMasterClearStatus()			AccEmu_I2CMasterClearStatus()
+#endif /* ACC_EMULATOR_ENABLED */
+
+/*****************************************************************************
+* Data Structure Definition
+*****************************************************************************/
+/* Motion applied to the emulated sensor, in mg. Each axis follows
+ * offset + amplitude * shape(t), where shape is in the range -1..+1. */
+typedef struct
+{
+	int16 offsetMg[ACC_EMU_AXES];
+	int16 amplitudeMg[ACC_EMU_AXES];
+	uint16 periodMs;
+	uint8 shape;
+} ACC_EMU_WAVEFORM;
+
+/* Bus activity seen by the emulator since the last AccEmu_ClearStats(). */
+typedef struct
+{
+	uint32 transactions;	/* START conditions                  */
+	uint32 restarts;		/* Repeated START conditions         */
+	uint32 addressBytes;	/* Address bytes, including NACKed   */
+	uint32 bytesWritten;	/* Data bytes written by the master  */
+	uint32 bytesRead;		/* Data bytes read by the master     */
+	uint32 nacks;			/* Addresses not acknowledged        */
+	uint32 protectedWrites;	/* Writes ignored because PC1 was 1  */
+	uint32 samples;			/* Output samples produced at the ODR */
+} ACC_EMU_STATS;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#if (ACC_EMULATOR_ENABLED)
+void AccEmu_Reset(void);
+void AccEmu_SetWaveform(const ACC_EMU_WAVEFORM *waveform);
+void AccEmu_AdvanceTime(uint32 elapsedUs);
+uint8 AccEmu_PeekRegister(uint8 reg);
+void AccEmu_GetStats(ACC_EMU_STATS *stats);
+void AccEmu_ClearStats(void);
+void AccEmu_SetNackAt(uint32 transaction, uint32 count);
+
+uint32 AccEmu_I2CMasterSendStart(uint32 slaveAddress, uint32 bitRnW);
+uint32 AccEmu_I2CMasterSendRestart(uint32 slaveAddress, uint32 bitRnW);
+uint32 AccEmu_I2CMasterSendStop(void);
+uint32 AccEmu_I2CMasterWriteByte(uint32 theByte);
+uint32 AccEmu_I2CMasterReadByte(uint32 ackNack);
+uint32 AccEmu_I2CMasterWriteBuf(uint32 slaveAddress, uint8 *wrData, uint32 cnt, uint32 mode);
+uint32 AccEmu_I2CMasterReadBuf(uint32 slaveAddress, uint8 *rdData, uint32 cnt, uint32 mode);
+uint32 AccEmu_I2CMasterStatus(void);
+uint32 AccEmu_I2CMasterClearStatus(void);
+#endif /* ACC_EMULATOR_ENABLED */
+
+#endif /* ACC_EMULATOR_H */
+
+/* [] END OF FILE */
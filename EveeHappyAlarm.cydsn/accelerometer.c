@@ -37,21 +37,98 @@
 *****************************************************************************/
 #include "accelerometer.h"
 #include "project.h"
+#include "acc_emulator.h"
+#include "swtimer.h"
 
 /*****************************************************************************
 * Local Function Prototypes
 *****************************************************************************/
 static uint8 Accelerometer_RegWrite(uint8 reg, uint8 value);
+static void Accelerometer_SelectBusRate(void);
+static uint8 Accelerometer_BurstWrite(uint8 reg, const uint8 *values, uint8 count);
+static uint8 Accelerometer_BurstRead(uint8 reg, uint8 *values, uint8 count);
+static void Accelerometer_ConvertSample(const uint8 *outData, uint16 rawMask, 
+										int16 *xData, int16 *yData, int16 *zData);
 
 
 /*****************************************************************************
 * Global Variable Declarations
 *****************************************************************************/
+const ACC_PROFILE Accelerometer_fastProfile = ACC_PROFILE_FAST;
+const ACC_PROFILE Accelerometer_precisionProfile = ACC_PROFILE_PRECISION;
 
 
 /*****************************************************************************
 * Local Global Variable Declarations
 *****************************************************************************/
+/* Accelerometer configuration, applied in order by InitializeAccelerometer().
+ * The registers from CTRL_REG2 to WAKEUP_THRESHOLD can only be changed while
+ * PC1 is 0, so CTRL_REG1 is written first in standby and last in operating
+ * mode. */
+static const ACC_REG_BLOCK AccConfigTable[] =
+{
+	/* CTRL_REG1 in standby mode:
+	 * RES (Resolution) 								= 12-bit mode
+	 * DRDYE (Report acceleration via Interrupt) 		= DISABLED
+	 * GSEL1, GSEL0 (Acceleration range of the output) 	= +/-2g
+	 * WUFE (Wake Up on Motion Detect) 					= ENABLED
+	 */
+	{ ACC_CTRL_REG_1, 1u, { ACC_RES_BIT_OR_MASK | ACC_WUFE_BIT_OR_MASK } },
+	
+	/* CTRL_REG2, INT_CTRL_REG1 and INT_CTRL_REG2 are consecutive:
+	 * SRST (Software Reset)							= FALSE
+	 * DCST (Digital Communication Self Test)	 		= DISABLED
+	 * OWUFA,OWUFB,OWUFC(Output Data Rate for Wakeup)	= 12.5 Hz
+	 * IEN (Physical Interrupt Pin)						= ENABLED
+	 * IEA (Interrupt Polarity)					 		= ACTIVE HIGH
+	 * IEL (Interrupt Latch/Pulse Enable)				= LATCH INTERRUPT
+	 * XNWU, XPWU, YNWU, YPWU, ZNWU, ZPWU (Direction)	= SENSING_ENABLED
+	 */
+	{ ACC_CTRL_REG_2, 3u, { ACC_OWUFA_BIT_OR_MASK, 
+							ACC_IEN_BIT_OR_MASK | ACC_IEA_BIT_OR_MASK,
+							ACC_XNWUE_BIT_OR_MASK | ACC_XPWUE_BIT_OR_MASK | ACC_YNWUE_BIT_OR_MASK | 
+							ACC_YPWUE_BIT_OR_MASK | ACC_ZNWUE_BIT_OR_MASK | ACC_ZPWUE_BIT_OR_MASK } },
+	
+	/* DATA_CTRL:
+	 * OSAA, OSAB, OSAC, OSAD (Output Data Rate)		= 50 Hz
+	 */
+	{ ACC_DATA_CTRL_REG, 1u, { ACC_OSAC_BIT_OR_MASK } },
+	
+	/* WAKEUP_TIMER (counts) = Desired Delay Time (sec) x OWUF (Hz) 
+	 * Wakeup Timer value	 = 0.02s * 50 = 1 count
+	 */
+	{ ACC_WAKEUP_TIMER, 1u, { ACC_WAKEUP_TIMER_VALUE } },
+	
+	/* WAKEUP_THRESHOLD (counts) = Desired Threshold (g) x 16 (counts/g) 
+	 * Wakeup Threshold value	 = (1/16)g * 16 = 1 count
+	 */
+	{ ACC_WAKUP_THRESHOLD, 1u, { ACC_WAKUP_THRESHOLD_VAL } },
+	
+	/* Put the Accelerometer in the Operating Mode */
+	{ ACC_CTRL_REG_1, 1u, { ACC_PC1_BIT_OR_MASK | ACC_RES_BIT_OR_MASK | ACC_WUFE_BIT_OR_MASK } },
+};
+
+#define ACC_CONFIG_TABLE_SIZE	(sizeof(AccConfigTable) / sizeof(AccConfigTable[0u]))
+
+/* Counts per g of each acceleration range in 12-bit mode. */
+static const uint16 AccRangeResolution[] = { G2_MODE_RESOLUTION, G4_MODE_RESOLUTION, G8_MODE_RESOLUTION };
+
+/* Profile in use, and the divider that scales the raw output to
+ * G2_MODE_RESOLUTION counts per g. */
+static ACC_PROFILE AccProfile = ACC_PROFILE_PRECISION;
+static int16 AccOutputDivider = ACC_RAW_SCALE;
+
+/* Sample read run from the I2C interrupt: the register address is written
+ * without a Stop, and the output registers are read after a repeated Start.
+ * The output registers are indexed from ACC_XOUT_L as in ReadAccelerometer(). */
+#define ACC_SAMPLE_PHASE_IDLE		0x00
+#define ACC_SAMPLE_PHASE_ADDRESS	0x01
+#define ACC_SAMPLE_PHASE_DATA		0x02
+
+static volatile uint8 AccSamplePhase = ACC_SAMPLE_PHASE_IDLE;
+static uint8 AccSampleReg;
+static uint8 AccSampleData[ACC_OUT_BLOCK_LEN];
+
 
 
 /*******************************************************************************
@@ -62,53 +139,168 @@ static uint8 Accelerometer_RegWrite(uint8 reg, uint8 value);
 *
 * Parameters:
 *  uint8 reg: Register to which data is to be written.
-*  uint8 *value: Variable which holds the data to be written.
+*  uint8 value: Data to be written.
 *
 * Return:
 *  uint8: Status of write operation
 *
 *******************************************************************************/
 static uint8 Accelerometer_RegWrite(uint8 reg, uint8 value)
+{
+	return(Accelerometer_BurstWrite(reg, &value, 1u));
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_RegRead
+********************************************************************************
+* Summary:
+* 	Read a single byte from a specified register location.
+*
+* Parameters:
+*  uint8 reg: Register from where data is to be read.
+*  uint8 *value: Variable to which the data from register is stored.
+*
+* Return:
+*  uint8: Status of read operation
+*
+*******************************************************************************/
+uint8 Accelerometer_RegRead(uint8 reg, uint8 *value)
+{
+	return(Accelerometer_BurstRead(reg, value, 1u));
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_BurstWrite
+********************************************************************************
+* Summary:
+* 	Writes consecutive registers in one I2C transfer, using the register
+*   auto-increment of the accelerometer.
+*
+* Parameters:
+*  uint8 reg: First register to which data is to be written.
+*  const uint8 *values: Data to be written.
+*  uint8 count: Number of registers to write.
+*
+* Return:
+*  uint8: Status of write operation
+*
+*******************************************************************************/
+static uint8 Accelerometer_BurstWrite(uint8 reg, const uint8 *values, uint8 count)
 {
 	uint8 ackStatus = COMM_FAIL;
+	uint8 index;
+	
 	ackStatus = I2C_I2CMasterSendStart(ACCELEROMETER_ADDR, ACC_WRITE);
 	if(ackStatus == I2C_I2C_MSTR_NO_ERROR)
 	{
 		ackStatus = I2C_I2CMasterWriteByte(reg);
-		ackStatus = I2C_I2CMasterWriteByte(value);
+		for(index = 0u; (index < count) && (ackStatus == I2C_I2C_MSTR_NO_ERROR); index++)
+		{
+			ackStatus = I2C_I2CMasterWriteByte(values[index]);
+		}
+	}
+	
+	/* Keep the first error, the Stop is always sent to release the bus. */
+	if(ackStatus == I2C_I2C_MSTR_NO_ERROR)
+	{
+		ackStatus = I2C_I2CMasterSendStop();
+	}
+	else
+	{
+		(void) I2C_I2CMasterSendStop();
 	}
-	ackStatus = I2C_I2CMasterSendStop();
 	return(ackStatus);
 }
 
 /*******************************************************************************
-* Function Name: Accelerometer_RegRead
+* Function Name: Accelerometer_BurstRead
 ********************************************************************************
 * Summary:
-* 	Read a single byte from a specified register location.
+* 	Reads consecutive registers in one I2C transfer, using the register
+*   auto-increment of the accelerometer.
 *
 * Parameters:
-*  uint8 reg: Register from where data is to be read.
-*  uint8 *value: Variable to which the data from register is stored.
+*  uint8 reg: First register from where data is to be read.
+*  uint8 *values: Buffer to which the data from the registers is stored.
+*  uint8 count: Number of registers to read.
 *
 * Return:
 *  uint8: Status of read operation
 *
 *******************************************************************************/
-uint8 Accelerometer_RegRead(uint8 reg, uint8 *value)
+static uint8 Accelerometer_BurstRead(uint8 reg, uint8 *values, uint8 count)
 {
 	uint8 ackStatus = COMM_FAIL;
+	uint8 index;
+	
 	ackStatus = I2C_I2CMasterSendStart(ACCELEROMETER_ADDR, ACC_WRITE);
 	if(ackStatus == I2C_I2C_MSTR_NO_ERROR)
 	{
 		ackStatus = I2C_I2CMasterWriteByte(reg);
-		ackStatus = I2C_I2CMasterSendRestart(ACCELEROMETER_ADDR, ACC_READ);
-		*value = I2C_I2CMasterReadByte(I2C_I2C_NAK_DATA);
+		if(ackStatus == I2C_I2C_MSTR_NO_ERROR)
+		{
+			ackStatus = I2C_I2CMasterSendRestart(ACCELEROMETER_ADDR, ACC_READ);
+		}
+		if(ackStatus == I2C_I2C_MSTR_NO_ERROR)
+		{
+			/* ACK every byte except the last one. */
+			for(index = 0u; index < count; index++)
+			{
+				values[index] = (uint8)I2C_I2CMasterReadByte((index < (count - 1u)) ? 
+								I2C_I2C_ACK_DATA : I2C_I2C_NAK_DATA);
+			}
+		}
+	}
+	
+	if(ackStatus == I2C_I2C_MSTR_NO_ERROR)
+	{
+		ackStatus = I2C_I2CMasterSendStop();
+	}
+	else
+	{
+		(void) I2C_I2CMasterSendStop();
 	}
-	ackStatus = I2C_I2CMasterSendStop();
 	return(ackStatus);
 }
 
+/*******************************************************************************
+* Function Name: Accelerometer_WaitReady
+********************************************************************************
+* Summary:
+* 	Polls the accelerometer until it answers on the bus with the expected
+*   WHO_AM_I and DCST_RESP values, instead of waiting for the worst-case
+*   start-up time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8: ACC_PASS if the accelerometer is ready, ACC_FAIL on time-out.
+*
+*******************************************************************************/
+uint8 Accelerometer_WaitReady(void)
+{
+	uint8 accStatus = ACC_FAIL;
+	uint8 accRegValue = ZERO;
+	uint16 elapsed;
+	
+	for(elapsed = 0u; (elapsed < ACC_STARTUP_TIMEOUT) && (accStatus == ACC_FAIL); elapsed += ACC_READY_POLL_INTERVAL)
+	{
+		if((Accelerometer_RegRead(ACC_WHO_AM_I, &accRegValue) == COMM_PASS) && 
+		   (accRegValue == ACC_WHO_AM_I_VAL) &&
+		   (Accelerometer_RegRead(ACC_DCST_RESP, &accRegValue) == COMM_PASS) &&
+		   (accRegValue == ACC_SELF_TEST_VAL_1))
+		{
+			accStatus = ACC_PASS;
+		}
+		else
+		{
+			SwTimer_Delay(ACC_READY_POLL_INTERVAL);
+		}
+	}
+	return(accStatus);
+}
+
 /*******************************************************************************
 * Function Name: Accelerometer_SelfTest
 ********************************************************************************
@@ -162,11 +354,58 @@ uint8 Accelerometer_SelfTest(void)
 	return(accStatus);
 }
 
+/*******************************************************************************
+* Function Name: Accelerometer_SelectBusRate
+********************************************************************************
+* Summary:
+* 	Switches the I2C bus to the fastest data rate at which the accelerometer
+*   still ACKs and returns the same WHO_AM_I value as at Standard-mode.
+*   Shorter transfers reduce the time spent awake for every sample.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Accelerometer_SelectBusRate(void)
+{
+	static const uint32 rateList[ACC_I2C_RATE_COUNT] = ACC_I2C_RATE_LIST;
+	uint8 referenceValue = ZERO;
+	uint8 accRegValue = ZERO;
+	uint8 index;
+	
+	/* Read the reference value at the rate known to work. */
+	if(Accelerometer_RegRead(ACC_WHO_AM_I, &referenceValue) == COMM_PASS)
+	{
+		for(index = 0u; index < ACC_I2C_RATE_COUNT; index++)
+		{
+			if(I2CBus_SetDataRate(rateList[index], ACCELEROMETER_ADDR) == I2CBUS_RATE_OK)
+			{
+				if((Accelerometer_RegRead(ACC_WHO_AM_I, &accRegValue) == COMM_PASS) && 
+				   (accRegValue == referenceValue))
+				{
+					break;
+				}
+			}
+		}
+		
+		if(index == ACC_I2C_RATE_COUNT)
+		{
+			/* No faster rate is reliable, stay at Standard-mode. */
+			(void) I2CBus_SetDataRate(I2CBUS_RATE_SM, 0u);
+		}
+	}
+}
+
 /*******************************************************************************
 * Function Name: InitializeAccelerometer
 ********************************************************************************
 * Summary:
 * 	Initializes the accelerometer control registers for proper operation.
+*   The configuration is applied from AccConfigTable, with one burst write
+*   per block of consecutive registers.
 *
 * Parameters:
 *  void
@@ -180,229 +419,127 @@ void InitializeAccelerometer(void)
 	uint8 accWorkStatus = ACC_FAIL;
 	uint8 accRegValue = ZERO;
 	uint8 commStatus = COMM_FAIL;
+	uint8 index;
 	
 	/* Ensure proper functioning of hardware */
 	accWorkStatus = Accelerometer_SelfTest();
 	
-	
 	if(accWorkStatus == ACC_PASS)
 	{
-		/* Initialize the CTRL_REG1 after putting the accelerometer in standby mode. */
-		accRegValue = accRegValue & ACC_PC1_BIT_AND_MASK;
-		commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_1, accRegValue);
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Modify the current value for the following settings:
-			 * RES (Resolution) 								= 12-bit mode
-			 * DRDYE (Report acceleration via Interrupt) 		= DISABLED
-			 * GSEL1, GSEL0 (Acceleration range of the output) 	= +/-2g
-			 * WUFE (Wake Up on Motion Detect) 					= ENABLED
-			 */
-			accRegValue = accRegValue | ACC_RES_BIT_OR_MASK | ACC_WUFE_BIT_OR_MASK;
-			accRegValue = accRegValue & ACC_GSEL0_BIT_AND_MASK & ACC_GSEL1_BIT_AND_MASK & ACC_DRDYE_BIT_AND_MASK;
-			
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_1, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Initialize the CTRL_REG2 */
-			/* Read the current value of the CTRL_REG2 register */
-			commStatus = Accelerometer_RegRead(ACC_CTRL_REG_2, &accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Modify the current value for the following settings:
-			 * SRST (Software Reset)							= FALSE
-			 * DCST (Digital Communication Self Test)	 		= DISABLED
-			 * OWUFA,OWUFB,OWUFC(Output Data Rate for Wakeup)	= 12.5 Hz
-			 */
-			accRegValue = accRegValue | ACC_OWUFA_BIT_OR_MASK;
-			accRegValue = accRegValue & ACC_SRST_BIT_AND_MASK & ACC_DCST_BIT_AND_MASK & ACC_OWUFB_BIT_AND_MASK & ACC_OWUFC_BIT_AND_MASK;
-
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_2, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Read the current value of the INT_CTRL_REG1 register */
-			commStatus = Accelerometer_RegRead(ACC_INT_CTRL_REG_1, &accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Modify the current value for the following settings:
-			 * IEN (Physical Interrupt Pin)						= ENABLED
-			 * IEA (Interrupt Polarity)					 		= ACTIVE HIGH
-			 * IEL (Interrupt Latch/Pulse Enable)				= LATCH INTERRUPT
-			 */
-			accRegValue = accRegValue | ACC_IEN_BIT_OR_MASK | ACC_IEA_BIT_OR_MASK;
-			accRegValue = accRegValue & ACC_IEL_BIT_AND_MASK;
-			
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_INT_CTRL_REG_1, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Read the current value of the INT_CTRL_REG2 register */
-			commStatus = Accelerometer_RegRead(ACC_INT_CTRL_REG_2, &accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Modify the current value for the following settings:
-			 * XNWU, XPWU, YNWU, YPWU, ZNWU, ZPWU (Direction)	= SENSING_ENABLED
-			 */
-			accRegValue = accRegValue | ACC_XNWUE_BIT_OR_MASK | ACC_XPWUE_BIT_OR_MASK | \
-			ACC_YNWUE_BIT_OR_MASK | ACC_YPWUE_BIT_OR_MASK | ACC_ZNWUE_BIT_OR_MASK | ACC_ZPWUE_BIT_OR_MASK;
-			
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_INT_CTRL_REG_2, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Read the current value of the DATA_CTRL register */
-			commStatus = Accelerometer_RegRead(ACC_DATA_CTRL_REG, &accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Modify the current value for the following settings:
-			 * OSAA, OSAB, OSAC, OSAD (Output Data Rate)		= 50 Hz
-			 */
-			accRegValue = accRegValue | ACC_OSAC_BIT_OR_MASK;
-			accRegValue = accRegValue & ACC_OSAA_BIT_AND_MASK & ACC_OSAB_BIT_AND_MASK & ACC_OSAD_BIT_AND_MASK;
-			
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_DATA_CTRL_REG, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
+		/* Use the fastest I2C data rate supported on this board. */
+		Accelerometer_SelectBusRate();
 		
-		if(commStatus == COMM_PASS)
+		commStatus = COMM_PASS;
+		for(index = 0u; (index < ACC_CONFIG_TABLE_SIZE) && (commStatus == COMM_PASS); index++)
 		{
-			/* Read the current value of the WAKEUP_TIMER register */
-			commStatus = Accelerometer_RegRead(ACC_WAKEUP_TIMER, &accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
+			commStatus = Accelerometer_BurstWrite(AccConfigTable[index].reg, 
+						 AccConfigTable[index].values, AccConfigTable[index].count);
 		}
 		
 		if(commStatus == COMM_PASS)
 		{
-			/* Modify the current value for the following settings:
-			 * Wakeup Timer value	 = 0.02s * 50 = 1 count
-			 * WAKEUP_TIMER (counts) = Desired Delay Time (sec) x OWUF (Hz) 
-			 */
-			accRegValue = ACC_WAKEUP_TIMER_VALUE;
+			/* Set the flag to indicate the accelerometer is configured. */
+			acclerometer_configured = TRUE;
 			
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_WAKEUP_TIMER, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
-		if(commStatus == COMM_PASS)
-		{
-			/* Read the current value of the ACC_WAKUP_THRESHOLD register */
-			commStatus = Accelerometer_RegRead(ACC_WAKUP_THRESHOLD, &accRegValue);
+			/* Clear all pending interrupts from accelerometer. */
+			Accelerometer_RegRead(ACC_INT_REL, &accRegValue);
 		}
-		else
+	}	
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_SetProfile
+********************************************************************************
+* Summary:
+* 	Changes the resolution, range and output data rate of the accelerometer.
+*   RES and GSEL can only be changed in standby, so CTRL_REG1 is first
+*   written with only PC1 cleared, then with the new RES and GSEL bits, and
+*   PC1 is set again once DATA_CTRL is written. The other CTRL_REG1 bits,
+*   such as the wake-up function, are kept.
+*
+*   If a write fails, the previous profile is written back. If that also
+*   fails, the accelerometer may be left in standby, so
+*   acclerometer_configured is cleared to stop the sampling until the
+*   accelerometer is initialized again.
+*
+* Parameters:
+*  const ACC_PROFILE *profile: Profile to apply.
+*
+* Return:
+*  uint8: COMM_PASS if the profile is in use, otherwise COMM_FAIL.
+*
+*******************************************************************************/
+uint8 Accelerometer_SetProfile(const ACC_PROFILE *profile)
+{
+	uint8 commStatus = COMM_FAIL;
+	uint8 prevCtrlValue = ZERO;
+	uint8 ctrlValue;
+	
+	commStatus = Accelerometer_RegRead(ACC_CTRL_REG_1, &prevCtrlValue);
+	if(commStatus == COMM_PASS)
+	{
+		ctrlValue = (uint8)(prevCtrlValue & ACC_PC1_BIT_AND_MASK & ACC_RES_BIT_AND_MASK & 
+							ACC_GSEL1_BIT_AND_MASK & ACC_GSEL0_BIT_AND_MASK);
+		ctrlValue |= (uint8)(profile->range << ACC_GSEL_SHIFT);
+		if(profile->resolution == ACC_RES_12BIT)
 		{
-			commStatus = COMM_FAIL;
+			ctrlValue |= ACC_RES_BIT_OR_MASK;
 		}
 		
+		commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_1, prevCtrlValue & ACC_PC1_BIT_AND_MASK);
 		if(commStatus == COMM_PASS)
 		{
-			/* Modify the current value for the following settings:
-			 * Wakeup Timer value								= (1/16)g * 16 = 1 count
-			 * WAKEUP_THRESHOLD (counts) 						= Desired Threshold (g) x 16 (counts/g) 
-			 */
-			accRegValue = ACC_WAKUP_THRESHOLD_VAL;
-			
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_WAKUP_THRESHOLD, accRegValue);
+			commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_1, ctrlValue);
 		}
-		else
-		{
-			commStatus = COMM_FAIL;
-		}
-		
 		if(commStatus == COMM_PASS)
 		{
-			/* Read the current value of the CTRL_REG1 register */
-			commStatus = Accelerometer_RegRead(ACC_CTRL_REG_1, &accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
+			commStatus = Accelerometer_RegWrite(ACC_DATA_CTRL_REG, profile->odr);
 		}
-		
 		if(commStatus == COMM_PASS)
 		{
-			/* Put the Accelerometer in the Operating Mode */
-			accRegValue = accRegValue | ACC_PC1_BIT_OR_MASK;
-					
-			/* Write back the modified value. */
-			commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_1, accRegValue);
-		}
-		else
-		{
-			commStatus = COMM_FAIL;
+			commStatus = Accelerometer_RegWrite(ACC_CTRL_REG_1, ctrlValue | ACC_PC1_BIT_OR_MASK);
 		}
 		
-		if(commStatus == COMM_PASS)
+		if(commStatus != COMM_PASS)
 		{
-			/* Set the flag to indicate the accelerometer is configured. */
-			acclerometer_configured = TRUE;
-			
-			/* Clear all pending interrupts from accelerometer. */
-			Accelerometer_RegRead(ACC_INT_REL, &accRegValue);
+			/* Write back the previous profile, from standby. */
+			if((Accelerometer_RegWrite(ACC_CTRL_REG_1, prevCtrlValue & ACC_PC1_BIT_AND_MASK) != COMM_PASS) ||
+			   (Accelerometer_RegWrite(ACC_DATA_CTRL_REG, AccProfile.odr) != COMM_PASS) ||
+			   (Accelerometer_RegWrite(ACC_CTRL_REG_1, prevCtrlValue) != COMM_PASS))
+			{
+				acclerometer_configured = FALSE;
+			}
 		}
-	}	
+	}
+	
+	if(commStatus == COMM_PASS)
+	{
+		AccProfile = *profile;
+		AccOutputDivider = (int16)((ACC_RAW_SCALE * AccRangeResolution[profile->range]) / G2_MODE_RESOLUTION);
+	}
+	else
+	{
+		commStatus = COMM_FAIL;
+	}
+	return(commStatus);
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_GetProfile
+********************************************************************************
+* Summary:
+* 	Returns the profile currently used by the accelerometer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  const ACC_PROFILE *: Current profile.
+*
+*******************************************************************************/
+const ACC_PROFILE * Accelerometer_GetProfile(void)
+{
+	return(&AccProfile);
 }
 
 /*******************************************************************************
@@ -410,6 +547,9 @@ void InitializeAccelerometer(void)
 ********************************************************************************
 * Summary:
 * 	Reads the accelerometer acceleration values in x, y, and z directions.
+*   All output registers are read in one transfer. In 8-bit mode only the
+*   high bytes are read. The values are scaled to G2_MODE_RESOLUTION counts
+*   per g whatever the profile, and are left unchanged if the read fails.
 *
 * Parameters:
 *  int16 *xData: Pointer to the variable in which the acceleration data 
@@ -427,53 +567,176 @@ void InitializeAccelerometer(void)
 *******************************************************************************/
 void ReadAccelerometer(int16 *xData, int16 *yData, int16 *zData)
 {
-	/* Temporary variable for extracting only the 12 most significant
-	 * bits of accelerometer data registers. */
-	uint8 tempVal = ZERO;
+	/* Output registers, indexed from ACC_XOUT_L. */
+	uint8 outData[ACC_OUT_BLOCK_LEN] = { ZERO };
+	uint8 commStatus = COMM_FAIL;
+	uint16 rawMask;
 	
-	Accelerometer_RegRead(ACC_XOUT_H, &tempVal);
-	*xData = tempVal;
-	Accelerometer_RegRead(ACC_XOUT_L, &tempVal);
-	*xData = (*xData << 8) | tempVal;
-	if((*xData & 0x8000) == 0x8000)
+	if(AccProfile.resolution == ACC_RES_8BIT)
 	{
-		*xData = *xData >> 4;
-		*xData |= 0xF000;
+		commStatus = Accelerometer_BurstRead(ACC_XOUT_H, &outData[ACC_XOUT_H - ACC_XOUT_L], ACC_OUT_HIGH_BLOCK_LEN);
+		rawMask = ACC_RAW_MASK_8BIT;
 	}
 	else
 	{
-		*xData = *xData >> 4;
+		commStatus = Accelerometer_BurstRead(ACC_XOUT_L, outData, ACC_OUT_BLOCK_LEN);
+		rawMask = ACC_RAW_MASK_12BIT;
 	}
 	
-	Accelerometer_RegRead(ACC_YOUT_H, &tempVal);
-	*yData = tempVal;
-	Accelerometer_RegRead(ACC_YOUT_L, &tempVal);
-	*yData = (*yData << 8) | tempVal;
-	
-	if((*yData & 0x8000) == 0x8000)
+	if(commStatus == COMM_PASS)
 	{
-		*yData = *yData >> 4;
-		*yData |= 0xF000;
+		Accelerometer_ConvertSample(outData, rawMask, xData, yData, zData);
 	}
-	else
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_ConvertSample
+********************************************************************************
+* Summary:
+* 	Converts the output registers to G2_MODE_RESOLUTION counts per g.
+*
+* Parameters:
+*  const uint8 *outData: Output registers, indexed from ACC_XOUT_L.
+*  uint16 rawMask: Bits of the left justified value that carry data.
+*  int16 *xData, *yData, *zData: Converted acceleration of each axis.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Accelerometer_ConvertSample(const uint8 *outData, uint16 rawMask, 
+										int16 *xData, int16 *yData, int16 *zData)
+{
+	int16 *axisData[ACC_AXES];
+	uint16 rawValue;
+	uint8 axis;
+	
+	axisData[0u] = xData;
+	axisData[1u] = yData;
+	axisData[2u] = zData;
+	
+	for(axis = 0u; axis < ACC_AXES; axis++)
 	{
-		*yData = *yData >> 4;
+		/* The unused low bits are cleared so that the division is exact
+		 * and keeps the sign. */
+		rawValue = (uint16)(((uint16)outData[(axis * 2u) + 1u] << 8u) | outData[axis * 2u]) & rawMask;
+		*axisData[axis] = (int16)rawValue / AccOutputDivider;
 	}
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_StartSample
+********************************************************************************
+* Summary:
+* 	Starts reading the output registers without waiting for the bus. The
+*   transfer is then carried on by the I2C interrupt, which must call
+*   Accelerometer_ServiceSample() after the component interrupt handler.
+*   Can be called from an interrupt. The blocking functions of this file must
+*   not be used while sampling runs.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8: ACC_PASS if the transfer started, ACC_FAIL if a sample read or
+*         another transfer is still in progress, or the bus is not free.
+*
+*******************************************************************************/
+uint8 Accelerometer_StartSample(void)
+{
+	uint8 accStatus = ACC_FAIL;
 	
-	Accelerometer_RegRead(ACC_ZOUT_H, &tempVal);
-	*zData = tempVal;
-	Accelerometer_RegRead(ACC_ZOUT_L, &tempVal);
-	*zData = (*zData << 8) | tempVal;
+	if((AccSamplePhase == ACC_SAMPLE_PHASE_IDLE) && 
+		((I2C_I2CMasterStatus() & I2C_I2C_MSTAT_XFER_INP) == 0u))
+	{
+		AccSampleReg = (AccProfile.resolution == ACC_RES_8BIT) ? ACC_XOUT_H : ACC_XOUT_L;
+		
+		(void) I2C_I2CMasterClearStatus();
+		AccSamplePhase = ACC_SAMPLE_PHASE_ADDRESS;
+		if(I2C_I2CMasterWriteBuf(ACCELEROMETER_ADDR, &AccSampleReg, 1u, 
+			I2C_I2C_MODE_NO_STOP) == I2C_I2C_MSTR_NO_ERROR)
+		{
+			accStatus = ACC_PASS;
+		}
+		else
+		{
+			AccSamplePhase = ACC_SAMPLE_PHASE_IDLE;
+		}
+	}
+	return(accStatus);
+}
+
+/*******************************************************************************
+* Function Name: Accelerometer_ServiceSample
+********************************************************************************
+* Summary:
+* 	Moves the sample read started by Accelerometer_StartSample() on once the
+*   current part of the transfer completes. Called from the I2C interrupt,
+*   after the component interrupt handler. The values are converted as in
+*   ReadAccelerometer() and are left unchanged unless the sample is ready.
+*
+* Parameters:
+*  int16 *xData, *yData, *zData: Acceleration of each axis.
+*
+* Return:
+*  uint8: ACC_SAMPLE_READY when the values are written, ACC_SAMPLE_FAILED if
+*         the transfer failed, ACC_SAMPLE_BUSY while it is in progress and
+*         ACC_SAMPLE_IDLE if no sample read was started.
+*
+*******************************************************************************/
+uint8 Accelerometer_ServiceSample(int16 *xData, int16 *yData, int16 *zData)
+{
+	uint32 masterStatus = I2C_I2CMasterStatus();
+	uint8 sampleStatus = ACC_SAMPLE_BUSY;
+	uint8 offset;
+	uint8 count;
 	
-	if((*zData & 0x8000) == 0x8000)
+	if(AccSamplePhase == ACC_SAMPLE_PHASE_IDLE)
+	{
+		sampleStatus = ACC_SAMPLE_IDLE;
+	}
+	else if((masterStatus & I2C_I2C_MSTAT_ERR_XFER) != 0u)
+	{
+		/* The component ends a failed read with a Stop, but only halts a
+		 * failed address write, as it is started without a Stop. */
+		if(AccSamplePhase == ACC_SAMPLE_PHASE_ADDRESS)
+		{
+			(void) I2C_I2CMasterSendStop();
+		}
+		AccSamplePhase = ACC_SAMPLE_PHASE_IDLE;
+		sampleStatus = ACC_SAMPLE_FAILED;
+	}
+	else if((AccSamplePhase == ACC_SAMPLE_PHASE_ADDRESS) && 
+			((masterStatus & I2C_I2C_MSTAT_WR_CMPLT) != 0u))
+	{
+		offset = AccSampleReg - ACC_XOUT_L;
+		count = (offset == 0u) ? ACC_OUT_BLOCK_LEN : ACC_OUT_HIGH_BLOCK_LEN;
+		
+		(void) I2C_I2CMasterClearStatus();
+		AccSamplePhase = ACC_SAMPLE_PHASE_DATA;
+		if(I2C_I2CMasterReadBuf(ACCELEROMETER_ADDR, &AccSampleData[offset], count, 
+			I2C_I2C_MODE_REPEAT_START) != I2C_I2C_MSTR_NO_ERROR)
+		{
+			/* The bus is still held after the address write. */
+			(void) I2C_I2CMasterSendStop();
+			AccSamplePhase = ACC_SAMPLE_PHASE_IDLE;
+			sampleStatus = ACC_SAMPLE_FAILED;
+		}
+	}
+	else if((AccSamplePhase == ACC_SAMPLE_PHASE_DATA) && 
+			((masterStatus & I2C_I2C_MSTAT_RD_CMPLT) != 0u))
 	{
-		*zData = *zData >> 4;
-		*zData |= 0xF000;
+		AccSamplePhase = ACC_SAMPLE_PHASE_IDLE;
+		Accelerometer_ConvertSample(AccSampleData, 
+									(AccSampleReg == ACC_XOUT_L) ? ACC_RAW_MASK_12BIT : ACC_RAW_MASK_8BIT, 
+									xData, yData, zData);
+		sampleStatus = ACC_SAMPLE_READY;
 	}
 	else
 	{
-		*zData = *zData >> 4;
+		/* Interrupt for a part of the transfer that is not complete yet. */
 	}
+	return(sampleStatus);
 }
 
 /* [] END OF FILE */
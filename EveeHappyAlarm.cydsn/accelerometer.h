@@ -38,6 +38,7 @@
 #define ACCELEROMETER_H 
 
 #include "cytypes.h"
+#include "i2cbus.h"
 
 /*****************************************************************************
 * MACRO Definition
@@ -52,6 +53,51 @@
 
 #define ACCELEROMETER_MODE		G2_MODE
 
+/* Output resolution selected by the RES bit of CTRL_REG1. */
+#define ACC_RES_8BIT			0x00
+#define ACC_RES_12BIT			0x01
+
+/* Output data rates, written to the OSA bits of DATA_CTRL_REG. */
+#define ACC_ODR_12_5HZ			0x00
+#define ACC_ODR_25HZ			0x01
+#define ACC_ODR_50HZ			0x02
+#define ACC_ODR_100HZ			0x03
+#define ACC_ODR_200HZ			0x04
+#define ACC_ODR_400HZ			0x05
+#define ACC_ODR_800HZ			0x06
+#define ACC_ODR_1600HZ			0x07
+
+/* Position of the GSEL0 bit in CTRL_REG1. */
+#define ACC_GSEL_SHIFT			3
+
+/* The output registers hold the acceleration left justified in 16 bits.
+ * ReadAccelerometer() scales every profile to G2_MODE_RESOLUTION counts
+ * per g, by dividing the raw value by this factor times the range
+ * resolution relative to G2_MODE_RESOLUTION. */
+#define ACC_RAW_SCALE			16
+
+/* Number of output registers from XOUT_L to ZOUT_H, and from XOUT_H to
+ * ZOUT_H. In 8-bit mode only the high bytes carry data. */
+#define ACC_OUT_BLOCK_LEN		6
+#define ACC_OUT_HIGH_BLOCK_LEN	5
+#define ACC_AXES				3
+
+/* Bits of the left justified output that carry data in each resolution. */
+#define ACC_RAW_MASK_8BIT		0xFF00u
+#define ACC_RAW_MASK_12BIT		0xFFF0u
+
+/* Progress of a sample read, returned by Accelerometer_ServiceSample(). */
+#define ACC_SAMPLE_IDLE			0x00
+#define ACC_SAMPLE_BUSY			0x01
+#define ACC_SAMPLE_READY		0x02
+#define ACC_SAMPLE_FAILED		0x03
+
+/* Data profiles. The fast profile reads only the high bytes of the output
+ * registers and runs the sensor in its low power mode. The precision profile
+ * is the configuration applied by InitializeAccelerometer(). */
+#define ACC_PROFILE_FAST		{ ACC_RES_8BIT, G2_MODE, ACC_ODR_50HZ }
+#define ACC_PROFILE_PRECISION	{ ACC_RES_12BIT, ACCELEROMETER_MODE, ACC_ODR_50HZ }
+
 #define ACCELEROMETER_ADDR		0x0F
 
 #define ACC_XOUT_L				0x06
@@ -66,6 +112,7 @@
 #define ACC_DCST_RESP			0x0C
 
 #define ACC_WHO_AM_I			0x0F
+#define ACC_WHO_AM_I_VAL		0x09
 
 #define ACC_INT_SRC_1			0x16
 #define ACC_INT_SRC_2			0x17
@@ -164,6 +211,20 @@
 
 #define ACC_NO_MOVEMENT			0x0000
 
+/* Maximum time to wait for the accelerometer after power-up, and the
+ * interval between two readiness polls, in milliseconds. */
+#define ACC_STARTUP_TIMEOUT		700
+#define ACC_READY_POLL_INTERVAL	1
+
+/* Largest number of consecutive registers written in one transfer. */
+#define ACC_MAX_BURST_LEN		3
+
+/* I2C data rates tried after the self-test, fastest first. The accelerometer
+ * supports Fast-mode Plus, the rate actually used is the first one at which
+ * the accelerometer ACKs and returns a consistent WHO_AM_I value. */
+#define ACC_I2C_RATE_LIST		{ I2CBUS_RATE_FMP, I2CBUS_RATE_FM }
+#define ACC_I2C_RATE_COUNT		2u
+
 #define ZERO					0x00	
 	
 #define TRUE					0x01
@@ -181,12 +242,29 @@
 /*****************************************************************************
 * Data Structure Definition
 *****************************************************************************/
+/* Block of consecutive accelerometer registers written in one transfer. */
+typedef struct
+{
+	uint8 reg;
+	uint8 count;
+	uint8 values[ACC_MAX_BURST_LEN];
+} ACC_REG_BLOCK;
+
+/* Resolution, range and output data rate used by the accelerometer. */
+typedef struct
+{
+	uint8 resolution;	/* ACC_RES_8BIT or ACC_RES_12BIT      */
+	uint8 range;		/* G2_MODE, G4_MODE or G8_MODE        */
+	uint8 odr;			/* One of the ACC_ODR_xxx values      */
+} ACC_PROFILE;
 
 
 /*****************************************************************************
 * Global Variable Declaration
 *****************************************************************************/
 extern uint8 acclerometer_configured;
+extern const ACC_PROFILE Accelerometer_fastProfile;
+extern const ACC_PROFILE Accelerometer_precisionProfile;
 
 /*****************************************************************************
 * Function Prototypes
@@ -194,6 +272,11 @@ extern uint8 acclerometer_configured;
 void InitializeAccelerometer(void);
 void ReadAccelerometer(int16 *xData, int16 *yData, int16 *zData);
 uint8 Accelerometer_RegRead(uint8 reg, uint8 *value);
+uint8 Accelerometer_WaitReady(void);
+uint8 Accelerometer_SetProfile(const ACC_PROFILE *profile);
+const ACC_PROFILE * Accelerometer_GetProfile(void);
+uint8 Accelerometer_StartSample(void);
+uint8 Accelerometer_ServiceSample(int16 *xData, int16 *yData, int16 *zData);
 
 /*****************************************************************************
 * External Function Prototypes
@@ -0,0 +1,212 @@
+/*****************************************************************************
+* File Name: i2cbus.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides functions to change the data rate of the I2C master
+*  at run time. The SCB clock divider, the oversampling factors and the
+*  input filters are reprogrammed together so that the bus timing stays
+*  within the I2C specification for the selected mode.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "i2cbus.h"
+#include "project.h"
+#include "acc_emulator.h"
+
+/*****************************************************************************
+* Local Function Prototypes
+*****************************************************************************/
+static void I2CBus_ApplyTiming(uint32 scbClkKhz, uint32 ovsLow, uint32 ovsHigh, uint32 rateKbps);
+
+
+/*****************************************************************************
+* Local Global Variable Declarations
+*****************************************************************************/
+/* Data rate currently programmed into the SCB. The Component is configured
+ * for Standard-mode in the design. */
+static uint32 I2CBus_dataRate = I2CBUS_RATE_SM;
+
+
+/*******************************************************************************
+* Function Name: I2CBus_ApplyTiming
+********************************************************************************
+* Summary:
+* 	Disables the SCB, reprograms the SCBCLK divider, the oversampling factors
+*   and the input filters, and enables the SCB again.
+*
+* Parameters:
+*  uint32 scbClkKhz: Required SCB clock frequency in kHz.
+*  uint32 ovsLow: Oversampling factor for the SCL low phase.
+*  uint32 ovsHigh: Oversampling factor for the SCL high phase.
+*  uint32 rateKbps: Resulting data rate, used to select the input filters.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void I2CBus_ApplyTiming(uint32 scbClkKhz, uint32 ovsLow, uint32 ovsHigh, uint32 rateKbps)
+{
+	uint32 divider;
+	uint32 regValue;
+	
+	/* Round the divider up so that the SCBCLK never exceeds the maximum
+	 * frequency allowed for the selected mode. */
+	divider = (CYDEV_BCLK__HFCLK__KHZ + scbClkKhz - 1u) / scbClkKhz;
+	
+	/* The SCB must be disabled while the clock and timing are changed. */
+	I2C_Stop();
+	
+	I2C_SCBCLK_SetFractionalDividerRegister((uint16)(divider - 1u), 0u);
+	
+	regValue = I2C_I2C_CTRL_REG;
+	regValue &= (uint32) ~(I2C_I2C_CTRL_HIGH_PHASE_OVS_MASK | I2C_I2C_CTRL_LOW_PHASE_OVS_MASK);
+	regValue |= I2C_GET_I2C_CTRL_HIGH_PHASE_OVS(ovsHigh) | I2C_GET_I2C_CTRL_LOW_PHASE_OVS(ovsLow);
+	I2C_I2C_CTRL_REG = regValue;
+	
+	/* Up to Fast-mode the analog filter is used. Fast-mode Plus requires the
+	 * analog filter to be disabled and the digital median filter enabled. */
+	if(rateKbps <= I2C_I2C_DATA_RATE_FS_MODE_MAX)
+	{
+		I2C_I2C_CFG_ANALOG_FITER_ENABLE;
+		I2C_RX_CTRL_REG &= (uint32) ~I2C_RX_CTRL_MEDIAN;
+	}
+	else
+	{
+		I2C_I2C_CFG_ANALOG_FITER_DISABLE;
+		I2C_RX_CTRL_REG |= I2C_RX_CTRL_MEDIAN;
+	}
+	
+	I2C_Enable();
+	
+	/* The CPU services the SCB FIFO byte by byte. Keep SYSCLK at least at
+	 * the SCBCLK frequency so that the CPU keeps up with the bus. */
+	CySysClkGovSetFloor((CYDEV_BCLK__HFCLK__KHZ / divider) * 1000u);
+	
+	I2CBus_dataRate = rateKbps;
+}
+
+/*******************************************************************************
+* Function Name: I2CBus_ProbeSlave
+********************************************************************************
+* Summary:
+* 	Addresses the slave and checks that it acknowledges its address.
+*
+* Parameters:
+*  uint32 slaveAddress: 7-bit address of the slave.
+*
+* Return:
+*  uint8: TRUE if the slave ACKed the address, FALSE otherwise.
+*
+*******************************************************************************/
+uint8 I2CBus_ProbeSlave(uint32 slaveAddress)
+{
+	uint32 status;
+	
+	status = I2C_I2CMasterSendStart(slaveAddress, I2C_I2C_WRITE_XFER_MODE);
+	(void) I2C_I2CMasterSendStop();
+	
+	return((status == I2C_I2C_MSTR_NO_ERROR) ? 1u : 0u);
+}
+
+/*******************************************************************************
+* Function Name: I2CBus_SetDataRate
+********************************************************************************
+* Summary:
+* 	Switches the I2C master to the requested data rate. If a slave address is
+*   given, the slave is probed at the new rate and the previous rate is
+*   restored when the slave does not acknowledge.
+*   Must be called only when no transfer is in progress.
+*
+* Parameters:
+*  uint32 rateKbps: I2CBUS_RATE_SM, I2CBUS_RATE_FM or I2CBUS_RATE_FMP.
+*  uint32 slaveAddress: 7-bit address of the slave to validate, or 0 to skip
+*                       the validation.
+*
+* Return:
+*  uint8: I2CBUS_RATE_OK, I2CBUS_RATE_INVALID or I2CBUS_RATE_NO_ACK.
+*
+*******************************************************************************/
+uint8 I2CBus_SetDataRate(uint32 rateKbps, uint32 slaveAddress)
+{
+	uint8 result = I2CBUS_RATE_OK;
+	uint32 previousRate = I2CBus_dataRate;
+	
+	switch(rateKbps)
+	{
+		case I2CBUS_RATE_SM:
+			I2CBus_ApplyTiming(I2CBUS_SM_SCBCLK_KHZ, I2CBUS_SM_OVS_LOW, I2CBUS_SM_OVS_HIGH, rateKbps);
+			break;
+		
+		case I2CBUS_RATE_FM:
+			I2CBus_ApplyTiming(I2CBUS_FM_SCBCLK_KHZ, I2CBUS_FM_OVS_LOW, I2CBUS_FM_OVS_HIGH, rateKbps);
+			break;
+		
+		case I2CBUS_RATE_FMP:
+			I2CBus_ApplyTiming(I2CBUS_FMP_SCBCLK_KHZ, I2CBUS_FMP_OVS_LOW, I2CBUS_FMP_OVS_HIGH, rateKbps);
+			break;
+		
+		default:
+			result = I2CBUS_RATE_INVALID;
+			break;
+	}
+	
+	if((result == I2CBUS_RATE_OK) && (slaveAddress != 0u))
+	{
+		if(I2CBus_ProbeSlave(slaveAddress) == 0u)
+		{
+			/* The slave does not respond at this rate, fall back to the
+			 * rate that was working before. */
+			(void) I2CBus_SetDataRate(previousRate, 0u);
+			result = I2CBUS_RATE_NO_ACK;
+		}
+	}
+	
+	return(result);
+}
+
+/*******************************************************************************
+* Function Name: I2CBus_GetDataRate
+********************************************************************************
+* Summary:
+* 	Returns the data rate currently programmed into the I2C master.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32: Data rate in kbps.
+*
+*******************************************************************************/
+uint32 I2CBus_GetDataRate(void)
+{
+	return(I2CBus_dataRate);
+}
+
+/* [] END OF FILE */
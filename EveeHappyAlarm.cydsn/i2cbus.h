@@ -0,0 +1,79 @@
+/*****************************************************************************
+* File Name: i2cbus.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  i2cbus.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(I2CBUS_H)
+#define I2CBUS_H
+
+#include "cytypes.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* Supported I2C data rates in kbps. */
+#define I2CBUS_RATE_SM				100u	/* Standard-mode       */
+#define I2CBUS_RATE_FM				400u	/* Fast-mode           */
+#define I2CBUS_RATE_FMP				1000u	/* Fast-mode Plus      */
+
+/* SCB clock and oversampling for each data rate. The SCBCLK is derived
+ * from HFCLK with an integer divider. The data rate is equal to
+ * SCBCLK / (OVS_LOW + OVS_HIGH). The values are selected from the valid
+ * ranges listed in the SCB Component datasheet for the master mode. */
+#define I2CBUS_SM_SCBCLK_KHZ		1600u
+#define I2CBUS_SM_OVS_LOW			8u
+#define I2CBUS_SM_OVS_HIGH			8u
+
+#define I2CBUS_FM_SCBCLK_KHZ		8000u
+#define I2CBUS_FM_OVS_LOW			13u
+#define I2CBUS_FM_OVS_HIGH			7u
+
+#define I2CBUS_FMP_SCBCLK_KHZ		16000u
+#define I2CBUS_FMP_OVS_LOW			10u
+#define I2CBUS_FMP_OVS_HIGH			6u
+
+#define I2CBUS_RATE_OK				0x00u
+#define I2CBUS_RATE_INVALID			0x01u
+#define I2CBUS_RATE_NO_ACK			0x02u
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+uint8 I2CBus_SetDataRate(uint32 rateKbps, uint32 slaveAddress);
+uint32 I2CBus_GetDataRate(void);
+uint8 I2CBus_ProbeSlave(uint32 slaveAddress);
+
+#endif /* I2CBUS_H */
+
+/* [] END OF FILE */
@@ -59,12 +59,33 @@
 *******************************************************************************/
 
 #include "project.h"
+#include "swtimer.h"
 #include "main.h"
 #include "accelerometer.h"
+#include "samplebuf.h"
+#include "motion.h"
+#include "orientation.h"
+#include "power.h"
+#include "retention.h"
 
 /* Change this define to TRUE if you are using uC/Probe with this project. */
 #define uCProbeEnabled 		FALSE
 
+/* Change this define to TRUE to use the full Sleep and Wakeup APIs of the 
+ * CapSense and I2C Components instead of the incremental retention, e.g. to
+ * compare the wake-up latency. */
+#define fullRetentionEnabled	FALSE
+
+/* Change this define to TRUE to measure the time from the wake-up from 
+ * Deep-Sleep to the start of the next proximity scan, in SYSCLK cycles. */
+#define wakeBenchmarkEnabled	FALSE
+
+/* Change this define to TRUE to measure the interrupt latency with the 
+ * handler in SRAM and in Flash, and the filter kernel cycles, in SYSCLK 
+ * cycles. Define CY_RAMFUNC_DISABLE in the build settings to measure the 
+ * kernels in Flash. */
+#define ramfuncBenchmarkEnabled	FALSE
+
 /* Proximity status for uC/Probe. */
 uint32 uC_Probe_Prox_Indicator = ZERO;
 
@@ -73,17 +94,105 @@ int16 uC_Probe_x_dirMovement = ACC_NO_MOVEMENT;
 int16 uC_Probe_y_dirMovement = ACC_NO_MOVEMENT;
 int16 uC_Probe_z_dirMovement = ACC_NO_MOVEMENT;
 
+/* Wake-to-first-scan latency of the last Deep-Sleep cycle and the lowest
+ * and highest latency seen, for uC/Probe or the debugger. */
+uint32 uC_Probe_wakeLatencyLast = ZERO;
+uint32 uC_Probe_wakeLatencyMin = WAKE_BENCHMARK_MAX_CYCLES;
+uint32 uC_Probe_wakeLatencyMax = ZERO;
+
+/* Interrupt latency with the handler in SRAM and in Flash, and the cycles
+ * of the last and the longest filter batch. */
+uint32 uC_Probe_isrLatencyRam = ZERO;
+uint32 uC_Probe_isrLatencyFlash = ZERO;
+uint32 uC_Probe_kernelCyclesLast = ZERO;
+uint32 uC_Probe_kernelCyclesMax = ZERO;
+
 /* If the accelerometer is configured, this variable is set to TRUE. */
 uint8 acclerometer_configured = FALSE;
 
+/* The scan timer paces the proximity scans at 30ms or 100ms and sets
+ * scanDue and workDue on expiry, which wakes the main loop. The sample 
+ * timer starts an accelerometer read every sample period while proximity
+ * is detected, and AccelSample_Isr() queues the sample when the read 
+ * completes, so sampling does not depend on the main loop. sampleStamp
+ * holds the time the read was started. */
+static SWTIMER scanTimer;
+static SWTIMER sampleTimer;
+static volatile uint8 scanDue = FALSE;
+static volatile uint8 workDue = FALSE;
+static volatile uint32 sampleStamp = ZERO;
+
+/* Components that are prepared for Deep-Sleep by the power manager, in 
+ * the order in which they enter Deep-Sleep. */
+#if(fullRetentionEnabled)
+static const POWER_CLIENT capSensePowerClient = 
+{
+	&CapSensePower_Prepare, &CapSense_Sleep, &CapSense_Wakeup, CAPSENSE_POWER_LATENCY_US, POWER_PRIORITY_CAPSENSE
+};
+#else
+static const POWER_CLIENT capSensePowerClient = 
+{
+	&CapSensePower_Prepare, &CapSenseRetention_Sleep, &CapSenseRetention_Wakeup, CAPSENSE_RETENTION_LATENCY_US, POWER_PRIORITY_CAPSENSE
+};
+#endif
+static const POWER_CLIENT ledPowerClient = 
+{
+	&LEDPower_Prepare, &LEDPower_Enter, &LEDPower_Exit, LED_POWER_LATENCY_US, POWER_PRIORITY_LED
+};
+#if(fullRetentionEnabled)
+static const POWER_CLIENT i2cPowerClient = 
+{
+	&I2CPower_Prepare, &I2C_Sleep, &I2C_Wakeup, I2C_POWER_LATENCY_US, POWER_PRIORITY_I2C
+};
+#else
+static const POWER_CLIENT i2cPowerClient = 
+{
+	&I2CPower_Prepare, &I2CRetention_Sleep, &I2CRetention_Wakeup, I2C_RETENTION_LATENCY_US, POWER_PRIORITY_I2C
+};
+#endif
+
+#if(wakeBenchmarkEnabled)
+/* Leaves Deep-Sleep first to take the wake-up time stamp. */
+static const POWER_CLIENT benchmarkPowerClient = 
+{
+	(void *)0, (void *)0, &WakeBenchmark_Exit, ZERO, POWER_PRIORITY_BENCHMARK
+};
+
+/* SysTick value on the wake-up and whether it is yet to be evaluated. */
+static uint32 wakeStamp = ZERO;
+static uint8 wakePending = FALSE;
+#endif
+
+#if(ramfuncBenchmarkEnabled)
+/* SysTick value on the entry of the benchmark interrupt. */
+static volatile uint32 isrStamp = ZERO;
+#endif
+
+/* Latest proximity raw count taken from the sample ring, and the baseline
+ * updated from it. */
+static uint16 proxRawCount = ZERO;
+static uint16 proxBaseline = ZERO;
+
 int main()
 {	
-    /* Start all the Components and enable the global interrupt. */
+	/* Enable global interrupt. The delays used during the initialization
+	 * wait for the WDT interrupt. */
+	CyGlobalIntEnable; 
+	
+    /* Start all the Components. */
 	Initialize_Project();
     
     /* Initialize the accelerometer after a self-test. */
 	InitializeAccelerometer();
-    
+	
+	/* Motion detection only needs the 8-bit profile, which halves the 
+	 * I2C traffic per sample. Accelerometer_SetProfile() can switch to 
+	 * Accelerometer_precisionProfile when more precision is needed. */
+	if(acclerometer_configured == TRUE)
+	{
+		(void) Accelerometer_SetProfile(&Accelerometer_fastProfile);
+	}
+	
 	/* Proximity sensor state. */
 	uint8 proximity  = INACTIVE;
 	
@@ -92,14 +201,10 @@ int main()
 	 * for more than 3s. */
 	uint8 softCounter = RESET;
 	
-	/* Variable to store the WDT match value. */
-	uint16 currentCountVal = ZERO;
-	
-	/* Variable to determine whether to update the WDT match value. */
-	uint8 updateMatch = UPDATE_100MS;
-	
-	/* Enable global interrupt. */
-	CyGlobalIntEnable; 
+	/* Scan period of the proximity sensor in milliseconds. The sensor is
+	 * scanned every 100ms until proximity is detected. */
+	uint32 scanPeriod = SCAN_PERIOD_INACTIVE_MS;
+	SwTimer_Start(&scanTimer, ZERO, scanPeriod, ScanTimer_Callback);
 
 	/* Enable and start the CapSense block. */	
 	CapSense_Start();
@@ -113,14 +218,64 @@ int main()
 	/* Switch off the Green LED. */
 	LED_SetBrightness(ZERO);
 	
+	/* Let the power manager prepare the Components for Deep-Sleep. */
+	(void) Power_RegisterClient(&capSensePowerClient);
+	(void) Power_RegisterClient(&ledPowerClient);
+	(void) Power_RegisterClient(&i2cPowerClient);
+	
+	#if(wakeBenchmarkEnabled || ramfuncBenchmarkEnabled)
+		/* Run SysTick freely over its full range to time the benchmarks. */
+		CySysTickStart();
+		CySysTickDisableInterrupt();
+		CySysTickSetReload(WAKE_BENCHMARK_MAX_CYCLES);
+		CySysTickClear();
+	#endif
+	
+	#if(wakeBenchmarkEnabled)
+		(void) Power_RegisterClient(&benchmarkPowerClient);
+	#endif
+	
+	#if(ramfuncBenchmarkEnabled)
+		RamFuncBenchmark_Run();
+	#endif
+	
 	for(;;)
     {	
-		/* Update the baseline of the proximity sensor. */
-		CapSense_UpdateSensorBaseline(CapSense_PROXIMITYSENSOR__PROX);
+		/* Wait for the scan timer. The power manager uses Deep-Sleep when
+		 * the LED is off, the next timer is far enough away and no 
+		 * accelerometer read is in progress. */
+		while(workDue == FALSE)
+		{
+			/* Deep-Sleep low power mode is not available when the uC/Probe tool is active. 
+			 *  We use the Sleep low power mode if the macro uCProbeEnabled is set to TRUE. */
+			#if(uCProbeEnabled)
+				(void) Power_Idle(POWER_MODE_SLEEP, &workDue);
+			#else
+				(void) Power_Idle(POWER_MODE_DEEPSLEEP, &workDue);
+			#endif
+		}
+		
+		/* workDue is cleared before the flags are checked, so a timer that
+		 * expires meanwhile sets it again and is handled on the next pass. */
+		workDue = FALSE;
+		
+		/* The samples are processed in a batch after the next scan. */
+		if(scanDue == FALSE)
+		{
+			continue;
+		}
+		scanDue = FALSE;
 		
 		/* Scan the proximity sensor. */						
 		CapSense_ScanSensor(CapSense_PROXIMITYSENSOR__PROX);
 		
+		#if(wakeBenchmarkEnabled)
+			WakeBenchmark_Update();
+		#endif
+		
+		/* The scan is the first work done after the wake-up. */
+		CySysPmStatsWork();
+		
 		/* Wait till the scan is complete*/
 		while(CapSense_IsBusy())
 		{
@@ -129,6 +284,13 @@ int main()
 			 * after scanning. */
 			CySysPmSleep();
 		}
+		
+		/* Update the baseline of the proximity sensor with the scan that
+		 * just completed. */
+		CapSense_UpdateSensorBaseline(CapSense_PROXIMITYSENSOR__PROX);
+		
+		/* Process the samples queued since the last scan. */
+		ProcessSamples();
 	
 		/* Check if proximity sensor is active. */
 		proximity = CapSense_CheckIsSensorActive(CapSense_PROXIMITYSENSOR__PROX);
@@ -136,54 +298,34 @@ int main()
 		if(proximity == ACTIVE)
 		{
 			/* Set the LED at a brightness level corresponding 
-			 * to the proximity distance. And check accel */
+			 * to the proximity distance. */
 			LED_SetBrightness(ON);
-            UpdateLEDColor();
 			
-			/* Update the WDT if required. */
-			if(updateMatch == UPDATE_30MS)
+			/* Sample the accelerometer while proximity is detected. Restart
+			 * the motion engine when sampling starts so that the first 
+			 * sample is not compared with a stale one. */
+			if((acclerometer_configured == TRUE) && (SwTimer_IsActive(&sampleTimer) == FALSE))
 			{
-				/* Configure the wake up period to 30ms and update WDT match value. */
-		    	CySysWdtWriteMatch(CY_SYS_WDT_COUNTER0, WDT_MATCH_VALUE_30MS);
-				
-				/* Read the current count value of the WDT. */
-			    currentCountVal = CySysWdtReadCount(CY_SYS_WDT_COUNTER0);
-				
-				/* Reset the counter if the count value is greater than
-				 * the match value */
-			    if (currentCountVal > WDT_MATCH_VALUE_30MS)
-			    {
-			        CySysWdtResetCounters(CY_SYS_WDT_COUNTER0_RESET);
-				}
-				
-				/* Provide a delay to allow the changes on WDT register to take 
-				 * effect. This is approximately 4 LFCLK cycles. */
-				CyDelayUs(ILOX4);
-				
-				/* Next update to the WDT match value is required only when
-				 * switching to 100ms scan interval. */
-				updateMatch = UPDATE_100MS;
+				Motion_Reset();
+				Orientation_Reset();
+				SwTimer_Start(&sampleTimer, ZERO, SAMPLE_PERIOD_MS, SampleTimer_Callback);
+			}
+			
+			/* Scan the sensor every 30ms while proximity is detected. */
+			if(scanPeriod != SCAN_PERIOD_ACTIVE_MS)
+			{
+				scanPeriod = SCAN_PERIOD_ACTIVE_MS;
+				SwTimer_Start(&scanTimer, scanPeriod, scanPeriod, ScanTimer_Callback);
 			}
 			
 			/* Reset the software counter if proximity is detected. */
 			softCounter = RESET;
-            
-            if(acclerometer_configured == TRUE)
-		    {
-			
-			/* Read the accelerometer data. */
-			ReadAccelerometer(&uC_Probe_x_dirMovement, &uC_Probe_y_dirMovement, &uC_Probe_z_dirMovement);
-			
-			/* Update the LED color based on the acceleration data. */
-			UpdateLEDColor();
-		    }
-			
-			/* Put CPU in sleep mode after displaying output on LED. 
-			CySysPmSleep(); */
-            
 		}
 		else /* Proximity sensor is inactive. */
 		{
+			/* Stop sampling the accelerometer. */
+			SwTimer_Stop(&sampleTimer);
+			
 			/* Switch off the LED if proximity is not detected. */
 			LED_SetBrightness(OFF);
 			
@@ -196,63 +338,71 @@ int main()
 				/* Set the maximum limit for the softCounter. */
 				softCounter = MAX_VALUE;
 				
-				/* Update the WDT if required. */
-				if(updateMatch == UPDATE_100MS)
+				/* Proximity sensor is inactive for more than 3s. 
+				 * Increase Deep-Sleep duration to 100ms. */
+				if(scanPeriod != SCAN_PERIOD_INACTIVE_MS)
 				{
-					/* Proximity sensor is inactive for more than 3s. 
-					 * Increase Deep-Sleep duration to 100ms and update WDT match value. */
-			    	CySysWdtWriteMatch(CY_SYS_WDT_COUNTER0, WDT_MATCH_VALUE_100MS);
-					
-					/* Read the current count value of the WDT. */
-				    currentCountVal = CySysWdtReadCount(CY_SYS_WDT_COUNTER0);
-					
-					/* Reset the counter if the count value is greater than
-					 * the match value */
-				    if (currentCountVal > WDT_MATCH_VALUE_100MS)
-				    {
-				        CySysWdtResetCounters(CY_SYS_WDT_COUNTER0_RESET);
-					}
-					
-					/* Provide a delay to allow the changes on WDT register to take 
-					 * effect. This is approximately 4 LFCLK cycles. */
-					CyDelayUs(ILOX4);
-					
-					/* Next update to the WDT match value is required only when
-					 * switching to 30ms scan interval. */
-					updateMatch = UPDATE_30MS;
+					scanPeriod = SCAN_PERIOD_INACTIVE_MS;
+					SwTimer_Start(&scanTimer, scanPeriod, scanPeriod, ScanTimer_Callback);
 				}
 			}
-
-			/* Deep-Sleep low power mode is not available when the uC/Probe tool is active. 
-			 *  We use the Sleep low power mode if the macro uCProbeEnabled is set to TRUE. */
-			#if(uCProbeEnabled)
-				CySysPmSleep();
-			#else
-				EnterDeepSleepLowPowerMode();
-			#endif
 		}
 	} 	
 }
 
 /*******************************************************************************
-* Function Name: EnterDeepSleepLowPowerMode
+* Function Name: CapSensePower_Prepare
 ********************************************************************************
 * Summary:
-*  Puts the device in Deep-Sleep power mode. Reconfigures the Components for 
-*  normal operation after wake-up. 
+*  Power manager callback. Keeps the device out of Deep-Sleep while a 
+*  CapSense scan is in progress.
 *
 * Parameters:
 *  void
 *
 * Return:
+*  uint8: POWER_VETO while scanning, otherwise POWER_OK.
+*
+*******************************************************************************/
+uint8 CapSensePower_Prepare(void)
+{
+	return((CapSense_IsBusy() != ZERO) ? POWER_VETO : POWER_OK);
+}
+
+/*******************************************************************************
+* Function Name: LEDPower_Prepare
+********************************************************************************
+* Summary:
+*  Power manager callback. The PWM stops in Deep-Sleep, so the device stays 
+*  in Sleep while the Green LED is lit.
+*
+* Parameters:
 *  void
 *
+* Return:
+*  uint8: POWER_VETO while the LED is lit, otherwise POWER_OK.
+*
 *******************************************************************************/
-void EnterDeepSleepLowPowerMode(void)
+uint8 LEDPower_Prepare(void)
+{
+	return((PWM_Green_ReadCompare() != OFF) ? POWER_VETO : POWER_OK);
+}
+
+/*******************************************************************************
+* Function Name: LEDPower_Enter
+********************************************************************************
+* Summary:
+*  Power manager callback. Prepares the Green LED PWM for Deep-Sleep.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void LEDPower_Enter(void)
 {
-	/* Prepare CapSense CSD Component for Deep-Sleep power mode entry. */
-	CapSense_Sleep();
-	
 	/* Make the pin connected to Green LED high impedance to save power. 
 	 * This is also required to prevent a glitch on the PWM output which 
 	 * causes the LED to flash each time the device wakes up from the 
@@ -261,20 +411,232 @@ void EnterDeepSleepLowPowerMode(void)
 	
 	/* Prepare the PWM component for Deep-Sleep power mode entry. */
 	PWM_Green_Sleep();
-	
-	/* Enter Deep-Sleep. */
-	CySysPmDeepSleep();	
-	
-	/* The device has woken up from Deep-Sleep power mode. 
-	 * Reconfigure PWM component. */
+}
+
+/*******************************************************************************
+* Function Name: LEDPower_Exit
+********************************************************************************
+* Summary:
+*  Power manager callback. Reconfigures the Green LED PWM after Deep-Sleep.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void LEDPower_Exit(void)
+{
+	/* Reconfigure PWM component. */
 	PWM_Green_Wakeup();
 	
 	/* Set the pin connected to Green LED to be in strong drive
 	 * mode for normal operation. */
 	Pin_GreenLED_SetDriveMode(Pin_GreenLED_DM_STRONG);
+}
+
+#if(wakeBenchmarkEnabled)
+/*******************************************************************************
+* Function Name: WakeBenchmark_Exit
+********************************************************************************
+* Summary:
+*  Power manager callback. Takes the SysTick value right after the wake-up
+*  from Deep-Sleep.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void WakeBenchmark_Exit(void)
+{
+	wakeStamp = CySysTickGetValue();
+	wakePending = TRUE;
+}
+
+/*******************************************************************************
+* Function Name: WakeBenchmark_Update
+********************************************************************************
+* Summary:
+*  Called when a proximity scan has started. Updates the wake-up latency 
+*  statistics if the device came from Deep-Sleep. SysTick counts down.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void WakeBenchmark_Update(void)
+{
+	if(wakePending == TRUE)
+	{
+		uC_Probe_wakeLatencyLast = (wakeStamp - CySysTickGetValue()) & WAKE_BENCHMARK_MAX_CYCLES;
+		if(uC_Probe_wakeLatencyLast < uC_Probe_wakeLatencyMin)
+		{
+			uC_Probe_wakeLatencyMin = uC_Probe_wakeLatencyLast;
+		}
+		if(uC_Probe_wakeLatencyLast > uC_Probe_wakeLatencyMax)
+		{
+			uC_Probe_wakeLatencyMax = uC_Probe_wakeLatencyLast;
+		}
+		wakePending = FALSE;
+	}
+}
+#endif
+
+#if(ramfuncBenchmarkEnabled)
+/*******************************************************************************
+* Function Name: RamFuncBenchmark_RamIsr
+********************************************************************************
+* Summary:
+*  Benchmark interrupt handler executed from SRAM. Takes the SysTick value 
+*  on the entry.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CY_RAMFUNC CY_ISR(RamFuncBenchmark_RamIsr)
+{
+	isrStamp = CY_SYS_SYST_CVR_REG;
+}
+
+/*******************************************************************************
+* Function Name: RamFuncBenchmark_FlashIsr
+********************************************************************************
+* Summary:
+*  Benchmark interrupt handler executed from Flash. Takes the SysTick value 
+*  on the entry.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CY_ISR(RamFuncBenchmark_FlashIsr)
+{
+	isrStamp = CY_SYS_SYST_CVR_REG;
+}
+
+/*******************************************************************************
+* Function Name: RamFuncBenchmark_IsrLatency
+********************************************************************************
+* Summary:
+*  Pends the benchmark interrupt with the given handler and measures the 
+*  cycles from the pend request to the first handler instruction. The 
+*  overhead of the measurement is the same for both handlers.
+*
+* Parameters:
+*  cyisraddress isr: Handler to measure.
+*
+* Return:
+*  uint32: Lowest latency in SYSCLK cycles. SysTick counts down.
+*
+*******************************************************************************/
+uint32 RamFuncBenchmark_IsrLatency(cyisraddress isr)
+{
+	uint32 minLatency = WAKE_BENCHMARK_MAX_CYCLES;
+	uint32 latency;
+	uint32 stamp;
+	uint8 run;
+	
+	(void) CyIntSetVector(RAMFUNC_BENCHMARK_IRQN, isr);
+	CyIntEnable(RAMFUNC_BENCHMARK_IRQN);
+	
+	for(run = ZERO; run < RAMFUNC_BENCHMARK_RUNS; run++)
+	{
+		stamp = CY_SYS_SYST_CVR_REG;
+		CyIntSetPending(RAMFUNC_BENCHMARK_IRQN);
+		
+		latency = (stamp - isrStamp) & WAKE_BENCHMARK_MAX_CYCLES;
+		if(latency < minLatency)
+		{
+			minLatency = latency;
+		}
+	}
+	
+	CyIntDisable(RAMFUNC_BENCHMARK_IRQN);
+	
+	return(minLatency);
+}
+
+/*******************************************************************************
+* Function Name: RamFuncBenchmark_Run
+********************************************************************************
+* Summary:
+*  Measures the interrupt latency with the handler in SRAM and in Flash at 
+*  the full SYSCLK, where Flash has wait states.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RamFuncBenchmark_Run(void)
+{
+	uint32 clockLevel;
 	
-	/* Reconfigure CapSense CSD Component after Deep-Sleep */
-	CapSense_Wakeup();
+	clockLevel = CySysClkGovSetLevel(CY_SYS_CLK_GOV_BURST);
+	
+	uC_Probe_isrLatencyRam = RamFuncBenchmark_IsrLatency(&RamFuncBenchmark_RamIsr);
+	uC_Probe_isrLatencyFlash = RamFuncBenchmark_IsrLatency(&RamFuncBenchmark_FlashIsr);
+	
+	(void) CySysClkGovSetLevel(clockLevel);
+}
+
+/*******************************************************************************
+* Function Name: RamFuncBenchmark_Kernel
+********************************************************************************
+* Summary:
+*  Called after the filter kernels processed a batch. Updates the kernel 
+*  cycle statistics.
+*
+* Parameters:
+*  uint32 stamp: SysTick value taken before the kernels were called.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void RamFuncBenchmark_Kernel(uint32 stamp)
+{
+	uC_Probe_kernelCyclesLast = (stamp - CySysTickGetValue()) & WAKE_BENCHMARK_MAX_CYCLES;
+	if(uC_Probe_kernelCyclesLast > uC_Probe_kernelCyclesMax)
+	{
+		uC_Probe_kernelCyclesMax = uC_Probe_kernelCyclesLast;
+	}
+}
+#endif
+
+/*******************************************************************************
+* Function Name: I2CPower_Prepare
+********************************************************************************
+* Summary:
+*  Power manager callback. Keeps the device out of Deep-Sleep while an I2C 
+*  transfer to the accelerometer is in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8: POWER_VETO during a transfer, otherwise POWER_OK.
+*
+*******************************************************************************/
+uint8 I2CPower_Prepare(void)
+{
+	return(((I2C_I2CMasterStatus() & I2C_I2C_MSTAT_XFER_INP) != ZERO) ? POWER_VETO : POWER_OK);
 }
 
 /*******************************************************************************
@@ -297,13 +659,14 @@ void LED_SetBrightness(uint8 mode)
 	uint16 ledBrighness = ZERO;
 	
 	/* The variable signal holds a value between 0 and 255.
-	 * Scale the value for a visible brightness change. */
+	 * Scale the value for a visible brightness change. The baseline of the
+	 * last scan is the lower limit. */
 	if(mode != OFF)
 	{
         Happy();
-		if(CapSense_SensorRaw[0] < PROX_UPPER_LIMIT)
+		if(proxRawCount < PROX_UPPER_LIMIT)
 		{
-			ledBrighness = ((PWM_Green_PWM_PERIOD_VALUE * (CapSense_SensorRaw[0] - PROX_LOWER_LIMIT))/(PROX_UPPER_LIMIT - PROX_LOWER_LIMIT));
+			ledBrighness = ((PWM_Green_PWM_PERIOD_VALUE * (proxRawCount - proxBaseline))/(PROX_UPPER_LIMIT - proxBaseline));
 		}
 		else
 		{
@@ -346,7 +709,7 @@ void Alarm(void) {
     Pin_EMiddle_Write( ROFF );
     Pin_EBottom_Write( RON );
     Pin_Vibe_Write( RON );
-    CyDelay(100);
+    SwTimer_Delay(100);
 }
 
 
@@ -365,89 +728,220 @@ void Alarm(void) {
 *******************************************************************************/
 void Initialize_Project(void)
 {
-	/* Enable and start accelerometer I2C block. */	
+	/* Run SYSCLK at the idle level. The clock is raised only while the 
+	 * samples are filtered. */
+	CySysClkGovInit(SYSCLK_IDLE_DIV);
+	
+	/* Start the WDT timebase used for the sample timestamps and measure 
+	 * the ILO so that tick conversions are accurate. */
+	CySysTimebaseStart();
+	(void) CySysTimebaseCalibrate();
+	
+	/* Account the time spent in each power mode. */
+	CySysPmStatsStart();
+	
+	/* Start the software timers on WDT counter 0. */
+	SwTimer_Init();
+	
+	/* Enable and start accelerometer I2C block. The Component handler is
+	 * wrapped so that the sample reads complete in the I2C interrupt. The
+	 * vector is only set by the first I2C_Start(). */	
 	I2C_Start();
+	(void) CyIntSetVector(I2C_ISR_NUMBER, &AccelSample_Isr);
 	
-	/* Wait for 700ms for the accelerometer to start up. */
-	CyDelay(ACC_STARTUP_TIME);
+	/* Wait for the accelerometer to start up. The accelerometer is polled,
+	 * so this returns as soon as it answers instead of after the worst-case
+	 * start-up time. InitializeAccelerometer() runs the self-test and
+	 * leaves the accelerometer unconfigured if it never becomes ready. */
+	(void) Accelerometer_WaitReady();
 }
 
 /*******************************************************************************
-* Function Name: UpdateLEDColor
+* Function Name: ScanTimer_Callback
 ********************************************************************************
 * Summary:
-* 	Updates the LED color based on the accelerometer value.
+* 	Called from the WDT interrupt when the scan timer expires. Signals the
+*   main loop to scan the proximity sensor.
 *
 * Parameters:
+*  SWTIMER *timer: The scan timer.
+*
+* Return:
 *  void
 *
+*******************************************************************************/
+void ScanTimer_Callback(SWTIMER *timer)
+{
+	(void) timer;
+	
+	scanDue = TRUE;
+	workDue = TRUE;
+}
+
+/*******************************************************************************
+* Function Name: SampleTimer_Callback
+********************************************************************************
+* Summary:
+* 	Called from the WDT interrupt when the sample timer expires. Starts the
+*   accelerometer read, which the I2C interrupt carries on, so the timer 
+*   wheel is not held off for the whole transfer. If the previous read is
+*   still in progress the sample is skipped.
+*
+* Parameters:
+*  SWTIMER *timer: The sample timer.
+*
 * Return:
 *  void
 *
 *******************************************************************************/
-void UpdateLEDColor(void)
+void SampleTimer_Callback(SWTIMER *timer)
 {
-	/* Variables to store previous state between function calls. */
-	static int16 prev_x_value = ZERO;
-	static int16 prev_y_value = ZERO;
-	
-	/* Variables to calculate the absolute acceleration difference. */
-	int16 diffVal1 = ZERO;
-	int16 diffVal2 = ZERO;
-	uint16 positiveDiffVal = ZERO;
-	
-	/* Determine the acceleration difference and store the current 
-	 * acceleration data in the static variable. */
-	diffVal1 = uC_Probe_x_dirMovement - prev_x_value;
-	diffVal2 = prev_x_value - uC_Probe_x_dirMovement;
-	prev_x_value = uC_Probe_x_dirMovement;
-	
-	/* Determine the absolute value. */
-	if(diffVal1 > diffVal2)
-	{
-		positiveDiffVal = diffVal1;
-	}
-	else
-	{
-		positiveDiffVal = diffVal2;
-	}
+	(void) timer;
 	
-	/* Modulate the PWM corresponding to the magnitude of acceleration data
-	 if acceleration is greater than threshold value. */
-	if(positiveDiffVal > ACC_THRESHOLD_VALUE)
-	{
-		Alarm();
-	}
-	else
+	if(Accelerometer_StartSample() == ACC_PASS)
 	{
+		sampleStamp = SampleBuf_GetTimestamp();
 	}
+}
+
+/*******************************************************************************
+* Function Name: AccelSample_Isr
+********************************************************************************
+* Summary:
+* 	I2C interrupt handler. Runs the Component handler, then moves the 
+*   accelerometer read on and queues the timestamped sample once it is 
+*   complete. A failed read is not queued. The samples are filtered in a
+*   batch by ProcessSamples() after the next proximity scan.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CY_RAMFUNC CY_ISR(AccelSample_Isr)
+{
+	SAMPLE accSample;
 	
-	/* Determine the acceleration difference and store the current 
-	 * acceleration data in the static variable. */
-	diffVal1 = uC_Probe_y_dirMovement - prev_y_value;
-	diffVal2 = prev_y_value - uC_Probe_y_dirMovement;
-	prev_y_value = uC_Probe_y_dirMovement;
+	I2C_I2C_ISR();
 	
-	/* Determine the absolute value. */
-	if(diffVal1 > diffVal2)
+	if(Accelerometer_ServiceSample(&accSample.value[SAMPLE_X], &accSample.value[SAMPLE_Y], 
+								   &accSample.value[SAMPLE_Z]) == ACC_SAMPLE_READY)
 	{
-		positiveDiffVal = diffVal1;
+		accSample.timestamp = sampleStamp;
+		accSample.source = SAMPLE_SRC_ACCEL;
+		(void) SampleRing_Push(&SampleBuf_accelRing, &accSample);
 	}
-	else
+}
+
+/*******************************************************************************
+* Function Name: ProcessSamples
+********************************************************************************
+* Summary:
+* 	Drains the sample rings in batches. The latest proximity sample updates 
+*   the values used for the LED brightness and the accelerometer samples are 
+*   passed to the orientation estimator and the motion engine in the order
+*   they were taken.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ProcessSamples(void)
+{
+	SAMPLE batch[SAMPLE_BATCH_SIZE];
+	uint32 clockLevel;
+	#if(ramfuncBenchmarkEnabled)
+		uint32 kernelStamp;
+	#endif
+	uint8 events;
+	uint8 count;
+	uint8 index;
+	
+	do
 	{
-		positiveDiffVal = diffVal2;
+		count = SampleRing_PopBatch(&SampleBuf_proxRing, batch, SAMPLE_BATCH_SIZE);
+		if(count != ZERO)
+		{
+			proxRawCount = (uint16)batch[count - 1u].value[SAMPLE_PROX_RAW];
+		}
 	}
+	while(count == SAMPLE_BATCH_SIZE);
 	
-	/* Modulate the PWM corresponding to the magnitude of acceleration data
-	 if acceleration is greater than threshold value. */
-	if(positiveDiffVal > ACC_THRESHOLD_VALUE)
+	/* The interrupt queues only the raw count. The baseline is taken here,
+	 * once it has been updated with the same scan. */
+	proxBaseline = CapSense_sensorBaseline[CapSense_PROXIMITYSENSOR__PROX];
+	
+	do
 	{
-		Alarm();
+		count = SampleRing_PopBatch(&SampleBuf_accelRing, batch, SAMPLE_BATCH_SIZE);
+		if(count != ZERO)
+		{
+			uC_Probe_x_dirMovement = batch[count - 1u].value[SAMPLE_X];
+			uC_Probe_y_dirMovement = batch[count - 1u].value[SAMPLE_Y];
+			uC_Probe_z_dirMovement = batch[count - 1u].value[SAMPLE_Z];
+			
+			/* Filter the batch at full speed and go back to the idle 
+			 * clock as soon as it is done. */
+			clockLevel = CySysClkGovSetLevel(CY_SYS_CLK_GOV_BURST);
+			
+			#if(ramfuncBenchmarkEnabled)
+				kernelStamp = CySysTickGetValue();
+			#endif
+			
+			/* The orientation is updated only when new data arrives. */
+			for(index = ZERO; index < count; index++)
+			{
+				(void) Orientation_Update(batch[index].value);
+			}
+			
+			events = Motion_ProcessBatch(batch, count);
+			
+			#if(ramfuncBenchmarkEnabled)
+				RamFuncBenchmark_Kernel(kernelStamp);
+			#endif
+			
+			(void) CySysClkGovSetLevel(clockLevel);
+			
+			/* Small movements are ignored while the toy lies still face up
+			 * or face down. Steps and shakes still raise the alarm. */
+			if(Orientation_IsResting() != ZERO)
+			{
+				events &= (uint8)~MOTION_EVENT_JERK;
+			}
+			
+			/* Update the LED color based on the motion in the batch. */
+			UpdateLEDColor(events);
+		}
 	}
-	else
+	while(count == SAMPLE_BATCH_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: UpdateLEDColor
+********************************************************************************
+* Summary:
+* 	Updates the LED state based on the motion events detected in the 
+*   accelerometer data.
+*
+* Parameters:
+*  uint8 events: MOTION_EVENT_xxx bits returned by the motion engine.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void UpdateLEDColor(uint8 events)
+{
+	/* Raise the alarm if the toy was moved, walked with or shaken. */
+	if((events & MOTION_ALARM_EVENTS) != ZERO)
 	{
+		Alarm();
 	}
-    
 }
 
 /* [] END OF FILE */
@@ -43,20 +43,16 @@
 #define FALSE						0x00
 #define TRUE						0x01
 
-/* WDT match values for different duration of Deep-Sleep power mode.
- * The ILO is operating at 32 kHz. */
-#define WDT_MATCH_VALUE_30MS		(32 * 30) 
-#define WDT_MATCH_VALUE_100MS		(32 * 100)
-
-/* 4 ILO periods expressed in microseconds. */
-#define ILOX4 						((4 * 1000) / 32)
+/* Proximity scan periods in milliseconds while proximity is detected and
+ * after it was absent for 3 seconds, and the accelerometer sample period. */
+#define SCAN_PERIOD_ACTIVE_MS		30u
+#define SCAN_PERIOD_INACTIVE_MS		100u
+#define SAMPLE_PERIOD_MS			30u
 
 #define INACTIVE					0
 #define ACTIVE						1
 #define RESET						0
-	
-#define UPDATE_30MS					0x01
-#define UPDATE_100MS				0x02
+
 
 /* MAX_VALUE defined to achieve 3 second duration. 
  * See the explanation for variable softCounter in main.c. */
@@ -69,12 +65,38 @@
 #define	ROFF					    0
 	
 #define PROX_UPPER_LIMIT			55000
-#define PROX_LOWER_LIMIT			CapSense_SensorBaseline[0]
-    
-#define ACC_THRESHOLD_VALUE			0x10
 #define BRIGHTNESS_MULTIPLIER		0x05
 
-#define ACC_STARTUP_TIME			700
+/* Power manager priorities and the estimated time in microseconds that 
+ * each Component takes to enter and leave Deep-Sleep. */
+#define POWER_PRIORITY_CAPSENSE		0u
+#define POWER_PRIORITY_LED			1u
+#define POWER_PRIORITY_I2C			2u
+#define POWER_PRIORITY_BENCHMARK	0xFFu
+#define CAPSENSE_POWER_LATENCY_US	50u
+#define LED_POWER_LATENCY_US		10u
+#define I2C_POWER_LATENCY_US		10u
+
+/* Deep-Sleep latency of the incremental retention in retention.c, which 
+ * only writes one register per Component on entry and exit. */
+#define CAPSENSE_RETENTION_LATENCY_US	5u
+#define I2C_RETENTION_LATENCY_US		5u
+
+/* SysTick range used to measure the wake-up latency. */
+#define WAKE_BENCHMARK_MAX_CYCLES	0x00FFFFFFu
+
+/* Interrupt pended by software to measure the interrupt latency from SRAM
+ * and from Flash. It has no source in this design. Each latency is the
+ * lowest of RAMFUNC_BENCHMARK_RUNS measurements. */
+#define RAMFUNC_BENCHMARK_IRQN		30u
+#define RAMFUNC_BENCHMARK_RUNS		16u
+
+/* Number of samples taken from a sample ring in one pass. */
+#define SAMPLE_BATCH_SIZE			4u
+
+/* SYSCLK prescaler used by the clock governor outside the processing 
+ * bursts. HFCLK / 4 = 12MHz, which is not below the CapSense clocks. */
+#define SYSCLK_IDLE_DIV				CY_SYS_CLK_SYSCLK_DIV4
 
 /*****************************************************************************
 * Data Type Definition
@@ -99,12 +121,27 @@
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
-void EnterDeepSleepLowPowerMode(void);
+uint8 CapSensePower_Prepare(void);
+uint8 LEDPower_Prepare(void);
+void LEDPower_Enter(void);
+void LEDPower_Exit(void);
+uint8 I2CPower_Prepare(void);
+void WakeBenchmark_Exit(void);
+void WakeBenchmark_Update(void);
+CY_RAMFUNC CY_ISR_PROTO(RamFuncBenchmark_RamIsr);
+CY_ISR_PROTO(RamFuncBenchmark_FlashIsr);
+uint32 RamFuncBenchmark_IsrLatency(cyisraddress isr);
+void RamFuncBenchmark_Run(void);
+void RamFuncBenchmark_Kernel(uint32 stamp);
 void LED_SetBrightness(uint8 value);
 void Neutral(void);
 void Alarm(void);
 void Happy(void);
-void UpdateLEDColor(void);
+void UpdateLEDColor(uint8 events);
+void ProcessSamples(void);
+void ScanTimer_Callback(SWTIMER *timer);
+void SampleTimer_Callback(SWTIMER *timer);
+CY_RAMFUNC CY_ISR_PROTO(AccelSample_Isr);
 void Initialize_Project(void);
 
 /*****************************************************************************
@@ -0,0 +1,335 @@
+/*****************************************************************************
+* File Name: motion.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides a streaming motion feature engine for the acceleration
+*  data. Each sample updates the magnitude, the jerk, the variance of the
+*  acceleration vector over a sliding window and a peak detector, which are combined into step
+*  and shake events. Only integer math is used and the work per sample is
+*  bounded: the square root has a fixed number of iterations and the window
+*  sums are updated incrementally.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "motion.h"
+
+/*****************************************************************************
+* Local Global Variable Declarations
+*****************************************************************************/
+/* Axis values of the previous sample. */
+static int16 MotionPrevAxis[SAMPLE_VALUES];
+
+/* Sliding window of axis values with the running sums of each axis. */
+static int16 MotionWindow[SAMPLE_VALUES][MOTION_WINDOW_SIZE];
+static int32 MotionWindowSum[SAMPLE_VALUES];
+static uint32 MotionWindowSumSq[SAMPLE_VALUES];
+static uint8 MotionWindowIndex = 0u;
+
+/* Number of samples processed, saturated at MOTION_WINDOW_SIZE. */
+static uint8 MotionSampleCount = 0u;
+
+/* Peak detector state: the two previous magnitudes and the number of samples
+ * since the last peak. */
+static uint16 MotionMagPrev1 = 0u;
+static uint16 MotionMagPrev2 = 0u;
+static uint8 MotionSincePeak = 0xFFu;
+
+/* Features of the latest sample. */
+static MOTION_FEATURES MotionFeatures;
+
+
+/*******************************************************************************
+* Function Name: Motion_Sqrt
+********************************************************************************
+* Summary:
+* 	Returns the integer square root of a 32-bit value. The loop always runs
+*   16 times, so the execution time does not depend on the input. Also used
+*   by the orientation estimator.
+*
+* Parameters:
+*  uint32 value: Value of which the square root is taken.
+*
+* Return:
+*  uint16: floor(sqrt(value)).
+*
+*******************************************************************************/
+CY_RAMFUNC uint16 Motion_Sqrt(uint32 value)
+{
+	uint32 root = 0u;
+	uint32 bit = 1uL << 30u;
+	
+	while(bit != 0u)
+	{
+		if(value >= (root + bit))
+		{
+			value -= root + bit;
+			root = (root >> 1u) + bit;
+		}
+		else
+		{
+			root >>= 1u;
+		}
+		bit >>= 2u;
+	}
+	
+	return((uint16)root);
+}
+
+/*******************************************************************************
+* Function Name: Motion_Abs
+********************************************************************************
+* Summary:
+* 	Returns the absolute difference of two axis values.
+*
+* Parameters:
+*  int16 a: First value.
+*  int16 b: Second value.
+*
+* Return:
+*  uint16: |a - b|.
+*
+*******************************************************************************/
+static CY_RAMFUNC uint16 Motion_Abs(int16 a, int16 b)
+{
+	int32 diff = (int32)a - (int32)b;
+	
+	return((uint16)((diff < 0) ? -diff : diff));
+}
+
+/*******************************************************************************
+* Function Name: Motion_Reset
+********************************************************************************
+* Summary:
+* 	Clears the window, the peak detector and the step count. The next sample
+*   only primes the engine and does not generate events.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Motion_Reset(void)
+{
+	uint8 axis;
+	uint8 index;
+	
+	for(axis = 0u; axis < SAMPLE_VALUES; axis++)
+	{
+		for(index = 0u; index < MOTION_WINDOW_SIZE; index++)
+		{
+			MotionWindow[axis][index] = 0;
+		}
+		MotionWindowSum[axis] = 0;
+		MotionWindowSumSq[axis] = 0u;
+		MotionPrevAxis[axis] = 0;
+	}
+	
+	MotionWindowIndex = 0u;
+	MotionSampleCount = 0u;
+	MotionMagPrev1 = 0u;
+	MotionMagPrev2 = 0u;
+	MotionSincePeak = 0xFFu;
+	
+	MotionFeatures.magnitudeSq = 0u;
+	MotionFeatures.magnitude = 0u;
+	MotionFeatures.jerk = 0u;
+	MotionFeatures.jerkPeak = 0u;
+	MotionFeatures.variance = 0u;
+	MotionFeatures.steps = 0u;
+	MotionFeatures.events = MOTION_EVENT_NONE;
+}
+
+/*******************************************************************************
+* Function Name: Motion_ProcessSample
+********************************************************************************
+* Summary:
+* 	Updates the motion features with one acceleration sample and classifies
+*   the motion.
+*
+* Parameters:
+*  const int16 axis[]: x, y and z acceleration in G2_MODE_RESOLUTION counts.
+*
+* Return:
+*  uint8: MOTION_EVENT_xxx bits detected with this sample.
+*
+*******************************************************************************/
+CY_RAMFUNC uint8 Motion_ProcessSample(const int16 axis[SAMPLE_VALUES])
+{
+	uint32 magnitudeSq = 0u;
+	uint32 variance = 0u;
+	int32 mean;
+	int16 oldest;
+	uint16 magnitude;
+	uint16 change;
+	uint16 jerk = 0u;
+	uint16 jerkPeak = 0u;
+	uint8 events = MOTION_EVENT_NONE;
+	uint8 index;
+	
+	for(index = 0u; index < SAMPLE_VALUES; index++)
+	{
+		magnitudeSq += (uint32)((int32)axis[index] * (int32)axis[index]);
+		change = Motion_Abs(axis[index], MotionPrevAxis[index]);
+		jerk += change;
+		if(change > jerkPeak)
+		{
+			jerkPeak = change;
+		}
+		MotionPrevAxis[index] = axis[index];
+		
+		/* Replace the oldest value in the window and update the sums. */
+		oldest = MotionWindow[index][MotionWindowIndex];
+		MotionWindow[index][MotionWindowIndex] = axis[index];
+		MotionWindowSum[index] += (int32)axis[index] - (int32)oldest;
+		MotionWindowSumSq[index] = (MotionWindowSumSq[index] - (uint32)((int32)oldest * (int32)oldest)) + 
+		                           (uint32)((int32)axis[index] * (int32)axis[index]);
+		
+		/* Variance = E[a^2] - E[a]^2, summed over the axes. */
+		mean = MotionWindowSum[index] / (int32)MOTION_WINDOW_SIZE;
+		variance += (MotionWindowSumSq[index] >> MOTION_WINDOW_SHIFT) - (uint32)(mean * mean);
+	}
+	MotionWindowIndex = (uint8)((MotionWindowIndex + 1u) & (MOTION_WINDOW_SIZE - 1u));
+	magnitude = Motion_Sqrt(magnitudeSq);
+	
+	/* Samples between peaks, saturated so that a long pause is not mistaken
+	 * for a step interval. */
+	if(MotionSincePeak < 0xFFu)
+	{
+		MotionSincePeak++;
+	}
+	
+	if(MotionSampleCount == 0u)
+	{
+		/* First sample after a reset: there is no previous sample to 
+		 * compare with. */
+		jerk = 0u;
+		jerkPeak = 0u;
+	}
+	else if(MotionSampleCount >= MOTION_WINDOW_SIZE)
+	{
+		MotionFeatures.variance = variance;
+		
+		/* The previous magnitude is a peak if it is above both neighbours
+		 * and above the threshold. */
+		if((MotionMagPrev1 > MOTION_PEAK_THRESHOLD) &&
+		   (MotionMagPrev1 > MotionMagPrev2) && (MotionMagPrev1 >= magnitude))
+		{
+			events |= MOTION_EVENT_PEAK;
+			
+			if((MotionSincePeak >= MOTION_STEP_MIN_INTERVAL) &&
+			   (MotionSincePeak <= MOTION_STEP_MAX_INTERVAL) &&
+			   (MotionFeatures.variance >= MOTION_STEP_VARIANCE) &&
+			   (MotionFeatures.variance < MOTION_SHAKE_VARIANCE))
+			{
+				events |= MOTION_EVENT_STEP;
+				MotionFeatures.steps++;
+			}
+			MotionSincePeak = 0u;
+		}
+		
+		if(MotionFeatures.variance >= MOTION_SHAKE_VARIANCE)
+		{
+			events |= MOTION_EVENT_SHAKE;
+		}
+	}
+	else
+	{
+		/* Window not yet full: only the jerk is meaningful. */
+	}
+	
+	if(jerkPeak > MOTION_JERK_THRESHOLD)
+	{
+		events |= MOTION_EVENT_JERK;
+	}
+	
+	if(MotionSampleCount < MOTION_WINDOW_SIZE)
+	{
+		MotionSampleCount++;
+	}
+	MotionMagPrev2 = MotionMagPrev1;
+	MotionMagPrev1 = magnitude;
+	
+	MotionFeatures.magnitudeSq = magnitudeSq;
+	MotionFeatures.magnitude = magnitude;
+	MotionFeatures.jerk = jerk;
+	MotionFeatures.jerkPeak = jerkPeak;
+	MotionFeatures.events = events;
+	
+	return(events);
+}
+
+/*******************************************************************************
+* Function Name: Motion_ProcessBatch
+********************************************************************************
+* Summary:
+* 	Processes a batch of acceleration samples in order.
+*
+* Parameters:
+*  const SAMPLE *batch: Samples to process.
+*  uint8 count: Number of samples in the batch.
+*
+* Return:
+*  uint8: MOTION_EVENT_xxx bits detected with any sample of the batch.
+*
+*******************************************************************************/
+CY_RAMFUNC uint8 Motion_ProcessBatch(const SAMPLE *batch, uint8 count)
+{
+	uint8 events = MOTION_EVENT_NONE;
+	uint8 index;
+	
+	for(index = 0u; index < count; index++)
+	{
+		events |= Motion_ProcessSample(batch[index].value);
+	}
+	
+	return(events);
+}
+
+/*******************************************************************************
+* Function Name: Motion_GetFeatures
+********************************************************************************
+* Summary:
+* 	Returns the features computed for the latest sample.
+*
+* Parameters:
+*  MOTION_FEATURES *features: Structure to which the features are copied.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Motion_GetFeatures(MOTION_FEATURES *features)
+{
+	*features = MotionFeatures;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/*****************************************************************************
+* File Name: motion.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  motion.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(MOTION_H)
+#define MOTION_H
+
+#include "cytypes.h"
+#include "samplebuf.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* All thresholds are in the units returned by ReadAccelerometer(), which are
+ * G2_MODE_RESOLUTION (1024) counts per g. */
+#define MOTION_ONE_G				1024u
+
+/* Number of samples in the variance window. Must be a power of two. */
+#define MOTION_WINDOW_SHIFT			3u
+#define MOTION_WINDOW_SIZE			(1u << MOTION_WINDOW_SHIFT)
+
+/* A jerk event is raised when the change of any single axis between two
+ * samples is above 0x10 counts (1/64 g). This is the sensitivity of the
+ * former per-axis alarm (ACC_THRESHOLD_VALUE) on x and y, now applied to
+ * z as well. */
+#define MOTION_JERK_THRESHOLD		0x10u
+
+/* A magnitude peak must be above 1.15 g. */
+#define MOTION_PEAK_THRESHOLD		(MOTION_ONE_G + 154u)
+
+/* Step peaks are between 8 and 40 samples apart, 0.24 s to 1.2 s at the
+ * 30 ms sampling period, with a standard deviation of the acceleration
+ * vector of at least 0.06 g. */
+#define MOTION_STEP_MIN_INTERVAL	8u
+#define MOTION_STEP_MAX_INTERVAL	40u
+#define MOTION_STEP_VARIANCE		(64u * 64u)
+
+/* A standard deviation above 0.25 g in the window is a shake. */
+#define MOTION_SHAKE_VARIANCE		(256u * 256u)
+
+/* Events returned by Motion_ProcessSample() and Motion_ProcessBatch(). */
+#define MOTION_EVENT_NONE			0x00u
+#define MOTION_EVENT_JERK			0x01u
+#define MOTION_EVENT_PEAK			0x02u
+#define MOTION_EVENT_STEP			0x04u
+#define MOTION_EVENT_SHAKE			0x08u
+
+/* Events that trigger the alarm. */
+#define MOTION_ALARM_EVENTS			(MOTION_EVENT_JERK | MOTION_EVENT_STEP | MOTION_EVENT_SHAKE)
+
+/*****************************************************************************
+* Data Structure Definition
+*****************************************************************************/
+/* Features computed for the latest sample. */
+typedef struct
+{
+	uint32 magnitudeSq;		/* x^2 + y^2 + z^2                          */
+	uint16 magnitude;		/* Integer square root of magnitudeSq       */
+	uint16 jerk;			/* |dx| + |dy| + |dz| against the last sample */
+	uint16 jerkPeak;		/* Largest of |dx|, |dy| and |dz|           */
+	uint32 variance;		/* Sum of the axis variances over the window */
+	uint16 steps;			/* Steps detected since Motion_Reset()      */
+	uint8 events;			/* MOTION_EVENT_xxx bits of the latest sample */
+} MOTION_FEATURES;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+void Motion_Reset(void);
+CY_RAMFUNC uint8 Motion_ProcessSample(const int16 axis[SAMPLE_VALUES]);
+CY_RAMFUNC uint8 Motion_ProcessBatch(const SAMPLE *batch, uint8 count);
+void Motion_GetFeatures(MOTION_FEATURES *features);
+CY_RAMFUNC uint16 Motion_Sqrt(uint32 value);
+
+#endif /* MOTION_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,276 @@
+/*****************************************************************************
+* File Name: orientation.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides a tilt and orientation estimator. The pitch and roll
+*  are computed from the gravity vector measured by the accelerometer with a
+*  lookup-table atan2, so no floating point or FPU is needed on the
+*  Cortex-M0. The face-up and face-down states use hysteresis and are used
+*  to tell when the toy is lying still.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "orientation.h"
+#include "motion.h"
+
+/*****************************************************************************
+* Local Global Variable Declarations
+*****************************************************************************/
+/* atan(k / ORIENT_ATAN_SEGMENTS) in tenths of a degree for k = 0 to 32,
+ * i.e. round(10 * 180 / pi * atan(k / 32.0)). Values between two entries
+ * are linearly interpolated, which keeps the error below 0.05 degree. */
+static const int16 OrientAtanTable[ORIENT_ATAN_SEGMENTS + 1u] =
+{
+	  0,  18,  36,  54,  71,  89, 106, 123, 140, 157, 174,
+	190, 206, 221, 236, 251, 266, 280, 294, 307, 320, 333,
+	345, 357, 369, 380, 391, 402, 412, 422, 432, 441, 450
+};
+
+/* Latest estimate. */
+static ORIENTATION Orientation;
+
+/* Consecutive samples in the current flat orientation. */
+static uint8 OrientFlatCount = 0u;
+
+
+/*******************************************************************************
+* Function Name: Orientation_AtanRatio
+********************************************************************************
+* Summary:
+* 	Returns atan(num / den) for 0 <= num <= den by interpolating the lookup
+*   table.
+*
+* Parameters:
+*  uint32 num: Numerator.
+*  uint32 den: Denominator, not zero.
+*
+* Return:
+*  int16: Angle between 0 and 45 degrees in tenths of a degree.
+*
+*******************************************************************************/
+static CY_RAMFUNC int16 Orientation_AtanRatio(uint32 num, uint32 den)
+{
+	/* Ratio in units of 1 / (ORIENT_ATAN_SEGMENTS << ORIENT_ATAN_SHIFT). */
+	uint32 ratio = (num << (ORIENT_ATAN_SHIFT + 5u)) / den;
+	uint32 index = ratio >> ORIENT_ATAN_SHIFT;
+	uint32 fraction = ratio & ((1u << ORIENT_ATAN_SHIFT) - 1u);
+	int16 angle = OrientAtanTable[index];
+	
+	if(index < ORIENT_ATAN_SEGMENTS)
+	{
+		angle += (int16)(((OrientAtanTable[index + 1u] - OrientAtanTable[index]) * (int32)fraction) >> ORIENT_ATAN_SHIFT);
+	}
+	
+	return(angle);
+}
+
+/*******************************************************************************
+* Function Name: Orientation_Atan2
+********************************************************************************
+* Summary:
+* 	Returns the angle of the vector (x, y). The ratio of the smaller to the
+*   larger component is looked up in the first octant and the result is 
+*   mapped back to the quadrant of the vector.
+*
+* Parameters:
+*  int32 y: y component, the magnitude must be below 2^18.
+*  int32 x: x component, the magnitude must be below 2^18.
+*
+* Return:
+*  int16: Angle between -180 and 180 degrees in tenths of a degree.
+*
+*******************************************************************************/
+CY_RAMFUNC int16 Orientation_Atan2(int32 y, int32 x)
+{
+	uint32 absX = (uint32)((x < 0) ? -x : x);
+	uint32 absY = (uint32)((y < 0) ? -y : y);
+	int16 angle;
+	
+	if((absX == 0u) && (absY == 0u))
+	{
+		angle = 0;
+	}
+	else if(absY <= absX)
+	{
+		angle = Orientation_AtanRatio(absY, absX);
+	}
+	else
+	{
+		angle = ORIENT_DEG_90 - Orientation_AtanRatio(absX, absY);
+	}
+	
+	if(x < 0)
+	{
+		angle = ORIENT_DEG_180 - angle;
+	}
+	if(y < 0)
+	{
+		angle = -angle;
+	}
+	
+	return(angle);
+}
+
+/*******************************************************************************
+* Function Name: Orientation_Reset
+********************************************************************************
+* Summary:
+* 	Clears the orientation estimate.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Orientation_Reset(void)
+{
+	Orientation.pitch = 0;
+	Orientation.roll = 0;
+	Orientation.state = ORIENT_UNKNOWN;
+	Orientation.resting = 0u;
+	OrientFlatCount = 0u;
+}
+
+/*******************************************************************************
+* Function Name: Orientation_Update
+********************************************************************************
+* Summary:
+* 	Updates the pitch, roll and orientation state with a new acceleration
+*   sample. The estimate is left unchanged when the magnitude of the 
+*   sample is not close to 1 g.
+*
+* Parameters:
+*  const int16 axis[]: x, y and z acceleration in G2_MODE_RESOLUTION counts.
+*
+* Return:
+*  uint8: Orientation state, one of ORIENT_xxx.
+*
+*******************************************************************************/
+CY_RAMFUNC uint8 Orientation_Update(const int16 axis[SAMPLE_VALUES])
+{
+	int32 x = axis[SAMPLE_X];
+	int32 y = axis[SAMPLE_Y];
+	int32 z = axis[SAMPLE_Z];
+	uint16 magnitude = Motion_Sqrt((uint32)((x * x) + (y * y) + (z * z)));
+	uint8 state = Orientation.state;
+	
+	if((magnitude > (ORIENT_ONE_G - ORIENT_GRAVITY_TOLERANCE)) &&
+	   (magnitude < (ORIENT_ONE_G + ORIENT_GRAVITY_TOLERANCE)))
+	{
+		Orientation.pitch = Orientation_Atan2(-x, (int32)Motion_Sqrt((uint32)((y * y) + (z * z))));
+		Orientation.roll = Orientation_Atan2(y, z);
+		
+		/* Normalize z to exactly 1 g so the thresholds do not depend on
+		 * the sensor gain. */
+		z = (z * (int32)ORIENT_ONE_G) / (int32)magnitude;
+		
+		if(z >= ORIENT_FLAT_ENTER)
+		{
+			state = ORIENT_FACE_UP;
+		}
+		else if(z <= -ORIENT_FLAT_ENTER)
+		{
+			state = ORIENT_FACE_DOWN;
+		}
+		else if(((state == ORIENT_FACE_UP) && (z > ORIENT_FLAT_EXIT)) ||
+		        ((state == ORIENT_FACE_DOWN) && (z < -ORIENT_FLAT_EXIT)))
+		{
+			/* Inside the hysteresis band: keep the flat state. */
+		}
+		else
+		{
+			state = ORIENT_TILTED;
+		}
+		
+		if((state != Orientation.state) || (state == ORIENT_TILTED))
+		{
+			OrientFlatCount = 0u;
+		}
+		else if(OrientFlatCount < ORIENT_REST_COUNT)
+		{
+			OrientFlatCount++;
+		}
+		else
+		{
+		}
+		
+		Orientation.state = state;
+	}
+	else
+	{
+		/* The toy is being accelerated, so it is not resting. */
+		OrientFlatCount = 0u;
+	}
+	
+	Orientation.resting = (OrientFlatCount >= ORIENT_REST_COUNT) ? 1u : 0u;
+	
+	return(Orientation.state);
+}
+
+/*******************************************************************************
+* Function Name: Orientation_Get
+********************************************************************************
+* Summary:
+* 	Returns the latest orientation estimate.
+*
+* Parameters:
+*  ORIENTATION *orientation: Structure to which the estimate is copied.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Orientation_Get(ORIENTATION *orientation)
+{
+	*orientation = Orientation;
+}
+
+/*******************************************************************************
+* Function Name: Orientation_IsResting
+********************************************************************************
+* Summary:
+* 	Returns whether the toy has been lying face up or face down for at least
+*   ORIENT_REST_COUNT samples.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8: Nonzero if resting, zero otherwise.
+*
+*******************************************************************************/
+uint8 Orientation_IsResting(void)
+{
+	return(Orientation.resting);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*****************************************************************************
+* File Name: orientation.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  orientation.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(ORIENTATION_H)
+#define ORIENTATION_H
+
+#include "cytypes.h"
+#include "samplebuf.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* Angles are returned in tenths of a degree. */
+#define ORIENT_DEG_90				900
+#define ORIENT_DEG_180				1800
+
+/* Number of segments of the atan lookup table over the ratio range 0 to 1. */
+#define ORIENT_ATAN_SEGMENTS		32u
+#define ORIENT_ATAN_SHIFT			8u
+
+/* The gravity vector is used only when its magnitude is within 0.15 g of
+ * 1 g, otherwise the toy is being accelerated and the angles are not valid.
+ * The values are in G2_MODE_RESOLUTION counts. */
+#define ORIENT_ONE_G				1024u
+#define ORIENT_GRAVITY_TOLERANCE	154u
+
+/* Face-up and face-down are entered when the tilt from vertical is below
+ * about 30 degrees (z above 0.87 g) and left when it is above about 40
+ * degrees (z below 0.77 g). */
+#define ORIENT_FLAT_ENTER			887
+#define ORIENT_FLAT_EXIT			788
+
+/* Number of consecutive samples in the same flat orientation after which
+ * the toy is considered to be resting. */
+#define ORIENT_REST_COUNT			10u
+
+/* Orientation states. */
+#define ORIENT_UNKNOWN				0x00u
+#define ORIENT_FACE_UP				0x01u
+#define ORIENT_FACE_DOWN			0x02u
+#define ORIENT_TILTED				0x03u
+
+/*****************************************************************************
+* Data Structure Definition
+*****************************************************************************/
+typedef struct
+{
+	int16 pitch;			/* Rotation around y, tenths of a degree  */
+	int16 roll;				/* Rotation around x, tenths of a degree  */
+	uint8 state;			/* ORIENT_xxx                             */
+	uint8 resting;			/* Nonzero while resting face up or down  */
+} ORIENTATION;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+void Orientation_Reset(void);
+CY_RAMFUNC int16 Orientation_Atan2(int32 y, int32 x);
+CY_RAMFUNC uint8 Orientation_Update(const int16 axis[SAMPLE_VALUES]);
+void Orientation_Get(ORIENTATION *orientation);
+uint8 Orientation_IsResting(void);
+
+#endif /* ORIENTATION_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,196 @@
+/*****************************************************************************
+* File Name: power.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides a power manager on top of cyPm. The Components that
+*  have to be prepared for Deep-Sleep register callbacks, which are called
+*  in priority order on entry and in reverse order on exit. The manager
+*  selects Sleep or Deep-Sleep from the time to the next software timer and
+*  the save and restore latency of the clients, and any client can keep the
+*  device out of Deep-Sleep.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "power.h"
+#include "swtimer.h"
+#include "project.h"
+
+/*****************************************************************************
+* Local Global Variable Declarations
+*****************************************************************************/
+/* Registered clients, sorted by priority. */
+static const POWER_CLIENT *PowerClient[POWER_MAX_CLIENTS];
+static uint8 PowerClientCount = 0u;
+
+/* Deep-Sleep wake-up time plus the latency of all the clients. */
+static uint32 PowerLatencyUs = POWER_DEEPSLEEP_WAKEUP_US;
+
+
+/*******************************************************************************
+* Function Name: Power_RegisterClient
+********************************************************************************
+* Summary:
+* 	Adds a Component to the clients of the power manager. Clients with equal
+*   priority are called in the order of registration.
+*
+* Parameters:
+*  const POWER_CLIENT *client: Client to add. Must stay allocated.
+*
+* Return:
+*  uint8: POWER_REGISTERED, or POWER_TABLE_FULL if there is no free entry.
+*
+*******************************************************************************/
+uint8 Power_RegisterClient(const POWER_CLIENT *client)
+{
+	uint8 status = POWER_TABLE_FULL;
+	uint8 index;
+	
+	if(PowerClientCount < POWER_MAX_CLIENTS)
+	{
+		index = PowerClientCount;
+		while((index > 0u) && (PowerClient[index - 1u]->priority > client->priority))
+		{
+			PowerClient[index] = PowerClient[index - 1u];
+			index--;
+		}
+		PowerClient[index] = client;
+		PowerClientCount++;
+		
+		PowerLatencyUs += client->latencyUs;
+		status = POWER_REGISTERED;
+	}
+	
+	return(status);
+}
+
+/*******************************************************************************
+* Function Name: Power_SelectMode
+********************************************************************************
+* Summary:
+* 	Selects the low power mode for the time until the next software timer.
+*   Must be called with the interrupts disabled.
+*
+* Parameters:
+*  uint8 maxMode: Deepest mode allowed by the caller.
+*
+* Return:
+*  uint8: POWER_MODE_SLEEP or POWER_MODE_DEEPSLEEP.
+*
+*******************************************************************************/
+static uint8 Power_SelectMode(uint8 maxMode)
+{
+	uint8 mode = POWER_MODE_SLEEP;
+	uint64 idleUs;
+	uint8 index;
+	
+	if(maxMode == POWER_MODE_DEEPSLEEP)
+	{
+		idleUs = CySysTimebaseTicksToUs((uint64)SwTimer_GetIdleTime() << SWTIMER_TICK_SHIFT);
+		if(idleUs >= ((uint64)PowerLatencyUs + POWER_DEEPSLEEP_MIN_US))
+		{
+			mode = POWER_MODE_DEEPSLEEP;
+			for(index = 0u; (index < PowerClientCount) && (mode == POWER_MODE_DEEPSLEEP); index++)
+			{
+				if((PowerClient[index]->prepare != (void *)0) && 
+				   (PowerClient[index]->prepare() != POWER_OK))
+				{
+					mode = POWER_MODE_SLEEP;
+				}
+			}
+		}
+	}
+	
+	return(mode);
+}
+
+/*******************************************************************************
+* Function Name: Power_Idle
+********************************************************************************
+* Summary:
+* 	Puts the device in Sleep or Deep-Sleep until the next interrupt. For
+*   Deep-Sleep, the enter callbacks of the clients are called in priority
+*   order before and the exit callbacks in reverse order after. 
+*
+* Parameters:
+*  uint8 maxMode: Deepest mode allowed by the caller.
+*  const volatile uint8 *wakeFlag: Flag set by an interrupt when the caller
+*                                  has work to do, or NULL. The device does 
+*                                  not sleep if the flag is already set.
+*
+* Return:
+*  uint8: The mode that was entered, 0 if the device did not sleep.
+*
+*******************************************************************************/
+uint8 Power_Idle(uint8 maxMode, const volatile uint8 *wakeFlag)
+{
+	uint8 mode = 0u;
+	uint8 interruptState;
+	uint8 index;
+	
+	/* The WFI wakes up on an interrupt that becomes pending while the 
+	 * interrupts are disabled, so a flag set after the check is not missed.
+	 * The interrupt is serviced once they are enabled again. */
+	interruptState = CyEnterCriticalSection();
+	
+	if((wakeFlag == (void *)0) || (*wakeFlag == 0u))
+	{
+		mode = Power_SelectMode(maxMode);
+		if(mode == POWER_MODE_DEEPSLEEP)
+		{
+			for(index = 0u; index < PowerClientCount; index++)
+			{
+				if(PowerClient[index]->enter != (void *)0)
+				{
+					PowerClient[index]->enter();
+				}
+			}
+			
+			CySysPmDeepSleep();
+			
+			for(index = PowerClientCount; index > 0u; index--)
+			{
+				if(PowerClient[index - 1u]->exit != (void *)0)
+				{
+					PowerClient[index - 1u]->exit();
+				}
+			}
+		}
+		else
+		{
+			CySysPmSleep();
+		}
+	}
+	
+	CyExitCriticalSection(interruptState);
+	
+	return(mode);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/*****************************************************************************
+* File Name: power.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  power.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(POWER_H)
+#define POWER_H
+
+#include "cytypes.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* Low power modes. */
+#define POWER_MODE_SLEEP			0x01u
+#define POWER_MODE_DEEPSLEEP		0x02u
+
+/* Return values of the prepare callback. */
+#define POWER_OK					0x00u
+#define POWER_VETO					0x01u
+
+/* Return values of Power_RegisterClient(). */
+#define POWER_REGISTERED			0x00u
+#define POWER_TABLE_FULL			0x01u
+
+#define POWER_MAX_CLIENTS			8u
+
+/* Time taken by the device to wake up from Deep-Sleep, in microseconds. */
+#define POWER_DEEPSLEEP_WAKEUP_US	25u
+
+/* Deep-Sleep is entered only if the device stays in it for at least this
+ * long after the save and restore latency of the clients. Shorter idle 
+ * gaps are spent in Sleep, where nothing has to be saved or restored. */
+#define POWER_DEEPSLEEP_MIN_US		1000u
+
+/*****************************************************************************
+* Data Structure Definition
+*****************************************************************************/
+/* A Component that has to be prepared for Deep-Sleep. The callbacks run 
+ * with the interrupts disabled. Any of them may be NULL. */
+typedef struct
+{
+	uint8 (*prepare)(void);		/* POWER_VETO keeps the device in Sleep     */
+	void (*enter)(void);		/* Saves the state before Deep-Sleep        */
+	void (*exit)(void);			/* Restores the state after Deep-Sleep      */
+	uint32 latencyUs;			/* Time taken by enter and exit together    */
+	uint8 priority;				/* Lower values enter first and exit last   */
+} POWER_CLIENT;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+uint8 Power_RegisterClient(const POWER_CLIENT *client);
+uint8 Power_Idle(uint8 maxMode, const volatile uint8 *wakeFlag);
+
+#endif /* POWER_H */
+
+/* [] END OF FILE */
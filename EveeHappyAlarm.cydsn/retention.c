@@ -0,0 +1,156 @@
+/*****************************************************************************
+* File Name: retention.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides incremental Deep-Sleep retention for the CapSense and
+*  I2C Components, used in place of their Sleep() and Wakeup() APIs by the
+*  power manager. All the configuration registers of the PSoC 4 keep their
+*  values in Deep-Sleep, so nothing has to be saved. Only the blocks that
+*  would draw current or misbehave in Deep-Sleep are turned off, and only 
+*  the bits that were actually set are turned back on.
+*
+*  CapSense_Wakeup() calls CapSense_Enable(), which stops both CapSense 
+*  clock dividers, writes their divider values and starts them again, each
+*  step waiting for the divider command to complete. The dividers do not 
+*  run in Deep-Sleep as the HFCLK is off, and their settings are retained,
+*  so this is skipped here. The CapSense interrupt is left enabled, as the
+*  power manager does not enter Deep-Sleep during a scan.
+*
+*  I2C_Sleep() and I2C_Wakeup() also disable and enable the SCB interrupt 
+*  sources and reset the interrupt-driven master state. The accelerometer 
+*  uses the manual master API, so only the SCB enable bit is cleared.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "retention.h"
+#include "project.h"
+
+/*****************************************************************************
+* Local Global Variable Declarations
+*****************************************************************************/
+/* CSD block bits that were set on entry to Deep-Sleep. */
+static uint32 CapSenseRetention_csdBits = 0u;
+
+/* Set if the SCB was enabled on entry to Deep-Sleep. */
+static uint8 I2CRetention_enabled = 0u;
+
+
+/*******************************************************************************
+* Function Name: CapSenseRetention_Sleep
+********************************************************************************
+* Summary:
+* 	Turns off the CSD sensing and comparator before Deep-Sleep and remembers
+*   which of them were on.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void CapSenseRetention_Sleep(void)
+{
+	CapSenseRetention_csdBits = CapSense_CSD_CFG_REG & 
+		(CapSense_CSD_CFG_ENABLE | CapSense_CSD_CFG_SENSE_COMP_EN | CapSense_CSD_CFG_SENSE_EN);
+	
+	if(CapSenseRetention_csdBits != 0u)
+	{
+		CapSense_CSD_CFG_REG &= ~CapSenseRetention_csdBits;
+	}
+}
+
+/*******************************************************************************
+* Function Name: CapSenseRetention_Wakeup
+********************************************************************************
+* Summary:
+* 	Turns the CSD bits cleared by CapSenseRetention_Sleep() back on.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void CapSenseRetention_Wakeup(void)
+{
+	if(CapSenseRetention_csdBits != 0u)
+	{
+		CapSense_CSD_CFG_REG |= CapSenseRetention_csdBits;
+	}
+}
+
+/*******************************************************************************
+* Function Name: I2CRetention_Sleep
+********************************************************************************
+* Summary:
+* 	Disables the SCB before Deep-Sleep if it is enabled. Must be called only
+*   when no transfer is in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void I2CRetention_Sleep(void)
+{
+	I2CRetention_enabled = ((I2C_CTRL_REG & I2C_CTRL_ENABLED) != 0u) ? 1u : 0u;
+	
+	if(I2CRetention_enabled != 0u)
+	{
+		I2C_CTRL_REG &= (uint32) ~I2C_CTRL_ENABLED;
+	}
+}
+
+/*******************************************************************************
+* Function Name: I2CRetention_Wakeup
+********************************************************************************
+* Summary:
+* 	Enables the SCB again if I2CRetention_Sleep() disabled it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void I2CRetention_Wakeup(void)
+{
+	if(I2CRetention_enabled != 0u)
+	{
+		I2C_CTRL_REG |= I2C_CTRL_ENABLED;
+	}
+}
+
+/* [] END OF FILE */
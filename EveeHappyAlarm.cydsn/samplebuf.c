@@ -0,0 +1,168 @@
+/*****************************************************************************
+* File Name: samplebuf.c
+*
+* Version 1.0
+*
+* Description:
+*  This file provides lock-free single-producer/single-consumer rings of
+*  timestamped samples. The sensor interrupts produce samples and the main
+*  loop consumes them in batches after waking up, so a slow main-loop
+*  iteration no longer loses data. The Cortex-M0 has no exclusive access
+*  instructions, so the rings rely only on single-byte index stores, which
+*  are atomic, and on a memory barrier between the data and the index update.
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include "samplebuf.h"
+#include "project.h"
+
+/*****************************************************************************
+* Global Variable Declarations
+*****************************************************************************/
+SAMPLE_RING SampleBuf_accelRing;
+SAMPLE_RING SampleBuf_proxRing;
+
+
+/*******************************************************************************
+* Function Name: SampleRing_Push
+********************************************************************************
+* Summary:
+* 	Adds a sample to the ring. Must be called only from the producer context
+*   of the ring.
+*
+* Parameters:
+*  SAMPLE_RING *ring: Ring to which the sample is added.
+*  const SAMPLE *sample: Sample to add.
+*
+* Return:
+*  uint8: 1 if the sample was added, 0 if the ring was full.
+*
+*******************************************************************************/
+uint8 SampleRing_Push(SAMPLE_RING *ring, const SAMPLE *sample)
+{
+	uint8 head = ring->head;
+	uint8 result = 0u;
+	
+	if((uint8)(head - ring->tail) >= SAMPLEBUF_SIZE)
+	{
+		ring->dropped++;
+	}
+	else
+	{
+		ring->entry[head & SAMPLEBUF_MASK] = *sample;
+		
+		/* The sample must be in memory before the consumer can see it. */
+		__DMB();
+		ring->head = (uint8)(head + 1u);
+		result = 1u;
+	}
+	
+	return(result);
+}
+
+/*******************************************************************************
+* Function Name: SampleRing_PopBatch
+********************************************************************************
+* Summary:
+* 	Removes up to maxCount samples from the ring, oldest first. Must be called
+*   only from the consumer context of the ring.
+*
+* Parameters:
+*  SAMPLE_RING *ring: Ring from which the samples are removed.
+*  SAMPLE *batch: Buffer to which the samples are copied.
+*  uint8 maxCount: Size of the buffer in samples.
+*
+* Return:
+*  uint8: Number of samples copied.
+*
+*******************************************************************************/
+uint8 SampleRing_PopBatch(SAMPLE_RING *ring, SAMPLE *batch, uint8 maxCount)
+{
+	uint8 tail = ring->tail;
+	uint8 count = (uint8)(ring->head - tail);
+	uint8 index;
+	
+	if(count > maxCount)
+	{
+		count = maxCount;
+	}
+	
+	/* The index must be read before the samples it publishes. */
+	__DMB();
+	
+	for(index = 0u; index < count; index++)
+	{
+		batch[index] = ring->entry[(uint8)(tail + index) & SAMPLEBUF_MASK];
+	}
+	
+	/* The samples must be copied before the producer may reuse the slots. */
+	__DMB();
+	ring->tail = (uint8)(tail + count);
+	
+	return(count);
+}
+
+/*******************************************************************************
+* Function Name: SampleRing_Count
+********************************************************************************
+* Summary:
+* 	Returns the number of samples waiting in the ring.
+*
+* Parameters:
+*  const SAMPLE_RING *ring: Ring to check.
+*
+* Return:
+*  uint8: Number of samples.
+*
+*******************************************************************************/
+uint8 SampleRing_Count(const SAMPLE_RING *ring)
+{
+	return((uint8)(ring->head - ring->tail));
+}
+
+/*******************************************************************************
+* Function Name: SampleBuf_GetTimestamp
+********************************************************************************
+* Summary:
+* 	Returns the current time in LFCLK ticks, taken from the low 32 bits of
+*   the WDT timebase. The timestamps wrap after about 36 hours, which is
+*   far longer than a sample stays in a ring.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32: Time in LFCLK ticks.
+*
+*******************************************************************************/
+uint32 SampleBuf_GetTimestamp(void)
+{
+	return((uint32)CySysTimebaseGetTicks());
+}
+
+/* [] END OF FILE */
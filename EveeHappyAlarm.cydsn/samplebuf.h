@@ -0,0 +1,103 @@
+/*****************************************************************************
+* File Name: samplebuf.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  samplebuf.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(SAMPLEBUF_H)
+#define SAMPLEBUF_H
+
+#include "cytypes.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* Number of entries in each ring. Must be a power of two not larger than 128
+ * so that the free-running 8-bit indices wrap correctly. */
+#define SAMPLEBUF_SIZE				16u
+#define SAMPLEBUF_MASK				(SAMPLEBUF_SIZE - 1u)
+
+/* Sample sources. */
+#define SAMPLE_SRC_ACCEL			0x01u
+#define SAMPLE_SRC_PROX				0x02u
+
+/* Value indexes of a sample. */
+#define SAMPLE_X					0u
+#define SAMPLE_Y					1u
+#define SAMPLE_Z					2u
+#define SAMPLE_PROX_RAW				0u
+#define SAMPLE_VALUES				3u
+
+/*****************************************************************************
+* Data Structure Definition
+*****************************************************************************/
+/* One timestamped sample. The timestamp is in LFCLK ticks. */
+typedef struct
+{
+	uint32 timestamp;
+	int16 value[SAMPLE_VALUES];
+	uint8 source;
+} SAMPLE;
+
+/* Single-producer/single-consumer ring. head is written only by the producer
+ * and tail only by the consumer, so no critical section is needed. Both are
+ * free running and masked on access. */
+typedef struct
+{
+	SAMPLE entry[SAMPLEBUF_SIZE];
+	volatile uint8 head;
+	volatile uint8 tail;
+	volatile uint16 dropped;	/* Samples lost because the ring was full */
+} SAMPLE_RING;
+
+/*****************************************************************************
+* Global Variable Declaration
+*****************************************************************************/
+/* Filled from the I2C interrupt every sample period. */
+extern SAMPLE_RING SampleBuf_accelRing;
+
+/* Filled from the CapSense interrupt at the end of each scan. */
+extern SAMPLE_RING SampleBuf_proxRing;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+uint8 SampleRing_Push(SAMPLE_RING *ring, const SAMPLE *sample);
+uint8 SampleRing_PopBatch(SAMPLE_RING *ring, SAMPLE *batch, uint8 maxCount);
+uint8 SampleRing_Count(const SAMPLE_RING *ring);
+
+uint32 SampleBuf_GetTimestamp(void);
+
+#endif /* SAMPLEBUF_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,105 @@
+/*****************************************************************************
+* File Name: swtimer.h
+* Version 1.0
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  swtimer.c
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(SWTIMER_H)
+#define SWTIMER_H
+
+#include "cytypes.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+/* One wheel tick is 2^SWTIMER_TICK_SHIFT LFCLK ticks, about 1 ms. */
+#define SWTIMER_TICK_SHIFT			5u
+
+/* The wheel has SWTIMER_LEVELS levels of SWTIMER_SLOTS slots. Level n holds
+ * the timers that expire within 16^(n + 1) wheel ticks, so timeouts up to
+ * about 65 s are placed directly. Longer timeouts are re-inserted when they
+ * reach the end of the wheel. */
+#define SWTIMER_LEVELS				4u
+#define SWTIMER_SLOT_BITS			4u
+#define SWTIMER_SLOTS				(1u << SWTIMER_SLOT_BITS)
+#define SWTIMER_SLOT_MASK			(SWTIMER_SLOTS - 1u)
+#define SWTIMER_MAX_DELTA			((1uL << (SWTIMER_LEVELS * SWTIMER_SLOT_BITS)) - 1u)
+
+/* Limits of the WDT counter 0 match distance in LFCLK ticks. The match is
+ * never set closer than a few LFCLK cycles, as it takes that long to take
+ * effect, and never further than the 16-bit counter can reach. */
+#define SWTIMER_MIN_SLEEP_TICKS		4u
+#define SWTIMER_MAX_SLEEP_TICKS		0xFF00u
+
+/* Shortest delay in microseconds that is slept instead of busy-waited. */
+#define SWTIMER_MIN_DELAY_US		1000u
+
+/*****************************************************************************
+* Data Structure Definition
+*****************************************************************************/
+struct SWTIMER_s;
+
+/* Called from the WDT interrupt when the timer expires. */
+typedef void (*SWTIMER_CALLBACK)(struct SWTIMER_s *timer);
+
+/* A software timer. The structure is owned by the caller and linked into
+ * the wheel while the timer runs, so it must stay allocated until it is
+ * stopped. */
+typedef struct SWTIMER_s
+{
+	struct SWTIMER_s *next;
+	struct SWTIMER_s *prev;
+	uint32 expires;				/* Expiry time in wheel ticks             */
+	uint32 period;				/* Period in wheel ticks, 0 for one-shot  */
+	SWTIMER_CALLBACK callback;
+	uint8 level;				/* Wheel position while active            */
+	uint8 slot;
+	uint8 active;
+} SWTIMER;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+void SwTimer_Init(void);
+void SwTimer_Start(SWTIMER *timer, uint32 timeoutMs, uint32 periodMs, SWTIMER_CALLBACK callback);
+void SwTimer_Stop(SWTIMER *timer);
+uint8 SwTimer_IsActive(const SWTIMER *timer);
+uint32 SwTimer_GetTime(void);
+uint32 SwTimer_GetIdleTime(void);
+void SwTimer_Delay(uint32 milliseconds);
+void SwTimer_DelayDeepSleep(uint32 milliseconds);
+void SwTimer_DelayUs(uint32 microseconds);
+
+#endif /* SWTIMER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/*****************************************************************************
+* File Name: I2C_I2C.h
+* Version 1.0
+*
+* Description:
+*  Host build stand-in for the I2C Component master API. Provides the
+*  constants and prototypes used by accelerometer.c. The functions are
+*  implemented by acc_emulator.c, which the host build compiles with
+*  ACC_EMULATOR_ENABLED set to 1.
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#if !defined(CY_SCB_I2C_I2C_H)
+#define CY_SCB_I2C_I2C_H
+
+#include "cytypes.h"
+
+#define I2C_I2C_WRITE_XFER_MODE    (0u)    /* Write    */
+#define I2C_I2C_READ_XFER_MODE     (1u)    /* Read     */
+
+#define I2C_I2C_ACK_DATA           (0u)    /* Send ACK to data */
+#define I2C_I2C_NAK_DATA           (1u)    /* Send NAK to data */
+
+#define I2C_I2C_MSTR_NO_ERROR          (0x00u)  /* Function complete without error                       */
+#define I2C_I2C_MSTR_ERR_LB_NAK        (0x02u)  /* Last Byte Naked: INTR_MASTER_I2C_NACK                 */
+#define I2C_I2C_MSTR_NOT_READY         (0x04u)  /* Master on the bus or Slave operation is in progress   */
+
+#define I2C_I2C_MODE_COMPLETE_XFER     (0x00u)    /* Full transfer with Start and Stop       */
+#define I2C_I2C_MODE_REPEAT_START      (0x01u)    /* Begin with a ReStart instead of a Start */
+#define I2C_I2C_MODE_NO_STOP           (0x02u)    /* Complete the transfer without a Stop    */
+
+#define I2C_I2C_MSTAT_RD_CMPLT         ((uint16) 0x01u)   /* Read complete               */
+#define I2C_I2C_MSTAT_WR_CMPLT         ((uint16) 0x02u)   /* Write complete              */
+#define I2C_I2C_MSTAT_XFER_INP         ((uint16) 0x04u)   /* Master transfer in progress */
+#define I2C_I2C_MSTAT_ERR_XFER         ((uint16) 0x200u) /* Error during transfer                        */
+
+uint32 I2C_I2CMasterSendStart(uint32 slaveAddress, uint32 bitRnW);
+uint32 I2C_I2CMasterSendRestart(uint32 slaveAddress, uint32 bitRnW);
+uint32 I2C_I2CMasterSendStop(void);
+uint32 I2C_I2CMasterWriteByte(uint32 theByte);
+uint32 I2C_I2CMasterReadByte(uint32 ackNack);
+uint32 I2C_I2CMasterStatus(void);
+uint32 I2C_I2CMasterClearStatus(void);
+uint32 I2C_I2CMasterWriteBuf(uint32 slaveAddress, uint8 * wrData, uint32 cnt, uint32 mode);
+uint32 I2C_I2CMasterReadBuf(uint32 slaveAddress, uint8 * rdData, uint32 cnt, uint32 mode);
+
+#endif /* CY_SCB_I2C_I2C_H */
+
+/* [] END OF FILE */
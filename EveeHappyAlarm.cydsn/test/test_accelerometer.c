@@ -0,0 +1,392 @@
+/*****************************************************************************
+* File Name: test_accelerometer.c
+* Version 1.0
+*
+* Description:
+*  Host test of the accelerometer driver against the register-level
+*  emulator. Checks the register values left by the bring-up and by every
+*  data profile, the scaling of the samples, and the number of bus
+*  transactions and bytes that each operation costs.
+*
+******************************************************************************
+* Copyright (2015), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+#include <stdio.h>
+#include "accelerometer.h"
+#include "acc_emulator.h"
+#include "swtimer.h"
+
+/*****************************************************************************
+* MACRO Definition
+*****************************************************************************/
+#define TEST_CHECK(cond)		Test_Check((cond), #cond, __LINE__)
+
+/* Expected bus activity of one operation. */
+typedef struct
+{
+	uint32 transactions;
+	uint32 restarts;
+	uint32 bytesWritten;
+	uint32 bytesRead;
+	uint32 nacks;
+} TEST_BUS_COUNT;
+
+/*****************************************************************************
+* Global Variable Declarations
+*****************************************************************************/
+uint8 acclerometer_configured = FALSE;
+
+static uint32 Test_failures = 0u;
+static uint32 Test_rateChanges = 0u;
+
+
+/*******************************************************************************
+* Host stand-ins for the modules that are not part of the test.
+*******************************************************************************/
+void SwTimer_Delay(uint32 milliseconds)
+{
+	AccEmu_AdvanceTime(milliseconds * 1000u);
+}
+
+uint8 I2CBus_SetDataRate(uint32 rateKbps, uint32 slaveAddress)
+{
+	(void)rateKbps;
+	(void)slaveAddress;
+	
+	Test_rateChanges++;
+	return(I2CBUS_RATE_OK);
+}
+
+/*******************************************************************************
+* Function Name: Test_Check
+********************************************************************************
+* Summary:
+* 	Reports a failed check.
+*
+* Parameters:
+*  int pass: Result of the check.
+*  const char *text: Checked expression.
+*  int line: Line of the check.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Test_Check(int pass, const char *text, int line)
+{
+	if(pass == 0)
+	{
+		printf("test_accelerometer.c:%d: check failed: %s\n", line, text);
+		Test_failures++;
+	}
+}
+
+/*******************************************************************************
+* Function Name: Test_CheckBus
+********************************************************************************
+* Summary:
+* 	Compares the bus activity since the last AccEmu_ClearStats() with the
+*   expected one, then clears the statistics. Every transfer addresses the
+*   accelerometer once per START and once per repeated START. No write may
+*   be ignored by the write protection of the operating mode.
+*
+* Parameters:
+*  const char *what: Operation checked.
+*  const TEST_BUS_COUNT *expected: Expected bus activity.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Test_CheckBus(const char *what, const TEST_BUS_COUNT *expected)
+{
+	ACC_EMU_STATS stats;
+	
+	AccEmu_GetStats(&stats);
+	printf("%-28s %3lu transactions, %3lu restarts, %3lu bytes written, %3lu bytes read\n", what,
+		   (unsigned long)stats.transactions, (unsigned long)stats.restarts,
+		   (unsigned long)stats.bytesWritten, (unsigned long)stats.bytesRead);
+	
+	TEST_CHECK(stats.transactions == expected->transactions);
+	TEST_CHECK(stats.restarts == expected->restarts);
+	TEST_CHECK(stats.addressBytes == (expected->transactions + expected->restarts));
+	TEST_CHECK(stats.bytesWritten == expected->bytesWritten);
+	TEST_CHECK(stats.bytesRead == expected->bytesRead);
+	TEST_CHECK(stats.nacks == expected->nacks);
+	TEST_CHECK(stats.protectedWrites == 0u);
+	
+	AccEmu_ClearStats();
+}
+
+/*******************************************************************************
+* Function Name: Test_BringUp
+********************************************************************************
+* Summary:
+* 	Runs the readiness poll and InitializeAccelerometer() on a sensor fresh
+*   out of reset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Test_BringUp(void)
+{
+	/* Two single-register reads. */
+	static const TEST_BUS_COUNT waitReady = { 2u, 2u, 2u, 2u, 0u };
+	/* Self-test: 5 reads and 2 writes. Bus rate selection: 2 reads. Register
+	 * table: 6 burst writes of 8 values. Interrupt release: 1 read. */
+	static const TEST_BUS_COUNT bringUp = { 16u, 8u, 26u, 8u, 0u };
+	
+	AccEmu_Reset();
+	AccEmu_ClearStats();
+	
+	TEST_CHECK(Accelerometer_WaitReady() == ACC_PASS);
+	Test_CheckBus("Accelerometer_WaitReady", &waitReady);
+	
+	InitializeAccelerometer();
+	Test_CheckBus("InitializeAccelerometer", &bringUp);
+	
+	TEST_CHECK(acclerometer_configured == TRUE);
+	TEST_CHECK(Test_rateChanges == 1u);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_CTRL_REG_1) == 
+			   (ACC_PC1_BIT_OR_MASK | ACC_RES_BIT_OR_MASK | ACC_WUFE_BIT_OR_MASK));
+	TEST_CHECK(AccEmu_PeekRegister(ACC_CTRL_REG_2) == ACC_OWUFA_BIT_OR_MASK);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_INT_CTRL_REG_1) == (ACC_IEN_BIT_OR_MASK | ACC_IEA_BIT_OR_MASK));
+	TEST_CHECK(AccEmu_PeekRegister(ACC_INT_CTRL_REG_2) == 0x3Fu);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_DATA_CTRL_REG) == ACC_ODR_50HZ);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_WAKEUP_TIMER) == ACC_WAKEUP_TIMER_VALUE);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_WAKUP_THRESHOLD) == ACC_WAKUP_THRESHOLD_VAL);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_DCST_RESP) == ACC_SELF_TEST_VAL_1);
+}
+
+/*******************************************************************************
+* Function Name: Test_Profile
+********************************************************************************
+* Summary:
+* 	Applies a profile, then reads one sample of a still sensor lying flat.
+*   Whatever the profile, the sample is scaled to G2_MODE_RESOLUTION counts
+*   per g, within the resolution of the profile. The sample read driven by
+*   the I2C interrupt must give the same bus activity and values.
+*
+* Parameters:
+*  const char *name: Name of the profile.
+*  const ACC_PROFILE *profile: Profile to apply.
+*  const TEST_BUS_COUNT *setCount: Expected bus activity of the change.
+*  const TEST_BUS_COUNT *readCount: Expected bus activity of one sample.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Test_Profile(const char *name, const ACC_PROFILE *profile, 
+						 const TEST_BUS_COUNT *setCount, const TEST_BUS_COUNT *readCount)
+{
+	static const ACC_EMU_WAVEFORM flat = { { 0, 500, 1000 }, { 0, 0, 0 }, 0u, ACC_EMU_SHAPE_STILL };
+	char what[32];
+	int16 x = 0x7FFF;
+	int16 y = 0x7FFF;
+	int16 z = 0x7FFF;
+	int16 isrX = 0x7FFF;
+	int16 isrY = 0x7FFF;
+	int16 isrZ = 0x7FFF;
+	uint8 ctrl1;
+	int16 tolerance;
+	
+	AccEmu_SetWaveform(&flat);
+	AccEmu_ClearStats();
+	
+	TEST_CHECK(Accelerometer_SetProfile(profile) == COMM_PASS);
+	snprintf(what, sizeof(what), "SetProfile(%s)", name);
+	Test_CheckBus(what, setCount);
+	
+	ctrl1 = AccEmu_PeekRegister(ACC_CTRL_REG_1);
+	TEST_CHECK((ctrl1 & ACC_PC1_BIT_OR_MASK) != 0u);
+	TEST_CHECK((ctrl1 & ACC_WUFE_BIT_OR_MASK) != 0u);
+	TEST_CHECK(((ctrl1 & ACC_RES_BIT_OR_MASK) != 0u) == (profile->resolution == ACC_RES_12BIT));
+	TEST_CHECK(((ctrl1 >> ACC_GSEL_SHIFT) & 0x03u) == profile->range);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_DATA_CTRL_REG) == profile->odr);
+	TEST_CHECK(Accelerometer_GetProfile()->resolution == profile->resolution);
+	TEST_CHECK(Accelerometer_GetProfile()->range == profile->range);
+	
+	/* Let one output period pass so that a sample is latched. */
+	AccEmu_AdvanceTime(100000u);
+	AccEmu_ClearStats();
+	
+	ReadAccelerometer(&x, &y, &z);
+	snprintf(what, sizeof(what), "ReadAccelerometer(%s)", name);
+	Test_CheckBus(what, readCount);
+	
+	/* One count of the profile, in G2_MODE_RESOLUTION counts. */
+	tolerance = (int16)((profile->resolution == ACC_RES_12BIT) ? 1 : 16) << profile->range;
+	TEST_CHECK(x == 0);
+	TEST_CHECK((y >= ((G2_MODE_RESOLUTION / 2) - tolerance)) && (y <= (G2_MODE_RESOLUTION / 2)));
+	TEST_CHECK((z >= (G2_MODE_RESOLUTION - tolerance)) && (z <= G2_MODE_RESOLUTION));
+	
+	/* One interrupt after the address write, one after the data read. A
+	 * second start is refused while the first read runs. */
+	TEST_CHECK(Accelerometer_StartSample() == ACC_PASS);
+	TEST_CHECK(Accelerometer_StartSample() == ACC_FAIL);
+	TEST_CHECK(Accelerometer_ServiceSample(&isrX, &isrY, &isrZ) == ACC_SAMPLE_BUSY);
+	TEST_CHECK(isrX == 0x7FFF);
+	TEST_CHECK(Accelerometer_ServiceSample(&isrX, &isrY, &isrZ) == ACC_SAMPLE_READY);
+	TEST_CHECK(Accelerometer_ServiceSample(&isrX, &isrY, &isrZ) == ACC_SAMPLE_IDLE);
+	snprintf(what, sizeof(what), "StartSample(%s)", name);
+	Test_CheckBus(what, readCount);
+	
+	TEST_CHECK(isrX == x);
+	TEST_CHECK(isrY == y);
+	TEST_CHECK(isrZ == z);
+}
+
+/*******************************************************************************
+* Function Name: Test_SampleFailure
+********************************************************************************
+* Summary:
+* 	NACKs the address write of a sample read driven by the I2C interrupt.
+*   The read must fail without changing the values, and release the bus so
+*   that the next sample read succeeds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Test_SampleFailure(void)
+{
+	/* The NACKed address write, then a 12-bit sample read. */
+	static const TEST_BUS_COUNT retried = { 2u, 1u, 1u, 6u, 1u };
+	int16 x = 0x7FFF;
+	int16 y = 0x7FFF;
+	int16 z = 0x7FFF;
+	
+	AccEmu_ClearStats();
+	AccEmu_SetNackAt(1u, 1u);
+	TEST_CHECK(Accelerometer_StartSample() == ACC_PASS);
+	TEST_CHECK(Accelerometer_ServiceSample(&x, &y, &z) == ACC_SAMPLE_FAILED);
+	TEST_CHECK((x == 0x7FFF) && (y == 0x7FFF) && (z == 0x7FFF));
+	AccEmu_SetNackAt(0u, 0u);
+	
+	TEST_CHECK(Accelerometer_StartSample() == ACC_PASS);
+	TEST_CHECK(Accelerometer_ServiceSample(&x, &y, &z) == ACC_SAMPLE_BUSY);
+	TEST_CHECK(Accelerometer_ServiceSample(&x, &y, &z) == ACC_SAMPLE_READY);
+	Test_CheckBus("StartSample(retried)", &retried);
+	TEST_CHECK(z > 0);
+}
+
+/*******************************************************************************
+* Function Name: Test_ProfileFailure
+********************************************************************************
+* Summary:
+* 	Fails the DATA_CTRL write of a profile change. The previous profile must
+*   be written back and stay in use. When the write back fails as well, the
+*   accelerometer must be reported as no longer configured.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Test_ProfileFailure(void)
+{
+	/* CTRL_REG1 read, two CTRL_REG1 writes, the NACKed DATA_CTRL write, then
+	 * CTRL_REG1, DATA_CTRL and CTRL_REG1 written back. */
+	static const TEST_BUS_COUNT restored = { 7u, 1u, 11u, 1u, 1u };
+	/* The final CTRL_REG1 write and the first write back are NACKed. */
+	static const TEST_BUS_COUNT lost = { 6u, 1u, 7u, 1u, 2u };
+	const ACC_PROFILE *previous = Accelerometer_GetProfile();
+	uint8 prevCtrl = AccEmu_PeekRegister(ACC_CTRL_REG_1);
+	uint8 prevOdr = AccEmu_PeekRegister(ACC_DATA_CTRL_REG);
+	uint8 prevResolution = previous->resolution;
+	uint8 prevRange = previous->range;
+	
+	AccEmu_ClearStats();
+	AccEmu_SetNackAt(4u, 1u);
+	TEST_CHECK(Accelerometer_SetProfile(&Accelerometer_fastProfile) == COMM_FAIL);
+	Test_CheckBus("SetProfile(restored)", &restored);
+	
+	TEST_CHECK(AccEmu_PeekRegister(ACC_CTRL_REG_1) == prevCtrl);
+	TEST_CHECK(AccEmu_PeekRegister(ACC_DATA_CTRL_REG) == prevOdr);
+	TEST_CHECK(Accelerometer_GetProfile()->resolution == prevResolution);
+	TEST_CHECK(Accelerometer_GetProfile()->range == prevRange);
+	TEST_CHECK(acclerometer_configured == TRUE);
+	
+	AccEmu_ClearStats();
+	AccEmu_SetNackAt(5u, 2u);
+	TEST_CHECK(Accelerometer_SetProfile(&Accelerometer_precisionProfile) == COMM_FAIL);
+	Test_CheckBus("SetProfile(lost)", &lost);
+	AccEmu_SetNackAt(0u, 0u);
+	
+	TEST_CHECK((AccEmu_PeekRegister(ACC_CTRL_REG_1) & ACC_PC1_BIT_OR_MASK) == 0u);
+	TEST_CHECK(acclerometer_configured == FALSE);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* 	Runs the tests.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int: 0 if all checks passed, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+	static const ACC_PROFILE g8Profile = { ACC_RES_12BIT, G8_MODE, ACC_ODR_100HZ };
+	/* CTRL_REG1 read, then CTRL_REG1 twice, DATA_CTRL and CTRL_REG1 again,
+	 * written one register each. */
+	static const TEST_BUS_COUNT setProfile = { 5u, 1u, 9u, 1u, 0u };
+	/* One burst read from XOUT_L, or from XOUT_H in 8-bit mode. */
+	static const TEST_BUS_COUNT read12Bit = { 1u, 1u, 1u, 6u, 0u };
+	static const TEST_BUS_COUNT read8Bit = { 1u, 1u, 1u, 5u, 0u };
+	
+	Test_BringUp();
+	Test_Profile("fast", &Accelerometer_fastProfile, &setProfile, &read8Bit);
+	Test_Profile("precision", &Accelerometer_precisionProfile, &setProfile, &read12Bit);
+	Test_Profile("12-bit 8g", &g8Profile, &setProfile, &read12Bit);
+	Test_SampleFailure();
+	Test_ProfileFailure();
+	
+	if(Test_failures != 0u)
+	{
+		printf("%lu check(s) failed\n", (unsigned long)Test_failures);
+	}
+	return((Test_failures == 0u) ? 0 : 1);
+}
+
+/* [] END OF FILE */